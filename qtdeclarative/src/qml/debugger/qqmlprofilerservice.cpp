@@ -76,6 +76,14 @@ QByteArray QQmlProfilerData::toByteArray() const
     if (messageType == (int)QQmlProfilerService::Event &&
             detailType == (int)QQmlProfilerService::AnimationFrame)
         ds << framerate << animationcount;
+    // BindingsCoalesced: evaluated bindings, saved evaluations
+    if (messageType == (int)QQmlProfilerService::Event &&
+            detailType == (int)QQmlProfilerService::BindingsCoalesced)
+        ds << line << column;
+    // PropertyLookups: QObject property lookup cache hits, misses
+    if (messageType == (int)QQmlProfilerService::Event &&
+            detailType == (int)QQmlProfilerService::PropertyLookups)
+        ds << line << column;
     if (messageType == (int)QQmlProfilerService::PixmapCacheEvent) {
         ds << detailData;
         switch (detailType) {
@@ -165,6 +173,18 @@ void QQmlProfilerService::animationFrame(qint64 delta)
     profilerInstance()->animationFrameImpl(delta);
 }
 
+void QQmlProfilerService::bindingsCoalesced(int evaluated, int saved)
+{
+    if (QQmlDebugService::isDebuggingEnabled())
+        profilerInstance()->bindingsCoalescedImpl(evaluated, saved);
+}
+
+void QQmlProfilerService::propertyLookups(int hits, int misses)
+{
+    if (QQmlDebugService::isDebuggingEnabled())
+        profilerInstance()->propertyLookupsImpl(hits, misses);
+}
+
 void QQmlProfilerService::sceneGraphFrame(SceneGraphFrameType frameType, qint64 value1, qint64 value2, qint64 value3, qint64 value4, qint64 value5)
 {
     profilerInstance()->sceneGraphFrameImpl(frameType, value1, value2, value3, value4, value5);
@@ -343,6 +363,28 @@ void QQmlProfilerService::animationFrameImpl(qint64 delta)
     }
 }
 
+void QQmlProfilerService::bindingsCoalescedImpl(int evaluated, int saved)
+{
+    if (!enabled)
+        return;
+
+    QQmlProfilerData ed = {m_timer.nsecsElapsed(), (int)Event, (int)BindingsCoalesced,
+                           QString(), evaluated, saved, -1, -1, 0,
+                           0, 0, 0, 0, 0};
+    processMessage(ed);
+}
+
+void QQmlProfilerService::propertyLookupsImpl(int hits, int misses)
+{
+    if (!enabled)
+        return;
+
+    QQmlProfilerData ed = {m_timer.nsecsElapsed(), (int)Event, (int)PropertyLookups,
+                           QString(), hits, misses, -1, -1, 0,
+                           0, 0, 0, 0, 0};
+    processMessage(ed);
+}
+
 /*
     Either send the message directly, or queue up
     a list of messages to send later (via sendMessages)
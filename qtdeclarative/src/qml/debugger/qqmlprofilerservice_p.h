@@ -118,6 +118,8 @@ public:
         AnimationFrame,
         EndTrace,
         StartTrace,
+        BindingsCoalesced,
+        PropertyLookups,
 
         MaximumEventType
     };
@@ -175,6 +177,8 @@ public:
 
     static void addEvent(EventType);
     static void animationFrame(qint64);
+    static void bindingsCoalesced(int evaluated, int saved);
+    static void propertyLookups(int hits, int misses);
 
     static void sceneGraphFrame(SceneGraphFrameType frameType, qint64 value1, qint64 value2 = -1, qint64 value3 = -1, qint64 value4 = -1, qint64 value5 = -1);
     static void sendProfilingData();
@@ -192,6 +196,8 @@ private:
     void sendStartedProfilingMessageImpl();
     void addEventImpl(EventType);
     void animationFrameImpl(qint64);
+    void bindingsCoalescedImpl(int evaluated, int saved);
+    void propertyLookupsImpl(int hits, int misses);
 
     void startRange(RangeType, BindingType bindingType = QmlBinding);
     void rangeData(RangeType, const QString &);
@@ -16,6 +16,7 @@ HEADERS +=  \
     $$PWD/qqmltrace_p.h \
     $$PWD/qpointervaluepair_p.h \
     $$PWD/qlazilyallocated_p.h \
+    $$PWD/qperfectstringhash_p.h \
 
 SOURCES += \
     $$PWD/qintrusivelist.cpp \
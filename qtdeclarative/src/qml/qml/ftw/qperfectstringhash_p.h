@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QPERFECTSTRINGHASH_P_H
+#define QPERFECTSTRINGHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qhashedstring_p.h>
+
+#include <QtCore/qvector.h>
+#include <QtCore/qset.h>
+#include <QtCore/qbitarray.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/qatomic.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+// A read-only minimal perfect hash over the keys of a QStringHash.  Each key
+// maps to exactly one slot, so a lookup costs one hash, one probe and one
+// comparison.  For QStringMultiHash only the first match of each key, the one
+// QStringHash::find() returns, is recorded; the returned iterators can be used
+// with QStringMultiHash::findNext() as usual.
+//
+// The table refers to the nodes of the hash it was built from and must be
+// cleared or rebuilt whenever that hash is modified.
+template<class T>
+class QPerfectStringHash
+{
+public:
+    typedef typename QStringHash<T>::ConstIterator ConstIterator;
+
+    bool build(const QStringHash<T> &);
+    inline void clear();
+
+    inline bool isEmpty() const { return m_entries.isEmpty(); }
+    inline int count() const { return m_entries.count(); }
+
+    template<typename K>
+    inline ConstIterator find(const K &) const;
+
+private:
+    enum { ShortKeyLength = 8, MaximumSeed = 0xffff };
+
+    struct Entry {
+        Entry() : hash(0), length(0), symbolId(0) {}
+
+        quint32 hash;
+        qint32 length;
+        mutable QAtomicInt symbolId; // Remembered from lookups, which may run on several threads
+        uint16_t shortKey[ShortKeyLength];
+        ConstIterator iterator;
+    };
+
+    struct BucketSizeGreaterThan {
+        BucketSizeGreaterThan(const QVector<QVector<int> > &buckets) : buckets(buckets) {}
+        bool operator()(int l, int r) const { return buckets.at(l).count() > buckets.at(r).count(); }
+        const QVector<QVector<int> > &buckets;
+    };
+
+    static inline quint32 slotHash(quint32 hash, quint32 seed);
+
+    inline bool equals(const Entry &, const QHashedV8String &) const;
+    template<typename K>
+    inline bool equals(const Entry &, const K &) const;
+
+    QVector<Entry> m_entries;
+    QVector<quint32> m_seeds;
+};
+
+template<class T>
+quint32 QPerfectStringHash<T>::slotHash(quint32 hash, quint32 seed)
+{
+    hash ^= seed * 0x9e3779b9U;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bU;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35U;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/*
+    Builds the table using "hash and displace": keys are grouped into buckets
+    by their string hash and, largest bucket first, each bucket gets the
+    smallest seed that moves all of its keys to free slots.  Returns false,
+    leaving the table empty, if \a hash is empty or no placement was found,
+    e.g. because two distinct keys have the same string hash.
+*/
+template<class T>
+bool QPerfectStringHash<T>::build(const QStringHash<T> &hash)
+{
+    clear();
+
+    QVector<ConstIterator> keys;
+    QSet<const QStringHashNode *> seen;
+    for (ConstIterator iter = hash.begin(); iter != hash.end(); ++iter) {
+        // Keys a linked hash cannot find itself are skipped, as find() would
+        ConstIterator first = hash.find(iter.key());
+        if (first.node() && !seen.contains(first.node())) {
+            seen.insert(first.node());
+            keys.append(first);
+        }
+    }
+
+    const int slotCount = keys.count();
+    if (!slotCount)
+        return false;
+
+    const int bucketCount = qMax(1, slotCount / 2);
+    QVector<QVector<int> > buckets(bucketCount);
+    for (int ii = 0; ii < slotCount; ++ii)
+        buckets[keys.at(ii).node()->hash % bucketCount].append(ii);
+
+    QVector<int> order(bucketCount);
+    for (int ii = 0; ii < bucketCount; ++ii)
+        order[ii] = ii;
+    qSort(order.begin(), order.end(), BucketSizeGreaterThan(buckets));
+
+    QVector<quint32> seeds(bucketCount, 0);
+    QVector<int> placement(slotCount, -1);
+    QBitArray used(slotCount);
+    QVarLengthArray<int, 16> slots;
+
+    for (int ii = 0; ii < bucketCount; ++ii) {
+        const QVector<int> &bucket = buckets.at(order.at(ii));
+        if (bucket.isEmpty())
+            break;
+
+        quint32 seed = 0;
+        for (;; ++seed) {
+            if (seed > MaximumSeed)
+                return false;
+
+            slots.clear();
+            bool placed = true;
+            for (int jj = 0; placed && jj < bucket.count(); ++jj) {
+                const int slot = slotHash(keys.at(bucket.at(jj)).node()->hash, seed) % slotCount;
+                if (used.testBit(slot))
+                    placed = false;
+                for (int kk = 0; placed && kk < slots.count(); ++kk)
+                    placed = slots.at(kk) != slot;
+                slots.append(slot);
+            }
+            if (placed)
+                break;
+        }
+
+        seeds[order.at(ii)] = seed;
+        for (int jj = 0; jj < bucket.count(); ++jj) {
+            used.setBit(slots.at(jj));
+            placement[slots.at(jj)] = bucket.at(jj);
+        }
+    }
+
+    m_entries.resize(slotCount);
+    for (int ii = 0; ii < slotCount; ++ii) {
+        const ConstIterator &iter = keys.at(placement.at(ii));
+        const QStringHashNode *node = iter.node();
+
+        Entry &entry = m_entries[ii];
+        entry.hash = node->hash;
+        entry.length = node->length;
+        entry.symbolId.store(node->symbolId);
+        entry.iterator = iter;
+        if (node->length <= ShortKeyLength) {
+            if (node->isQString()) {
+                ::memcpy(entry.shortKey, node->utf16Data(), node->length * sizeof(uint16_t));
+            } else {
+                const char *ckey = node->cStrData();
+                for (int jj = 0; jj < node->length; ++jj)
+                    entry.shortKey[jj] = uchar(ckey[jj]);
+            }
+        }
+    }
+    m_seeds = seeds;
+    return true;
+}
+
+template<class T>
+void QPerfectStringHash<T>::clear()
+{
+    m_entries.clear();
+    m_seeds.clear();
+}
+
+template<class T>
+template<typename K>
+typename QPerfectStringHash<T>::ConstIterator QPerfectStringHash<T>::find(const K &key) const
+{
+    Q_ASSERT(!isEmpty());
+
+    typename HashedForm<K>::Type hashedKey(QStringHashBase::hashedString(key));
+    const quint32 hash = hashedKey.hash();
+    const quint32 seed = m_seeds.constData()[hash % m_seeds.count()];
+    const Entry &entry = m_entries.constData()[slotHash(hash, seed) % m_entries.count()];
+
+    if (entry.hash == hash && entry.length == hashedKey.length() && equals(entry, hashedKey))
+        return entry.iterator;
+    return ConstIterator();
+}
+
+// Comparing against a V8 string through the node would create a new V8 string
+// for the node's key, so short keys are compared against an inline copy and
+// matching symbols are remembered.
+template<class T>
+bool QPerfectStringHash<T>::equals(const Entry &entry, const QHashedV8String &key) const
+{
+    if (key.symbolId() && key.symbolId() == quint32(entry.symbolId.load()))
+        return true;
+
+    bool equal;
+    if (entry.length <= ShortKeyLength) {
+        uint16_t buffer[ShortKeyLength];
+        key.string()->Write(buffer, 0, entry.length);
+        equal = ::memcmp(buffer, entry.shortKey, entry.length * sizeof(uint16_t)) == 0;
+    } else {
+        equal = entry.iterator.equals(key);
+    }
+
+    if (equal && key.symbolId())
+        entry.symbolId.store(key.symbolId());
+    return equal;
+}
+
+template<class T>
+template<typename K>
+bool QPerfectStringHash<T>::equals(const Entry &entry, const K &key) const
+{
+    return entry.iterator.equals(key);
+}
+
+QT_END_NAMESPACE
+
+#endif // QPERFECTSTRINGHASH_P_H
@@ -40,6 +40,7 @@
 ****************************************************************************/
 
 #include "qqmlpool_p.h"
+#include <QtCore/qmutex.h>
 #include <stdlib.h>
 
 #ifdef Q_OS_QNX
@@ -50,13 +51,56 @@
 
 QT_BEGIN_NAMESPACE
 
+// Pages released by cleared pools are kept here so that the next parse and
+// compile, which typically needs the same number of pages, does not go back
+// to the system allocator.
+struct QQmlPoolPageCache
+{
+    enum { MaximumPages = 32 };
+
+    QQmlPoolPageCache() : pages(0), count(0) {}
+    ~QQmlPoolPageCache()
+    {
+        while (pages) {
+            QQmlPool::Page *n = pages->header.next;
+            free(pages);
+            pages = n;
+        }
+    }
+
+    QMutex mutex;
+    QQmlPool::Page *pages;
+    int count;
+};
+
+Q_GLOBAL_STATIC(QQmlPoolPageCache, poolPageCache)
+
+static QAtomicInt poolPageAllocations;
+static QAtomicInt poolPageReuses;
+
 void QQmlPool::newpage()
 {
 #ifdef POOL_DEBUG
     qWarning("QQmlPool: Allocating page");
 #endif
 
-    Page *page = (Page *)malloc(sizeof(Page));
+    Page *page = 0;
+    if (QQmlPoolPageCache *cache = poolPageCache()) {
+        QMutexLocker lock(&cache->mutex);
+        if (cache->pages) {
+            page = cache->pages;
+            cache->pages = page->header.next;
+            --cache->count;
+        }
+    }
+
+    if (page) {
+        poolPageReuses.ref();
+    } else {
+        page = (Page *)malloc(sizeof(Page));
+        poolPageAllocations.ref();
+    }
+
     page->header.next = _page;
     page->header.free = page->memory;
     _page = page;
@@ -83,6 +127,19 @@ void QQmlPool::clear()
 #endif
 
     Page *p = _page;
+    if (p) {
+        if (QQmlPoolPageCache *cache = poolPageCache()) {
+            QMutexLocker lock(&cache->mutex);
+            while (p && cache->count < QQmlPoolPageCache::MaximumPages) {
+                Page *n = p->header.next;
+                p->header.next = cache->pages;
+                cache->pages = p;
+                ++cache->count;
+                p = n;
+            }
+        }
+    }
+
     while (p) {
         Page *n = p->header.next;
         free(p);
@@ -93,5 +150,23 @@ void QQmlPool::clear()
     _page = 0;
 }
 
+/*!
+    Returns the number of pages pools have obtained from the system allocator
+    and from the cache of released pages since the last resetStatistics().
+*/
+QQmlPool::Statistics QQmlPool::statistics()
+{
+    Statistics rv;
+    rv.pageAllocations = poolPageAllocations.load();
+    rv.pageReuses = poolPageReuses.load();
+    return rv;
+}
+
+void QQmlPool::resetStatistics()
+{
+    poolPageAllocations.store(0);
+    poolPageReuses.store(0);
+}
+
 
 QT_END_NAMESPACE
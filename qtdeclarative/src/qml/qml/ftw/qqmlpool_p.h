@@ -142,7 +142,16 @@ public:
     template<typename T>
     inline List<T> NewRawList(int length);
 
+    struct Statistics {
+        int pageAllocations; // Pages obtained from the system allocator
+        int pageReuses;      // Pages recycled from a previously cleared pool
+    };
+    static Statistics statistics();
+    static void resetStatistics();
+
 private:
+    friend struct QQmlPoolPageCache;
+
     struct StringClass : public QString, public Class {
     };
     struct ByteArrayClass : public QByteArray, public Class {
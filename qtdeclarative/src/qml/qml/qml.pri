@@ -34,11 +34,13 @@ SOURCES += \
     $$PWD/qqmlintegercache.cpp \
     $$PWD/qqmltypenotavailable.cpp \
     $$PWD/qqmltypenamecache.cpp \
+    $$PWD/qqmlstringtable.cpp \
     $$PWD/qqmlscriptstring.cpp \
     $$PWD/qqmlnetworkaccessmanagerfactory.cpp \
     $$PWD/qqmldirparser.cpp \
     $$PWD/qqmlextensionplugin.cpp \
     $$PWD/qqmlimport.cpp \
+    $$PWD/qqmlimportindex.cpp \
     $$PWD/qqmllist.cpp \
     $$PWD/qqmllocale.cpp \
     $$PWD/qqmlabstractexpression.cpp \
@@ -48,6 +50,7 @@ SOURCES += \
     $$PWD/qqmlglobal.cpp \
     $$PWD/qqmlfile.cpp \
     $$PWD/qqmlbundle.cpp \
+    $$PWD/qqmldiskcache.cpp \
     $$PWD/qqmlmemoryprofiler.cpp \
     $$PWD/qqmlplatform.cpp \
     $$PWD/qqmlbinding.cpp \
@@ -103,12 +106,14 @@ HEADERS += \
     $$PWD/qqmlintegercache_p.h \
     $$PWD/qqmltypenotavailable_p.h \
     $$PWD/qqmltypenamecache_p.h \
+    $$PWD/qqmlstringtable_p.h \
     $$PWD/qqmlscriptstring.h \
     $$PWD/qqmlguard_p.h \
     $$PWD/qqmlnetworkaccessmanagerfactory.h \
     $$PWD/qqmldirparser_p.h \
     $$PWD/qqmlextensioninterface.h \
     $$PWD/qqmlimport_p.h \
+    $$PWD/qqmlimportindex_p.h \
     $$PWD/qqmlextensionplugin.h \
     $$PWD/qqmlnullablevalue_p_p.h \
     $$PWD/qqmlscriptstring_p.h \
@@ -120,6 +125,7 @@ HEADERS += \
     $$PWD/qqmlvaluetypeproxybinding_p.h \
     $$PWD/qqmlfile.h \
     $$PWD/qqmlbundle_p.h \
+    $$PWD/qqmldiskcache_p.h \
     $$PWD/qqmlmemoryprofiler_p.h \
     $$PWD/qqmlplatform_p.h \
     $$PWD/qqmlbinding_p.h \
@@ -104,4 +104,42 @@ void QQmlAccessorProperties::registerProperties(const QMetaObject *mo, int count
     This->properties.insert(mo, properties);
 }
 
+QQmlAccessorProperties::Property *
+QQmlAccessorProperties::findProperty(const QQmlAccessors *accessors, intptr_t data,
+                                     const QMetaObject **mo)
+{
+    AccessorProperties *This = accessorProperties();
+
+    QReadLocker lock(&This->lock);
+    QHash<const QMetaObject *, Properties>::ConstIterator iter = This->properties.constBegin();
+    for (; iter != This->properties.constEnd(); ++iter) {
+        for (int ii = 0; ii < iter->count; ++ii) {
+            Property *property = iter->properties + ii;
+            if (property->accessors == accessors && property->data == data) {
+                *mo = iter.key();
+                return property;
+            }
+        }
+    }
+
+    return 0;
+}
+
+QQmlAccessorProperties::Property *
+QQmlAccessorProperties::findProperty(const QByteArray &className, const QByteArray &name)
+{
+    AccessorProperties *This = accessorProperties();
+
+    QReadLocker lock(&This->lock);
+    QHash<const QMetaObject *, Properties>::ConstIterator iter = This->properties.constBegin();
+    for (; iter != This->properties.constEnd(); ++iter) {
+        if (className == iter.key()->className()) {
+            Properties properties = *iter;
+            return properties.property(name.constData());
+        }
+    }
+
+    return 0;
+}
+
 QT_END_NAMESPACE
@@ -134,6 +134,10 @@ namespace QQmlAccessorProperties {
 
     Properties properties(const QMetaObject *);
     void Q_QML_PRIVATE_EXPORT registerProperties(const QMetaObject *, int, Property *);
+
+    // Reverse lookups used to persist references to accessor properties
+    Property *findProperty(const QQmlAccessors *, intptr_t data, const QMetaObject **);
+    Property *findProperty(const QByteArray &className, const QByteArray &name);
 };
 
 QQmlAccessorProperties::Property *
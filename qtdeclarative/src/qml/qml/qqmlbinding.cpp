@@ -342,6 +342,8 @@ QString QQmlBinding::expressionIdentifier(QQmlJavaScriptExpression *e)
 void QQmlBinding::expressionChanged(QQmlJavaScriptExpression *e)
 {
     QQmlBinding *This = static_cast<QQmlBinding *>(e);
+    if (QQmlData::deferBindingUpdate(This->object(), This))
+        return;
     This->update();
 }
 
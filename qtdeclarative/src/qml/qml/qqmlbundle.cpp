@@ -42,9 +42,36 @@
 #include "qqmlbundle_p.h"
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 
 static const unsigned char qmlBundleHeaderData[] = { 255, 'q', 'm', 'l', 'd', 'i', 'r', 255 };
 static const unsigned int qmlBundleHeaderLength = 8;
+static const quint32 qmlBundleIndexMagic = 0x78646971; // "qidx"
+
+// The order of the index.  File names are compared by length first, which is cheaper
+// than a lexical comparison and just as good for a binary search.
+static int compareFileNames(const char *lhs, int lhsLength, const char *rhs, int rhsLength)
+{
+    if (lhsLength != rhsLength)
+        return lhsLength < rhsLength ? -1 : 1;
+    return ::memcmp(lhs, rhs, lhsLength);
+}
+
+namespace {
+struct FileEntryLessThan
+{
+    FileEntryLessThan(const uchar *buffer) : buffer(buffer) {}
+
+    bool operator()(quint32 lhsOffset, quint32 rhsOffset) const
+    {
+        const QQmlBundle::FileEntry *lhs = reinterpret_cast<const QQmlBundle::FileEntry *>(buffer + lhsOffset);
+        const QQmlBundle::FileEntry *rhs = reinterpret_cast<const QQmlBundle::FileEntry *>(buffer + rhsOffset);
+        return compareFileNames(lhs->data, lhs->fileNameLength, rhs->data, rhs->fileNameLength) < 0;
+    }
+
+    const uchar *buffer;
+};
+}
 
 //
 // Entries
@@ -78,7 +105,10 @@ QQmlBundle::QQmlBundle(const QString &fileName)
   buffer(0),
   bufferSize(0),
   opened(false),
-  headerWritten(false)
+  headerWritten(false),
+  indexBuilt(false),
+  sortedIndex(0),
+  sortedIndexCount(0)
 {
 }
 
@@ -114,6 +144,10 @@ void QQmlBundle::close()
     if (opened) {
         opened = false;
         headerWritten = false;
+        indexBuilt = false;
+        sortedIndex = 0;
+        sortedIndexCount = 0;
+        builtIndex.clear();
         file.unmap(buffer);
         file.close();
     }
@@ -135,6 +169,7 @@ QList<const QQmlBundle::FileEntry *> QQmlBundle::files() const
         }   break;
 
         case Entry::Link:
+        case Entry::Index:
         case Entry::Skip: {
             // Skip
         }   break;
@@ -154,6 +189,7 @@ void QQmlBundle::remove(const FileEntry *entry)
 {
     Q_ASSERT(entry->kind == Entry::File); // ### throw an error
     Q_ASSERT(file.isWritable());
+    // The index still refers to the entry, but find() skips removed entries
     const_cast<FileEntry *>(entry)->kind = Entry::Skip;
 }
 
@@ -195,24 +231,7 @@ const QQmlBundle::Entry *QQmlBundle::findInsertPoint(quint32 size, qint32 *offse
 
 const QQmlBundle::FileEntry *QQmlBundle::find(const QString &fileName) const
 {
-    const char *ptr = (const char *) buffer + qmlBundleHeaderLength;
-    const char *end = (const char *) buffer + bufferSize;
-
-    while (ptr < end) {
-        const Entry *cmd = (const Entry *) ptr;
-
-        if (cmd->kind == Entry::File) {
-            const FileEntry *fileEntry = static_cast<const FileEntry *>(cmd);
-
-            if (fileEntry->isFileName(fileName))
-                return fileEntry;
-        }
-
-        ptr += cmd->size;
-        Q_ASSERT(ptr <= end); // throw an error
-    }
-
-    return 0;
+    return find(fileName.constData(), fileName.length());
 }
 
 const QQmlBundle::FileEntry *QQmlBundle::link(const FileEntry *entry, const QString &linkName) const
@@ -233,9 +252,94 @@ const QQmlBundle::FileEntry *QQmlBundle::link(const FileEntry *entry, const QStr
     return 0;
 }
 
+/*
+Returns the index stored at the end of the bundle, or 0 if there is none or it
+does not cover all entries.  Entries added after the index was written are
+not covered.
+*/
+const QQmlBundle::IndexEntry *QQmlBundle::storedIndex() const
+{
+    const quint32 minimumSize = sizeof(IndexEntry) + sizeof(IndexTrailer);
+    if (bufferSize < qmlBundleHeaderLength + minimumSize)
+        return 0;
+
+    const IndexTrailer *trailer =
+        reinterpret_cast<const IndexTrailer *>(buffer + bufferSize - sizeof(IndexTrailer));
+    if (trailer->magic != qmlBundleIndexMagic ||
+        trailer->indexOffset < qmlBundleHeaderLength ||
+        trailer->indexOffset > bufferSize - minimumSize)
+        return 0;
+
+    const IndexEntry *index = reinterpret_cast<const IndexEntry *>(buffer + trailer->indexOffset);
+    if (index->kind != Entry::Index ||
+        trailer->indexOffset + index->size != bufferSize ||
+        index->size != quint64(minimumSize) + quint64(index->count) * sizeof(quint32))
+        return 0;
+
+    return index;
+}
+
+void QQmlBundle::buildIndex() const
+{
+    indexBuilt = true;
+
+    // Use the stored index if possible, so that entries are only touched when they
+    // are looked up
+    if (const IndexEntry *index = storedIndex()) {
+        sortedIndex = index->offsets;
+        sortedIndexCount = index->count;
+        builtIndex.clear();
+        return;
+    }
+
+    builtIndex.clear();
+    const char *ptr = (const char *) buffer + qmlBundleHeaderLength;
+    const char *end = (const char *) buffer + bufferSize;
+
+    while (ptr < end) {
+        const Entry *cmd = (const Entry *) ptr;
+
+        if (cmd->kind == Entry::File)
+            builtIndex.append(ptr - (const char *) buffer);
+
+        ptr += cmd->size;
+        Q_ASSERT(ptr <= end); // throw an error
+    }
+
+    std::sort(builtIndex.begin(), builtIndex.end(), FileEntryLessThan(buffer));
+    sortedIndex = builtIndex.constData();
+    sortedIndexCount = builtIndex.count();
+}
+
 const QQmlBundle::FileEntry *QQmlBundle::find(const QChar *fileName, int length) const
 {
-    return find(QString::fromRawData(fileName, length));
+    if (!indexBuilt)
+        buildIndex();
+
+    const char *name = reinterpret_cast<const char *>(fileName);
+    const int nameLength = length * sizeof(QChar);
+
+    quint32 low = 0;
+    quint32 high = sortedIndexCount;
+    while (low < high) {
+        const quint32 middle = low + (high - low) / 2;
+        const quint32 offset = sortedIndex[middle];
+        if (offset < qmlBundleHeaderLength || offset + sizeof(FileEntry) > bufferSize)
+            return 0; // corrupt index
+
+        const FileEntry *fileEntry = reinterpret_cast<const FileEntry *>(buffer + offset);
+        const int cmp = compareFileNames(fileEntry->data, fileEntry->fileNameLength,
+                                         name, nameLength);
+        if (cmp < 0) {
+            low = middle + 1;
+        } else if (cmp > 0) {
+            high = middle;
+        } else {
+            return fileEntry->kind == Entry::File ? fileEntry : 0;
+        }
+    }
+
+    return 0;
 }
 
 bool QQmlBundle::add(const QString &name, const QString &fileName)
@@ -316,3 +420,53 @@ bool QQmlBundle::addMetaLink(const QString &fileName,
     file.write((const char *) data.constData(), inputFileSize);
     return true;
 }
+
+/*
+Appends an index of all file entries to the bundle, which is used by find() for
+as long as no other entries are added after it.
+*/
+bool QQmlBundle::writeIndex()
+{
+    if (!file.isWritable())
+        return false;
+
+    QVector<quint32> offsets;
+    const char *ptr = (const char *) buffer + qmlBundleHeaderLength;
+    const char *end = (const char *) buffer + bufferSize;
+
+    while (bufferSize && ptr < end) {
+        Entry *cmd = (Entry *) ptr;
+
+        if (cmd->kind == Entry::File)
+            offsets.append(ptr - (const char *) buffer);
+        else if (cmd->kind == Entry::Index)
+            cmd->kind = Entry::Skip; // superseded
+
+        ptr += cmd->size;
+        Q_ASSERT(ptr <= end); // throw an error
+    }
+
+    std::sort(offsets.begin(), offsets.end(), FileEntryLessThan(buffer));
+
+    if (!file.atEnd())
+        file.seek(file.size());
+
+    if (bufferSize == 0 && headerWritten == false) {
+        file.write((const char *)qmlBundleHeaderData, qmlBundleHeaderLength);
+        headerWritten = true;
+    }
+
+    IndexEntry cmd;
+    cmd.kind = Entry::Index;
+    cmd.size = sizeof(IndexEntry) + offsets.count() * sizeof(quint32) + sizeof(IndexTrailer);
+    cmd.count = offsets.count();
+
+    IndexTrailer trailer;
+    trailer.indexOffset = file.size();
+    trailer.magic = qmlBundleIndexMagic;
+
+    file.write((const char *) &cmd, sizeof(IndexEntry));
+    file.write((const char *) offsets.constData(), offsets.count() * sizeof(quint32));
+    file.write((const char *) &trailer, sizeof(IndexTrailer));
+    return true;
+}
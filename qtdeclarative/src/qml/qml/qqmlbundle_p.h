@@ -44,6 +44,7 @@
 
 #include <QtCore/qfile.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
 #include <private/qtqmlglobal_p.h>
 
 #ifdef Q_CC_MSVC
@@ -62,9 +63,8 @@ public:
         enum Kind {
             File = 123, // Normal file
             Skip,       // Empty space
-            Link        // A meta data linked file
-
-            // ### add entries for qmldir, index, ...
+            Link,       // A meta data linked file
+            Index       // Sorted index of the file entries
         };
 
         int kind;
@@ -89,6 +89,18 @@ public:
         const char *contents() const;
     };
 
+    struct Q_QML_PRIVATE_EXPORT IndexEntry : public Entry
+    {
+        quint32 count;
+        quint32 offsets[]; // trailing data, followed by an IndexTrailer
+    };
+
+    struct IndexTrailer
+    {
+        quint32 indexOffset;
+        quint32 magic;
+    };
+
     QQmlBundle(const QString &fileName);
     ~QQmlBundle();
 
@@ -109,10 +121,14 @@ public:
 
     const FileEntry *link(const FileEntry *, const QString &linkName) const;
 
+    bool writeIndex();
+
     static int bundleHeaderLength();
     static bool isBundleHeader(const char *, int size);
 private:
     const Entry *findInsertPoint(quint32 size, qint32 *offset);
+    const IndexEntry *storedIndex() const;
+    void buildIndex() const;
 
 private:
     QFile file;
@@ -120,6 +136,12 @@ private:
     quint32 bufferSize;
     bool opened:1;
     bool headerWritten:1;
+
+    // Offsets of the file entries, sorted by file name
+    mutable bool indexBuilt;
+    mutable const quint32 *sortedIndex;
+    mutable quint32 sortedIndexCount;
+    mutable QVector<quint32> builtIndex;
 };
 
 QT_END_NAMESPACE
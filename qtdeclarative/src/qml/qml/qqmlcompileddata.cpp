@@ -45,6 +45,7 @@
 #include "qqmlcomponent_p.h"
 #include "qqmlcontext.h"
 #include "qqmlcontext_p.h"
+#include "qqmldiskcache_p.h"
 #ifdef QML_THREADED_VME_INTERPRETER
 #include "qqmlvme_p.h"
 #endif
@@ -107,6 +108,9 @@ QQmlCompiledData::~QQmlCompiledData()
     if (isRegisteredWithEngine)
         QQmlEnginePrivate::get(engine)->unregisterInternalCompositeType(this);
 
+    if (!sharedSourceHash.isEmpty())
+        QQmlDiskCache::releaseShared(this);
+
     clear();
 
     for (int ii = 0; ii < types.count(); ++ii) {
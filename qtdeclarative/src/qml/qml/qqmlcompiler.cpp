@@ -82,6 +82,9 @@ QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(compilerDump, QML_COMPILER_DUMP);
 DEFINE_BOOL_CONFIG_OPTION(compilerStatDump, QML_COMPILER_STATS);
+DEFINE_BOOL_CONFIG_OPTION(superInstructionsDisabled, QML_DISABLE_SUPERINSTRUCTIONS);
+DEFINE_BOOL_CONFIG_OPTION(v4RejectionsDump, QML_V4_REJECTIONS);
+DEFINE_BOOL_CONFIG_OPTION(staticDependenciesDisabled, QML_DISABLE_STATIC_DEPENDENCIES);
 
 using namespace QQmlJS;
 using namespace QQmlScript;
@@ -408,6 +411,112 @@ bool QQmlCompiler::testLiteralAssignment(QQmlScript::Property *prop, QQmlScript:
     return true;
 }
 
+/*!
+    Returns the url the string \a literal assigns to a url property.
+*/
+QUrl QQmlCompiler::literalUrl(const QString &literal)
+{
+    QString string = literal;
+    // Encoded dir-separators defeat QUrl processing - decode them first
+    string.replace(QLatin1String("%2f"), QLatin1String("/"), Qt::CaseInsensitive);
+    QUrl u = string.isEmpty() ? QUrl() : output->url.resolved(QUrl(string));
+    // Apply URL interceptor
+    if (engine->urlInterceptor())
+        u = engine->urlInterceptor()->intercept(u,
+                QQmlAbstractUrlInterceptor::UrlString);
+    return u;
+}
+
+/*!
+    Returns true if the assignment to \a prop is a single constant literal that
+    can be written as part of a StoreLiteralBlock, rather than with its own
+    instruction.
+*/
+bool QQmlCompiler::canPackLiteralAssignment(QQmlScript::Property *prop)
+{
+    if (prop->isDeferred || prop->isAlias || !prop->onValues.isEmpty() ||
+        !prop->values.isOne() || prop->values.first()->type != Value::Literal)
+        return false;
+
+    if (prop->core.isQList() || prop->core.isVarProperty())
+        return false;
+
+    if (prop->core.isEnum())
+        return true;
+
+    switch (prop->type) {
+    case QVariant::String:
+    case QVariant::Url:
+    case QVariant::UInt:
+    case QVariant::Int:
+    case QMetaType::Float:
+    case QVariant::Double:
+    case QVariant::Color:
+    case QVariant::Bool:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QQmlPackedLiteral QQmlCompiler::packLiteralAssignment(QQmlScript::Property *prop)
+{
+    Q_ASSERT(canPackLiteralAssignment(prop));
+    Value *v = prop->values.first();
+
+    QQmlPackedLiteral literal;
+    // Zero the padding, so that identical tables are shared through indexForByteArray()
+    ::memset(&literal, 0, sizeof(QQmlPackedLiteral));
+    literal.coreIndex = prop->index;
+
+    if (prop->core.isEnum()) {
+        Q_ASSERT(v->value.isNumber());
+        literal.type = QQmlPackedLiteral::Integer;
+        literal.intValue = (int)v->value.asNumber();
+        return literal;
+    }
+
+    switch (prop->type) {
+    case QVariant::String:
+        literal.type = QQmlPackedLiteral::String;
+        literal.index = output->indexForString(v->value.asString());
+        break;
+    case QVariant::Url:
+        literal.type = QQmlPackedLiteral::Url;
+        literal.index = output->indexForUrl(literalUrl(v->value.asString()));
+        break;
+    case QVariant::UInt:
+        literal.type = QQmlPackedLiteral::Integer;
+        literal.intValue = uint(v->value.asNumber());
+        break;
+    case QVariant::Int:
+        literal.type = QQmlPackedLiteral::Integer;
+        literal.intValue = int(v->value.asNumber());
+        break;
+    case QMetaType::Float:
+        literal.type = QQmlPackedLiteral::Float;
+        literal.floatValue = float(v->value.asNumber());
+        break;
+    case QVariant::Double:
+        literal.type = QQmlPackedLiteral::Double;
+        literal.doubleValue = v->value.asNumber();
+        break;
+    case QVariant::Color:
+        literal.type = QQmlPackedLiteral::Color;
+        literal.colorValue = QQmlStringConverters::rgbaFromString(v->value.asString());
+        break;
+    case QVariant::Bool:
+        literal.type = QQmlPackedLiteral::Bool;
+        literal.boolValue = v->value.asBoolean();
+        break;
+    default:
+        Q_ASSERT(!"Unexpected literal type");
+        break;
+    }
+
+    return literal;
+}
+
 /*!
     Generate a store instruction for assigning literal \a v to property \a prop.
 
@@ -514,16 +623,8 @@ void QQmlCompiler::genLiteralAssignment(QQmlScript::Property *prop,
         case QVariant::Url:
             {
             Instruction::StoreUrl instr;
-            QString string = v->value.asString();
-            // Encoded dir-separators defeat QUrl processing - decode them first
-            string.replace(QLatin1String("%2f"), QLatin1String("/"), Qt::CaseInsensitive);
-            QUrl u = string.isEmpty() ? QUrl() : output->url.resolved(QUrl(string));
-            // Apply URL interceptor
-            if (engine->urlInterceptor())
-                u = engine->urlInterceptor()->intercept(u,
-                        QQmlAbstractUrlInterceptor::UrlString);
             instr.propertyIndex = prop->index;
-            instr.value = output->indexForUrl(u);
+            instr.value = output->indexForUrl(literalUrl(v->value.asString()));
             output->addInstruction(instr);
             }
             break;
@@ -848,7 +949,12 @@ bool QQmlCompiler::compile(QQmlEngine *engine,
 
     compileTree(root);
 
+    if (!isError() && !superInstructionsDisabled())
+        fuseInstructions();
+
     if (!isError()) {
+        // Interned once the primitives are complete, rather than per string
+        enginePrivate->stringTable.intern(&out->primitives);
         if (compilerDump())
             out->dumpInstructions();
         if (componentStats)
@@ -881,26 +987,7 @@ void QQmlCompiler::compileTree(QQmlScript::Object *tree)
     // We generate the importCache before we build the tree so that
     // it can be used in the binding compiler.  Given we "expect" the
     // QML compilation to succeed, this isn't a waste.
-    output->importCache = new QQmlTypeNameCache();
-    foreach (const QString &ns, unit->namespaces()) {
-        output->importCache->add(ns);
-    }
-
-    int scriptIndex = 0;
-    foreach (const QQmlTypeData::ScriptReference &script, unit->resolvedScripts()) {
-        QString qualifier = script.qualifier;
-        QString enclosingNamespace;
-
-        const int lastDotIndex = qualifier.lastIndexOf(QLatin1Char('.'));
-        if (lastDotIndex != -1) {
-            enclosingNamespace = qualifier.left(lastDotIndex);
-            qualifier = qualifier.mid(lastDotIndex+1);
-        }
-
-        output->importCache->add(qualifier, scriptIndex++, enclosingNamespace);
-    }
-
-    unit->imports().populateCache(output->importCache);
+    output->importCache = createImportCache(unit);
 
     if (!buildObject(tree, BindingContext()) || !completeComponentBuild())
         return;
@@ -962,6 +1049,133 @@ void QQmlCompiler::compileTree(QQmlScript::Object *tree)
         enginePrivate->registerInternalCompositeType(output);
 }
 
+/*!
+    Rewrites the generated bytecode, replacing common instruction sequences with
+    superinstructions so that the VME dispatches (and checks for interruption)
+    fewer times per object.  A CreateSimpleObject directly followed by SetId
+    and/or BeginObject is replaced with a single CreateSimpleObjectAndBegin.
+
+    Defer and CreateComponent store the byte length of the block that follows
+    them, so these lengths are recalculated as the stream shrinks.
+
+    Setting the QML_DISABLE_SUPERINSTRUCTIONS environment variable skips this pass.
+*/
+void QQmlCompiler::fuseInstructions()
+{
+    struct Block {
+        int instruction;    // offset of the Defer/CreateComponent in the new stream
+        int start;          // offset of the block in the new stream
+        int end;            // end of the block in the old stream
+    };
+
+    const QByteArray bytecode = output->bytecode;
+    const char *code = bytecode.constData();
+    const int size = bytecode.size();
+
+    output->bytecode = QByteArray();
+    output->bytecode.reserve(size);
+
+    QVarLengthArray<Block, 8> blocks;
+    int offset = 0;
+    while (true) {
+        while (!blocks.isEmpty() && blocks.last().end == offset) {
+            const Block &block = blocks.last();
+            QQmlInstruction *instr = output->instruction(block.instruction);
+            const int count = output->nextInstructionIndex() - block.start;
+            if (output->instructionType(instr) == QQmlInstruction::Defer)
+                instr->defer.deferCount = count;
+            else
+                instr->createComponent.count = count;
+            blocks.removeLast();
+        }
+
+        if (offset >= size)
+            break;
+
+        const QQmlInstruction *instr = reinterpret_cast<const QQmlInstruction *>(code + offset);
+        const QQmlInstruction::Type type = output->instructionType(instr);
+        const int instrSize = QQmlInstruction::size(type);
+
+        if (type == QQmlInstruction::CreateSimpleObject) {
+            // Never fuse across the end of a Defer or CreateComponent block
+            const int blockEnd = blocks.isEmpty() ? size : blocks.last().end;
+
+            Instruction::CreateSimpleObjectAndBegin fused;
+            fused.id = -1;
+            fused.castValue = -1;
+
+            int next = offset + instrSize;
+            const QQmlInstruction *nextInstr = reinterpret_cast<const QQmlInstruction *>(code + next);
+            if (next < blockEnd && output->instructionType(nextInstr) == QQmlInstruction::SetId) {
+                fused.id = nextInstr->setId.index;
+                next += QQmlInstruction::size(QQmlInstruction::SetId);
+                nextInstr = reinterpret_cast<const QQmlInstruction *>(code + next);
+            }
+            if (next < blockEnd && output->instructionType(nextInstr) == QQmlInstruction::BeginObject) {
+                fused.castValue = nextInstr->begin.castValue;
+                next += QQmlInstruction::size(QQmlInstruction::BeginObject);
+            }
+
+            if (fused.id != -1 || fused.castValue != -1) {
+                fused.create = instr->createSimple.create;
+                fused.typeSize = instr->createSimple.typeSize;
+                fused.type = instr->createSimple.type;
+                fused.column = instr->createSimple.column;
+                fused.line = instr->createSimple.line;
+                fused.parentToSuper = instr->createSimple.parentToSuper;
+                output->addInstruction(fused);
+                offset = next;
+                continue;
+            }
+        }
+
+        const int newOffset = output->nextInstructionIndex();
+        output->bytecode.append(code + offset, instrSize);
+        offset += instrSize;
+
+        if (type == QQmlInstruction::Defer) {
+            Block block = { newOffset, newOffset + instrSize, offset + instr->defer.deferCount };
+            blocks.append(block);
+        } else if (type == QQmlInstruction::CreateComponent) {
+            Block block = { newOffset, newOffset + instrSize, offset + instr->createComponent.count };
+            blocks.append(block);
+        }
+    }
+
+    Q_ASSERT(blocks.isEmpty());
+}
+
+/*!
+    Returns a new type name cache for the namespaces, scripts and imports of \a unit.
+    The script indices match the order in which StoreImportedScript instructions
+    are generated.
+*/
+QQmlTypeNameCache *QQmlCompiler::createImportCache(QQmlTypeData *unit)
+{
+    QQmlTypeNameCache *cache = new QQmlTypeNameCache();
+    foreach (const QString &ns, unit->namespaces()) {
+        cache->add(ns);
+    }
+
+    int scriptIndex = 0;
+    foreach (const QQmlTypeData::ScriptReference &script, unit->resolvedScripts()) {
+        QString qualifier = script.qualifier;
+        QString enclosingNamespace;
+
+        const int lastDotIndex = qualifier.lastIndexOf(QLatin1Char('.'));
+        if (lastDotIndex != -1) {
+            enclosingNamespace = qualifier.left(lastDotIndex);
+            qualifier = qualifier.mid(lastDotIndex+1);
+        }
+
+        cache->add(qualifier, scriptIndex++, enclosingNamespace);
+    }
+
+    unit->imports().populateCache(cache);
+
+    return cache;
+}
+
 static bool QStringList_contains(const QStringList &list, const QHashedStringRef &string)
 {
     for (int ii = 0; ii < list.count(); ++ii)
@@ -1275,12 +1489,33 @@ void QQmlCompiler::genObjectBody(QQmlScript::Object *obj)
         output->addInstruction(ss);
     }
 
+    // Write all of the object's constant literal assignments with a single
+    // StoreLiteralBlock.  Bindings are not evaluated until the object is
+    // complete, so hoisting the literals above them has no visible effect.
+    QVarLengthArray<QQmlPackedLiteral, 16> literals;
+    if (!superInstructionsDisabled()) {
+        for (Property *prop = obj->valueProperties.first(); prop; prop = Object::PropertyList::next(prop)) {
+            if (canPackLiteralAssignment(prop))
+                literals.append(packLiteralAssignment(prop));
+        }
+    }
+    const bool packLiterals = literals.count() > 1;
+    if (packLiterals) {
+        Instruction::StoreLiteralBlock block;
+        block.data = output->indexForByteArray(QByteArray(reinterpret_cast<const char *>(literals.constData()),
+                                                          literals.count() * sizeof(QQmlPackedLiteral)));
+        block.count = literals.count();
+        output->addInstruction(block);
+    }
+
     bool seenDefer = false;
     for (Property *prop = obj->valueProperties.first(); prop; prop = Object::PropertyList::next(prop)) {
         if (prop->isDeferred) {
             seenDefer = true;
             continue;
         }
+        if (packLiterals && canPackLiteralAssignment(prop))
+            continue;
         if (!prop->isAlias)
             genValueProperty(prop, obj);
     }
@@ -2805,6 +3040,15 @@ static QStringList astNodeToStringList(QQmlJS::AST::Node *node)
 
 static QAtomicInt classIndexCounter(0);
 
+/*!
+    Returns the next suffix used to make the class names of synthesized meta objects
+    unique within the process.
+*/
+int QQmlCompiler::nextClassIndex()
+{
+    return classIndexCounter.fetchAndAddRelaxed(1);
+}
+
 bool QQmlCompiler::buildDynamicMeta(QQmlScript::Object *obj, DynamicMetaMode mode)
 {
     Q_ASSERT(obj);
@@ -2854,13 +3098,13 @@ bool QQmlCompiler::buildDynamicMeta(QQmlScript::Object *obj, DynamicMetaMode mod
             QString nameBase = path.mid(lastSlash + 1, path.length()-lastSlash-5);
             if (!nameBase.isEmpty() && nameBase.at(0).isUpper())
                 newClassName = nameBase.toUtf8() + "_QMLTYPE_" +
-                               QByteArray::number(classIndexCounter.fetchAndAddRelaxed(1));
+                               QByteArray::number(nextClassIndex());
         }
     }
     if (newClassName.isEmpty()) {
         newClassName = QQmlMetaObject(obj->metatype).className();
         newClassName.append("_QML_");
-        newClassName.append(QByteArray::number(classIndexCounter.fetchAndAddRelaxed(1)));
+        newClassName.append(QByteArray::number(nextClassIndex()));
     }
     QQmlPropertyCache *cache = obj->metatype->copyAndReserve(engine, obj->dynamicProperties.count(),
                                                              obj->dynamicProperties.count() +
@@ -3218,6 +3462,8 @@ bool QQmlCompiler::buildDynamicMeta(QQmlScript::Object *obj, DynamicMetaMode mod
         effectiveSignalIndex++;
     }
 
+    ((QQmlVMEMetaData *)dynamicData.data())->layoutStorage();
+
     // Alias property count.  Actual data is setup in buildDynamicMetaAliases
     ((QQmlVMEMetaData *)dynamicData.data())->aliasCount = aliasCount;
 
@@ -3587,6 +3833,7 @@ void QQmlCompiler::genBindingAssignment(QQmlScript::Value *binding,
         store.owner = js.bindingContext.owner;
         store.isAlias = prop->isAlias;
         store.isSafe = js.isSafe;
+        store.isStatic = js.isStatic;
         if (valueTypeProperty) {
             store.isRoot = (compileState->root == valueTypeProperty->parent);
         } else {
@@ -3678,6 +3925,10 @@ bool QQmlCompiler::completeComponentBuild()
 
     QList<JSBindingReference*> sharedBindings;
 
+    QSet<QString> ids;
+    for (Object *o = compileState->ids.first(); o; o = compileState->ids.next(o))
+        ids.insert(o->id);
+
     for (JSBindingReference *b = compileState->bindings.first(); b; b = b->nextReference) {
 
         JSBindingReference &binding = *b;
@@ -3700,6 +3951,11 @@ bool QQmlCompiler::completeComponentBuild()
                 continue;
 
             // Drop through. We need to create a V8 binding in case the V4 binding is invalidated
+        } else if (v4RejectionsDump()) {
+            qWarning().nospace() << qPrintable(output->name) << ':' << b->value->location.start.line
+                                 << ':' << b->value->location.start.column << ": binding on \""
+                                 << qPrintable(binding.property->name().toString()) << "\" not optimized: "
+                                 << qPrintable(bindingCompiler.discardReason());
         }
 
         // Pre-rewrite the expression
@@ -3715,6 +3971,12 @@ bool QQmlCompiler::completeComponentBuild()
         if (isSharable && binding.property->type != qMetaTypeId<QQmlBinding*>()) {
             sharedBindings.append(b);
 
+            if (!staticDependenciesDisabled()) {
+                QQmlRewrite::StaticDependencyTester tester(ids);
+                tester.parse(binding.expression.asAST());
+                binding.isStatic = tester.isStatic();
+            }
+
             if (!needsFallback) {
                 binding.dataType = BindingReference::V8;
                 binding.compiledIndex = -1;
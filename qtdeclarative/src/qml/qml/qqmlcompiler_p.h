@@ -91,6 +91,7 @@ public:
     int metaTypeId;
     int listMetaTypeId;
     bool isRegisteredWithEngine;
+    QByteArray sharedSourceHash; // Set while this uses a unit shared by QQmlDiskCache
 
     struct TypeReference 
     {
@@ -195,7 +196,7 @@ namespace QQmlCompilerTypes {
     struct JSBindingReference : public QQmlPool::Class,
                                 public BindingReference
     {
-        JSBindingReference() : isSafe(false), nextReference(0) {}
+        JSBindingReference() : isSafe(false), isStatic(false), nextReference(0) {}
 
         QQmlScript::Variant expression;
         QQmlScript::Property *property;
@@ -204,6 +205,7 @@ namespace QQmlCompilerTypes {
         int compiledIndex:15;
         int sharedIndex:15;
         bool isSafe:1;
+        bool isStatic:1;
 
         QString rewrittenExpression;
         BindingContext bindingContext;
@@ -297,6 +299,9 @@ public:
     static bool isAttachedPropertyName(const QHashedStringRef &);
     static bool isSignalPropertyName(const QHashedStringRef &);
 
+    static QQmlTypeNameCache *createImportCache(QQmlTypeData *);
+    static int nextClassIndex();
+
     int evaluateEnum(const QHashedStringRef &scope, const QByteArray& enumValue, bool *ok) const; // for QQmlCustomParser::evaluateEnum
     const QMetaObject *resolveType(const QString& name) const; // for QQmlCustomParser::resolveType
     int rewriteBinding(const QQmlScript::Variant& value, const QString& name); // for QQmlCustomParser::rewriteBinding
@@ -308,6 +313,7 @@ private:
     static void reset(QQmlCompiledData *);
 
     void compileTree(QQmlScript::Object *tree);
+    void fuseInstructions();
 
 
     bool buildObject(QQmlScript::Object *obj, const QQmlCompilerTypes::BindingContext &);
@@ -386,6 +392,9 @@ private:
                                QQmlScript::Property *valueTypeProperty = 0);
     void genLiteralAssignment(QQmlScript::Property *prop,
                               QQmlScript::Value *value);
+    bool canPackLiteralAssignment(QQmlScript::Property *prop);
+    QQmlPackedLiteral packLiteralAssignment(QQmlScript::Property *prop);
+    QUrl literalUrl(const QString &string);
     void genBindingAssignment(QQmlScript::Value *binding, 
                               QQmlScript::Property *prop, 
                               QQmlScript::Object *obj,
@@ -80,7 +80,8 @@ public:
     QQmlData()
         : ownMemory(true), ownContext(false), indestructible(true), explicitIndestructibleSet(false), 
           hasTaintedV8Object(false), isQueuedForDeletion(false), rootObjectInCreation(false),
-          hasVMEMetaObject(false), parentFrozen(false), notifyList(0), context(0), outerContext(0),
+          hasVMEMetaObject(false), parentFrozen(false), bindingsSuspended(false), hasDirtyBindings(false),
+          bindingsQueued(false), notifyList(0), context(0), outerContext(0),
           bindings(0), signalHandlers(0), nextContextObject(0), prevContextObject(0), bindingBitsSize(0), bindingBits(0),
           lineNumber(0), columnNumber(0), compiledData(0), deferredData(0), v8objectid(0),
           propertyCache(0), guards(0), extendedData(0) {
@@ -125,7 +126,20 @@ public:
     quint32 rootObjectInCreation:1;
     quint32 hasVMEMetaObject:1;
     quint32 parentFrozen:1;
-    quint32 dummy:23;
+    /*
+     * While bindingsSuspended is set, notifications to bindings on this object only mark
+     * them dirty.  Dirty bindings are re-evaluated when the object is resumed, or when
+     * the property they target is read.
+     */
+    quint32 bindingsSuspended:1;
+    quint32 hasDirtyBindings:1;
+    /*
+     * With QML_COALESCE_BINDINGS set, dirty bindings are also collected for objects that
+     * are not suspended, and evaluated once per event loop iteration.  bindingsQueued is
+     * set while the object is in its thread's binding queue.
+     */
+    quint32 bindingsQueued:1;
+    quint32 dummy:20;
 
     struct NotifyList {
         quint64 connectionMask;
@@ -213,11 +227,25 @@ public:
 
     static inline void flushPendingBinding(QObject *, int coreIndex);
 
+    static inline bool deferBindingUpdate(QObject *, QQmlAbstractBinding *);
+    void setBindingsSuspended(bool);
+
+    static bool isBindingCoalescingEnabled();
+    static void setBindingCoalescingEnabled(bool);
+    static void flushQueuedBindings();
+
 private:
-    // For attachedProperties
+    // For attachedProperties and dirty bindings
     mutable QQmlDataExtended *extendedData;
 
     void flushPendingBindingImpl(int coreIndex);
+    bool markBindingDirty(QQmlAbstractBinding *);
+    void queueBinding(QObject *, QQmlAbstractBinding *);
+    bool runDirtyBinding(int propertyIndex);
+    void flushDirtyBindingImpl(int coreIndex);
+    int flushDirtyBindings();
+
+    friend class QQmlBindingQueue;
 };
 
 bool QQmlData::wasDeleted(QObject *object)
@@ -273,8 +301,32 @@ bool QQmlData::hasPendingBindingBit(int coreIndex) const
 void QQmlData::flushPendingBinding(QObject *o, int coreIndex)
 {
     QQmlData *data = QQmlData::get(o, false);
-    if (data && data->hasPendingBindingBit(coreIndex))
+    if (!data)
+        return;
+    if (data->hasPendingBindingBit(coreIndex))
         data->flushPendingBindingImpl(coreIndex);
+    if (data->hasDirtyBindings)
+        data->flushDirtyBindingImpl(coreIndex);
+}
+
+/*
+Called by bindings on \a o when one of their dependencies changes.  Returns true if
+\a binding was marked dirty instead, in which case it must not be evaluated now.
+*/
+bool QQmlData::deferBindingUpdate(QObject *o, QQmlAbstractBinding *binding)
+{
+    QQmlData *data = QQmlData::get(o, false);
+    if (!data)
+        return false;
+
+    if (data->bindingsSuspended) {
+        data->markBindingDirty(binding);
+        return true;
+    } else if (isBindingCoalescingEnabled()) {
+        data->queueBinding(o, binding);
+        return true;
+    }
+    return false;
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,1414 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmldiskcache_p.h"
+
+#include <private/qqmlcompiler_p.h>
+#include <private/qqmlengine_p.h>
+#include <private/qqmlglobal_p.h>
+#include <private/qqmlmetatype_p.h>
+#include <private/qqmltypeloader_p.h>
+#include <private/qqmlaccessors_p.h>
+#include <private/qqmlvmemetaobject_p.h>
+#include <private/qqmlvme_p.h>
+#include <private/qv4bindings_p.h>
+#include <private/qv4program_p.h>
+
+#include <QtCore/qbuffer.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdebug.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtQml/qqmlfile.h>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(diskCacheEnabled, QML_DISK_CACHE);
+DEFINE_BOOL_CONFIG_OPTION(diskCacheDebug, QML_DISK_CACHE_DEBUG);
+DEFINE_BOOL_CONFIG_OPTION(sharedUnitsEnabled, QML_SHARE_COMPILED_DATA);
+
+using namespace QQmlJS;
+
+// Increase whenever the layout of the cache files changes
+static const quint32 qmlcMagic = 0x514d4c43; // "QMLC"
+static const quint32 qmlcVersion = 2;
+
+#define QML_INSTR_COUNT(I, FMT) + 1
+static const int qmlInstructionCount = 0 FOR_EACH_QML_INSTR(QML_INSTR_COUNT);
+#undef QML_INSTR_COUNT
+
+#define QML_V4_INSTR_COUNT(I, FMT) + 1
+static const int qmlV4InstructionCount = 0 FOR_EACH_V4_INSTR(QML_V4_INSTR_COUNT);
+#undef QML_V4_INSTR_COUNT
+
+namespace {
+
+struct SharedUnit
+{
+    SharedUnit() : users(0) {}
+
+    QByteArray sourceHash;
+    QByteArray data;
+    int users;             // QQmlCompiledData compiled from or into data
+};
+
+struct DiskCacheSettings
+{
+    DiskCacheSettings() : enabled(-1), sharing(-1), directoryInitialized(false) {}
+
+    QMutex mutex;
+    int enabled;
+    int sharing;
+    bool directoryInitialized;
+    QString directory;
+
+    // Serialized units shared between the engines of this process
+    QHash<QUrl, SharedUnit> sharedUnits;
+};
+
+// Meta type ids are process specific for anything but the builtin types
+enum MetaTypeKind {
+    BuiltinMetaType,       // Id of a builtin type
+    NamedMetaType,         // Normalized type name of a registered type
+    CompositeMetaType,     // Index of a composite type in QQmlCompiledData::types
+    CompositeListMetaType  // As above, for the list type
+};
+
+enum FixupKind {
+    MetaTypeFixup,         // int meta type id
+    AttachedPropertiesFixup, // int attached properties id
+    AccessorsFixup         // QQmlPropertyRawData::accessors and accessorData
+};
+
+// Fixups are applied either to the instruction stream, or to an entry in datas
+const qint32 BytecodeSection = -1;
+
+}
+
+Q_GLOBAL_STATIC(DiskCacheSettings, diskCacheSettings)
+
+class QQmlDiskCache::Writer
+{
+public:
+    Writer(QQmlTypeData *, QQmlCompiledData *);
+
+    bool write(QDataStream &);
+
+private:
+    bool writeMetaType(QDataStream &, int type);
+    bool writePropertyCache(QDataStream &, QQmlPropertyCache *);
+
+    bool metaTypeFixup(qint32 section, const char *base, const int *type);
+    bool attachedPropertiesFixup(qint32 section, const char *base, const int *id);
+    bool propertyDataFixups(qint32 section, const char *base, QQmlPropertyRawData *);
+
+    bool encodeInstructions(QByteArray &);
+    bool encodeV4Program(qint32 index);
+    bool encodeVMEMetaData(qint32 index);
+
+    int typeIndex(QQmlPropertyCache *);
+
+    QQmlEngine *engine;
+    QQmlEnginePrivate *enginePrivate;
+    QQmlTypeData *unit;
+    QQmlCompiledData *data;
+
+    QList<QByteArray> datas;
+    QSet<qint32> encodedDatas;
+
+    QByteArray fixupData;
+    QDataStream fixups;
+    qint32 fixupCount;
+};
+
+class QQmlDiskCache::Reader
+{
+public:
+    Reader(QQmlTypeData *, QQmlCompiledData *);
+
+    bool read(QDataStream &);
+
+private:
+    bool readMetaType(QDataStream &, int *type);
+    QQmlPropertyCache *readPropertyCache(QDataStream &);
+
+    bool decodeInstructions();
+    bool decodeV4Program(qint32 index);
+    bool applyFixups(int count, const QByteArray &);
+
+    QQmlEngine *engine;
+    QQmlEnginePrivate *enginePrivate;
+    QQmlTypeData *unit;
+    QQmlCompiledData *output;
+
+    QSet<qint32> decodedDatas;
+};
+
+QQmlDiskCache::Unit::Unit()
+: data(0), size(0), compiledDataOffset(0)
+{
+}
+
+QQmlDiskCache::Unit::~Unit()
+{
+}
+
+/*!
+    Returns true if compiled QML should be persisted.  This is controlled by the
+    QML_DISK_CACHE environment variable, unless overridden by setEnabled().
+*/
+bool QQmlDiskCache::isEnabled()
+{
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    if (settings->enabled == -1)
+        settings->enabled = diskCacheEnabled();
+    return settings->enabled;
+}
+
+void QQmlDiskCache::setEnabled(bool enabled)
+{
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    settings->enabled = enabled;
+}
+
+/*!
+    Returns true if compiled QML is shared between the engines of this process.
+    This is controlled by the QML_SHARE_COMPILED_DATA environment variable,
+    unless overridden by setSharingEnabled().
+*/
+bool QQmlDiskCache::isSharingEnabled()
+{
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    if (settings->sharing == -1)
+        settings->sharing = sharedUnitsEnabled();
+    return settings->sharing;
+}
+
+void QQmlDiskCache::setSharingEnabled(bool enabled)
+{
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    settings->sharing = enabled;
+    if (!enabled)
+        settings->sharedUnits.clear();
+}
+
+/*!
+    Returns the directory cache files are written to, or an empty string if they
+    are written next to the QML source.  Defaults to QML_DISK_CACHE_PATH.
+*/
+QString QQmlDiskCache::cacheDirectory()
+{
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    if (!settings->directoryInitialized) {
+        settings->directory = QString::fromLocal8Bit(qgetenv("QML_DISK_CACHE_PATH"));
+        settings->directoryInitialized = true;
+    }
+    return settings->directory;
+}
+
+void QQmlDiskCache::setCacheDirectory(const QString &directory)
+{
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    settings->directory = directory;
+    settings->directoryInitialized = true;
+}
+
+/*!
+    Returns the cache file used for the QML document at \a url, or an empty string
+    if documents at \a url cannot be cached.
+*/
+QString QQmlDiskCache::cacheFilePath(const QUrl &url)
+{
+    QString directory = cacheDirectory();
+    if (!directory.isEmpty()) {
+        QByteArray key = QCryptographicHash::hash(url.toString().toUtf8(),
+                                                  QCryptographicHash::Sha1).toHex();
+        return directory + QLatin1Char('/') + QString::fromLatin1(key) + QLatin1String(".qmlc");
+    }
+
+    if (!QQmlFile::isLocalFile(url))
+        return QString();
+
+    QString fileName = QQmlFile::urlToLocalFileOrQrc(url);
+    if (fileName.isEmpty() || fileName.startsWith(QLatin1Char(':')))
+        return QString();
+
+    return fileName + QLatin1Char('c');
+}
+
+QByteArray QQmlDiskCache::sourceHash(const char *data, int size)
+{
+    return QCryptographicHash::hash(QByteArray::fromRawData(data, size), QCryptographicHash::Sha1);
+}
+
+/*!
+    Returns an id identifying the QtQml version, and the instruction layout it uses.
+    Cache files written by an incompatible build are ignored.  The id does not
+    depend on the host, so that qmlcompile can write bundles for other devices
+    using the same QtQml configuration.
+*/
+QByteArray QQmlDiskCache::buildId()
+{
+    QByteArray id(QT_VERSION_STR);
+    id += ' ';
+    id += QByteArray::number(QSysInfo::WordSize);
+    id += QSysInfo::ByteOrder == QSysInfo::BigEndian ? " be " : " le ";
+    id += QByteArray::number(int(sizeof(QQmlInstruction)));
+    id += ' ';
+    id += QByteArray::number(int(sizeof(QQmlPropertyRawData)));
+    id += ' ';
+    id += QByteArray::number(qmlInstructionCount);
+    id += ' ';
+    id += QByteArray::number(qmlV4InstructionCount);
+#ifdef QML_THREADED_VME_INTERPRETER
+    id += " threaded";
+#endif
+    return id;
+}
+
+/*!
+    Returns the cached unit for \a url, or 0 if there is none matching \a sourceHash.
+    The cache file is mapped into memory for the lifetime of the unit.
+*/
+QQmlDiskCache::Unit *QQmlDiskCache::load(const QUrl &url, const QByteArray &sourceHash)
+{
+    QString fileName = cacheFilePath(url);
+    if (fileName.isEmpty())
+        return 0;
+
+    Unit *unit = new Unit;
+    unit->file.setFileName(fileName);
+    if (unit->file.open(QFile::ReadOnly) && unit->file.size() > 0 && unit->file.size() < INT_MAX) {
+        unit->size = unit->file.size();
+        unit->data = reinterpret_cast<const char *>(unit->file.map(0, unit->size));
+    }
+
+    if (!unit->data || !readUnit(unit, sourceHash)) {
+        if (diskCacheDebug() && unit->data)
+            qWarning() << "QQmlDiskCache: Ignoring stale cache file" << fileName;
+        delete unit;
+        return 0;
+    }
+
+    return unit;
+}
+
+/*!
+    Returns the unit cached in \a data, for example the "qml:compiled" meta data of a
+    bundle entry, or 0 if it does not match \a sourceHash.
+*/
+QQmlDiskCache::Unit *QQmlDiskCache::load(const QByteArray &data, const QByteArray &sourceHash)
+{
+    Unit *unit = new Unit;
+    unit->buffer = data;
+    // Bundle meta data refers to the mapped bundle, which may be closed before
+    // the unit is restored from
+    unit->buffer.detach();
+    unit->data = unit->buffer.constData();
+    unit->size = unit->buffer.size();
+
+    if (!readUnit(unit, sourceHash)) {
+        delete unit;
+        return 0;
+    }
+
+    return unit;
+}
+
+/*!
+    Returns the unit another engine of this process compiled for \a url, or 0 if
+    there is none matching \a sourceHash.  The serialized data is shared, not
+    copied, between the engines restoring it.
+*/
+QQmlDiskCache::Unit *QQmlDiskCache::loadShared(const QUrl &url, const QByteArray &sourceHash)
+{
+    QByteArray data;
+    {
+        DiskCacheSettings *settings = diskCacheSettings();
+        QMutexLocker locker(&settings->mutex);
+        QHash<QUrl, SharedUnit>::ConstIterator iter = settings->sharedUnits.find(url);
+        if (iter == settings->sharedUnits.constEnd() || iter->sourceHash != sourceHash)
+            return 0;
+        data = iter->data;
+    }
+
+    Unit *unit = new Unit;
+    unit->buffer = data;
+    unit->data = unit->buffer.constData();
+    unit->size = unit->buffer.size();
+    unit->sharedSourceHash = sourceHash;
+
+    if (!readUnit(unit, sourceHash)) {
+        delete unit;
+        return 0;
+    }
+
+    return unit;
+}
+
+bool QQmlDiskCache::readUnit(Unit *unit, const QByteArray &sourceHash)
+{
+    QByteArray bytes = QByteArray::fromRawData(unit->data, unit->size);
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    QDataStream ds(&buffer);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    ds >> magic >> version;
+    if (ds.status() != QDataStream::Ok || magic != qmlcMagic || version != qmlcVersion)
+        return false;
+
+    QByteArray id;
+    QByteArray hash;
+    ds >> id >> hash;
+    if (id != buildId() || hash != sourceHash)
+        return false;
+
+    qint32 importCount = 0;
+    ds >> importCount;
+    for (int ii = 0; ds.status() == QDataStream::Ok && ii < importCount; ++ii) {
+        QQmlScript::Import import;
+        qint32 type;
+        ds >> type >> import.uri >> import.qualifier >> import.majorVersion >> import.minorVersion
+           >> import.location.start.line >> import.location.start.column;
+        import.type = QQmlScript::Import::Type(type);
+        unit->imports.append(import);
+    }
+
+    qint32 typeCount = 0;
+    ds >> typeCount;
+    for (int ii = 0; ds.status() == QDataStream::Ok && ii < typeCount; ++ii) {
+        QString name;
+        QQmlScript::Location location;
+        ds >> name >> location.line >> location.column;
+        unit->typeNames.append(name);
+        unit->typeLocations.append(location);
+    }
+
+    if (ds.status() != QDataStream::Ok)
+        return false;
+
+    unit->compiledDataOffset = buffer.pos();
+    return true;
+}
+
+/*!
+    Restores the compiled data of \a unit from \a cached into \a output.  All
+    dependencies of \a unit must be complete.
+
+    Returns false if the cache is stale, for example because a type it references
+    changed its API.  In this case \a output must be discarded, and the document
+    compiled from source.
+*/
+bool QQmlDiskCache::restore(QQmlTypeData *unit, const Unit *cached, QQmlCompiledData *output)
+{
+    QByteArray bytes = QByteArray::fromRawData(cached->data + cached->compiledDataOffset,
+                                               cached->size - cached->compiledDataOffset);
+    QDataStream ds(bytes);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    Reader reader(unit, output);
+    if (reader.read(ds) && ds.status() == QDataStream::Ok) {
+        if (!cached->sharedSourceHash.isEmpty())
+            acquireShared(output, cached->sharedSourceHash);
+        return true;
+    }
+
+    if (diskCacheDebug())
+        qWarning() << "QQmlDiskCache: Cache for" << output->name << "is out of date";
+    return false;
+}
+
+/*!
+    Returns the cache file contents for \a unit and its compiled \a data, or an empty
+    byte array if the data cannot be persisted.
+*/
+QByteArray QQmlDiskCache::serialize(QQmlTypeData *unit, QQmlCompiledData *data,
+                                    const QByteArray &sourceHash)
+{
+    QByteArray rv;
+    QDataStream ds(&rv, QIODevice::WriteOnly);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    ds << qmlcMagic << qmlcVersion << buildId() << sourceHash;
+
+    QList<QQmlScript::Import> imports = unit->parser().imports();
+    ds << qint32(imports.count());
+    foreach (const QQmlScript::Import &import, imports) {
+        ds << qint32(import.type) << import.uri << import.qualifier
+           << qint32(import.majorVersion) << qint32(import.minorVersion)
+           << import.location.start.line << import.location.start.column;
+    }
+
+    QList<QQmlScript::TypeReference *> referencedTypes = unit->parser().referencedTypes();
+    ds << qint32(referencedTypes.count());
+    foreach (QQmlScript::TypeReference *type, referencedTypes) {
+        Q_ASSERT(type->firstUse);
+        ds << type->name << type->firstUse->location.start.line
+           << type->firstUse->location.start.column;
+    }
+
+    Writer writer(unit, data);
+    if (!writer.write(ds)) {
+        if (diskCacheDebug())
+            qWarning() << "QQmlDiskCache: Cannot cache" << data->name;
+        return QByteArray();
+    }
+
+    return rv;
+}
+
+/*!
+    Writes the cache file for \a unit.  Returns false if \a data cannot be
+    persisted, or the file cannot be written.
+*/
+bool QQmlDiskCache::save(QQmlTypeData *unit, QQmlCompiledData *data, const QByteArray &sourceHash)
+{
+    QString fileName = cacheFilePath(data->url);
+    if (fileName.isEmpty())
+        return false;
+
+    QByteArray bytes = serialize(unit, data, sourceHash);
+    if (bytes.isEmpty())
+        return false;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() || !file.commit()) {
+        if (diskCacheDebug())
+            qWarning() << "QQmlDiskCache: Cannot write" << fileName;
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+    Makes the compiled \a data of \a unit available to the other engines of this
+    process.  Returns false if \a data cannot be persisted.
+*/
+bool QQmlDiskCache::share(QQmlTypeData *unit, QQmlCompiledData *data, const QByteArray &sourceHash)
+{
+    QByteArray bytes = serialize(unit, data, sourceHash);
+    if (bytes.isEmpty())
+        return false;
+
+    {
+        DiskCacheSettings *settings = diskCacheSettings();
+        QMutexLocker locker(&settings->mutex);
+        SharedUnit &shared = settings->sharedUnits[data->url];
+        if (shared.sourceHash != sourceHash) {
+            shared.sourceHash = sourceHash;
+            shared.data = bytes;
+            shared.users = 0;
+        }
+    }
+
+    acquireShared(data, sourceHash);
+    return true;
+}
+
+/*
+    Records that \a data uses the shared unit of its URL, if it still matches
+    \a sourceHash.  The unit is kept until all of its users have been released.
+*/
+void QQmlDiskCache::acquireShared(QQmlCompiledData *data, const QByteArray &sourceHash)
+{
+    Q_ASSERT(data->sharedSourceHash.isEmpty());
+
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    QHash<QUrl, SharedUnit>::Iterator iter = settings->sharedUnits.find(data->url);
+    if (iter == settings->sharedUnits.end() || iter->sourceHash != sourceHash)
+        return;
+
+    ++iter->users;
+    data->sharedSourceHash = sourceHash;
+}
+
+/*
+    Called when \a data, which uses a shared unit, is destroyed.  The unit is
+    dropped once no compiled data of any engine uses it anymore.
+*/
+void QQmlDiskCache::releaseShared(QQmlCompiledData *data)
+{
+    Q_ASSERT(!data->sharedSourceHash.isEmpty());
+
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    QHash<QUrl, SharedUnit>::Iterator iter = settings->sharedUnits.find(data->url);
+    if (iter == settings->sharedUnits.end() || iter->sourceHash != data->sharedSourceHash)
+        return;
+
+    if (--iter->users == 0)
+        settings->sharedUnits.erase(iter);
+}
+
+/*!
+    Releases the compiled data shared between engines.  Units already restored
+    are not affected.
+*/
+void QQmlDiskCache::clearShared()
+{
+    DiskCacheSettings *settings = diskCacheSettings();
+    QMutexLocker locker(&settings->mutex);
+    settings->sharedUnits.clear();
+}
+
+/*!
+    Compiles the QML document \a source, as if it were loaded from \a url by \a engine,
+    and returns its compiled data in the cache file format.  This is used to add
+    precompiled data to bundles.
+
+    Returns an empty byte array, and fills in \a errors, if the document cannot be
+    compiled or persisted.
+*/
+QByteArray QQmlDiskCache::precompile(QQmlEngine *engine, const QUrl &url, const QByteArray &source,
+                                     QList<QQmlError> *errors)
+{
+    QQmlTypeLoader &typeLoader = QQmlEnginePrivate::get(engine)->typeLoader;
+
+    // The parser is needed to write the imports and type references
+    QQmlTypeData *typeData = typeLoader.getType(source, url, QQmlTypeLoader::PreserveParser);
+
+    QByteArray rv;
+    if (typeData->isComplete() && typeData->compiledData()) {
+        rv = serialize(typeData, typeData->compiledData(), sourceHash(source.constData(), source.size()));
+        if (rv.isEmpty()) {
+            QQmlError error;
+            error.setUrl(url);
+            error.setDescription(QLatin1String("Compiled data cannot be persisted"));
+            errors->append(error);
+        }
+    } else {
+        *errors << typeData->errors();
+    }
+
+    typeData->release();
+    return rv;
+}
+
+/*!
+    Returns a fingerprint of the names and indices exposed by \a cache.  Documents
+    are only restored if the fingerprints of all the types they use are unchanged.
+*/
+quint32 QQmlDiskCache::fingerprint(QQmlPropertyCache *cache)
+{
+    // The sum is independent of the iteration order of the string hash
+    quint32 rv = quint32(cache->propertyCount()) * 31 + quint32(cache->methodCount());
+    for (QQmlPropertyCache::StringCache::ConstIterator iter = cache->stringCache.begin();
+         iter != cache->stringCache.end(); ++iter) {
+        quint32 entry = iter.key().hash() ^ (quint32((*iter).first) * 2654435761U);
+        if ((*iter).second->isFunction())
+            entry = ~entry;
+        rv += entry * 2246822519U;
+    }
+    return rv;
+}
+
+QQmlDiskCache::Writer::Writer(QQmlTypeData *unit, QQmlCompiledData *data)
+: engine(data->engine), enginePrivate(QQmlEnginePrivate::get(data->engine)), unit(unit),
+  data(data), datas(data->datas), fixups(&fixupData, QIODevice::WriteOnly), fixupCount(0)
+{
+    fixups.setVersion(QDataStream::Qt_5_0);
+}
+
+bool QQmlDiskCache::Writer::write(QDataStream &ds)
+{
+    // Types resolved from the document are resolved again on restore.  Any types
+    // the compiler referenced implicitly are stored by name.
+    const int resolvedTypeCount = unit->resolvedTypes().count();
+    ds << qint32(resolvedTypeCount) << qint32(data->types.count() - resolvedTypeCount);
+    for (int ii = resolvedTypeCount; ii < data->types.count(); ++ii) {
+        QQmlType *type = data->types.at(ii).type;
+        if (!type || type->qmlTypeName().isEmpty())
+            return false;
+        ds << type->qmlTypeName() << qint32(type->majorVersion()) << qint32(type->minorVersion());
+    }
+
+    for (int ii = 0; ii < data->types.count(); ++ii)
+        ds << fingerprint(data->types[ii].createPropertyCache(engine));
+
+    ds << qint32(data->propertyCaches.count());
+    for (int ii = 0; ii < data->propertyCaches.count(); ++ii) {
+        if (!writePropertyCache(ds, data->propertyCaches.at(ii)))
+            return false;
+    }
+
+    qint32 rootCache = data->propertyCaches.indexOf(data->rootPropertyCache);
+    qint32 rootType = rootCache == -1 ? typeIndex(data->rootPropertyCache) : -1;
+    if (rootCache == -1 && rootType == -1)
+        return false;
+    ds << rootCache << rootType;
+
+    ds << qint32(data->contextCaches.count());
+    for (int ii = 0; ii < data->contextCaches.count(); ++ii) {
+        QQmlIntegerCache *cache = data->contextCaches.at(ii);
+        ds << qint32(cache->count());
+        for (int id = 0; id < cache->count(); ++id) {
+            QString name = cache->findId(id);
+            if (name.isEmpty())
+                return false;
+            ds << name;
+        }
+    }
+
+    ds << data->primitives << data->urls;
+
+    ds << qint32(data->programs.count());
+    for (int ii = 0; ii < data->programs.count(); ++ii)
+        ds << data->programs.at(ii).program;
+
+    QByteArray bytecode = data->bytecode;
+    if (!encodeInstructions(bytecode))
+        return false;
+
+    ds << bytecode << datas << fixupCount << fixupData;
+
+    return ds.status() == QDataStream::Ok;
+}
+
+int QQmlDiskCache::Writer::typeIndex(QQmlPropertyCache *cache)
+{
+    for (int ii = 0; ii < data->types.count(); ++ii) {
+        if (data->types[ii].createPropertyCache(engine) == cache)
+            return ii;
+    }
+    return -1;
+}
+
+bool QQmlDiskCache::Writer::writeMetaType(QDataStream &ds, int type)
+{
+    if (type < QMetaType::User) {
+        ds << quint8(BuiltinMetaType) << qint32(type);
+        return true;
+    }
+
+    for (int ii = 0; ii < data->types.count(); ++ii) {
+        QQmlCompiledData *component = data->types.at(ii).component;
+        if (!component)
+            continue;
+        if (component->metaTypeId == type) {
+            ds << quint8(CompositeMetaType) << qint32(ii);
+            return true;
+        } else if (component->listMetaTypeId == type) {
+            ds << quint8(CompositeListMetaType) << qint32(ii);
+            return true;
+        }
+    }
+
+    // The names of other composite types are generated, and not stable across runs
+    if (enginePrivate->isInternalCompositeType(type))
+        return false;
+
+    const char *name = QMetaType::typeName(type);
+    if (!name)
+        return false;
+
+    ds << quint8(NamedMetaType) << QByteArray(name);
+    return true;
+}
+
+bool QQmlDiskCache::Writer::writePropertyCache(QDataStream &ds, QQmlPropertyCache *cache)
+{
+    qint32 parent = typeIndex(cache->parent());
+    if (parent == -1)
+        return false;
+
+    // The numbered suffix is regenerated on restore, to keep the name unique
+    QByteArray className = cache->_dynamicClassName;
+    int suffix = className.length();
+    while (suffix > 0 && className.at(suffix - 1) >= '0' && className.at(suffix - 1) <= '9')
+        --suffix;
+    className.truncate(suffix);
+
+    QHash<const QQmlPropertyData *, QString> names;
+    for (QQmlPropertyCache::StringCache::ConstIterator iter = cache->stringCache.begin();
+         iter != cache->stringCache.end(); ++iter) {
+        names.insert((*iter).second, iter.key());
+    }
+
+    int signalCount = 0;
+    for (int ii = 0; ii < cache->methodIndexCache.count(); ++ii) {
+        if (cache->methodIndexCache.at(ii).isSignal())
+            ++signalCount;
+    }
+
+    ds << parent << className << cache->_defaultPropertyName
+       << qint32(cache->propertyIndexCache.count()) << qint32(cache->methodIndexCache.count())
+       << qint32(signalCount);
+
+    // Methods are appended before properties by the compiler, so that the
+    // override information is restored in the same way.
+    for (int ii = 0; ii < cache->methodIndexCache.count(); ++ii) {
+        const QQmlPropertyData &method = cache->methodIndexCache.at(ii);
+        QString name = names.value(&method);
+        if (name.isEmpty())
+            return false;
+
+        QVector<int> types;
+        QList<QByteArray> parameterNames;
+        QQmlPropertyCache::methodArguments(&method, &types, &parameterNames);
+
+        ds << name << quint32(method.getFlags() & ~QQmlPropertyData::IsOverridden)
+           << qint32(method.coreIndex) << parameterNames;
+
+        if (method.isSignal() && method.hasArguments()) {
+            if (types.isEmpty())
+                return false;
+            ds << qint32(types.count() - 1);
+            for (int jj = 1; jj < types.count(); ++jj) {
+                if (!writeMetaType(ds, types.at(jj)))
+                    return false;
+            }
+        }
+    }
+
+    for (int ii = 0; ii < cache->propertyIndexCache.count(); ++ii) {
+        const QQmlPropertyData &property = cache->propertyIndexCache.at(ii);
+        QString name = names.value(&property);
+        if (name.isEmpty() || property.hasAccessors() ||
+            (property.getFlags() & QQmlPropertyData::NotFullyResolved))
+            return false;
+
+        ds << name << quint32(property.getFlags() & ~QQmlPropertyData::IsOverridden)
+           << qint32(property.coreIndex) << qint32(property.notifyIndex);
+        if (!writeMetaType(ds, property.propType))
+            return false;
+    }
+
+    return true;
+}
+
+bool QQmlDiskCache::Writer::metaTypeFixup(qint32 section, const char *base, const int *type)
+{
+    if (*type < QMetaType::User)
+        return true;
+
+    fixups << quint8(MetaTypeFixup) << section << qint32(reinterpret_cast<const char *>(type) - base);
+    ++fixupCount;
+    return writeMetaType(fixups, *type);
+}
+
+bool QQmlDiskCache::Writer::attachedPropertiesFixup(qint32 section, const char *base, const int *id)
+{
+    // Attached property ids depend on the type registration order
+    QQmlType *attachedType = 0;
+    foreach (QQmlType *type, QQmlMetaType::qmlTypes()) {
+        if (type->attachedPropertiesFunction() && type->attachedPropertiesId() == *id &&
+            !type->qmlTypeName().isEmpty()) {
+            attachedType = type;
+            break;
+        }
+    }
+
+    if (!attachedType)
+        return false;
+
+    fixups << quint8(AttachedPropertiesFixup) << section
+           << qint32(reinterpret_cast<const char *>(id) - base) << attachedType->qmlTypeName()
+           << qint32(attachedType->majorVersion()) << qint32(attachedType->minorVersion());
+    ++fixupCount;
+    return true;
+}
+
+bool QQmlDiskCache::Writer::propertyDataFixups(qint32 section, const char *base,
+                                               QQmlPropertyRawData *property)
+{
+    QQmlPropertyRawData::Flags flags = property->getFlags();
+
+    // These hold pointers into structures that cannot be recreated here
+    if (flags & QQmlPropertyRawData::NotFullyResolved)
+        return false;
+    if ((flags & QQmlPropertyRawData::IsFunction) && (flags & QQmlPropertyRawData::HasArguments))
+        return false;
+
+    if (flags & QQmlPropertyRawData::HasAccessors) {
+        const QMetaObject *metaObject = 0;
+        QQmlAccessorProperties::Property *accessor =
+            QQmlAccessorProperties::findProperty(property->accessors, property->accessorData,
+                                                 &metaObject);
+        if (!accessor)
+            return false;
+
+        fixups << quint8(AccessorsFixup) << section
+               << qint32(reinterpret_cast<const char *>(property) - base)
+               << QByteArray(metaObject->className())
+               << QByteArray(accessor->name, accessor->nameLength);
+        ++fixupCount;
+
+        property->accessors = 0;
+        property->accessorData = 0;
+    } else if ((flags & QQmlPropertyRawData::IsValueTypeVirtual) &&
+               property->valueTypePropType >= QMetaType::User) {
+        return false;
+    }
+
+    return metaTypeFixup(section, base, &property->propType);
+}
+
+bool QQmlDiskCache::Writer::encodeInstructions(QByteArray &bytecode)
+{
+    char *code = bytecode.data();
+    const char *base = code;
+    const char *end = code + bytecode.size();
+
+    while (code < end) {
+        QQmlInstruction *instr = reinterpret_cast<QQmlInstruction *>(code);
+        QQmlInstruction::Type type = data->instructionType(instr);
+
+#ifdef QML_THREADED_VME_INTERPRETER
+        // The jump address is replaced by the instruction type
+        instr->common.code = reinterpret_cast<void *>(quintptr(type));
+#endif
+
+        bool ok = true;
+        switch (type) {
+        case QQmlInstruction::Init:
+            if (instr->init.compiledBinding != -1)
+                ok = encodeV4Program(instr->init.compiledBinding);
+            break;
+        case QQmlInstruction::CreateSimpleObject:
+            instr->createSimple.create = 0;
+            break;
+        case QQmlInstruction::CreateSimpleObjectAndBegin:
+            instr->createSimpleAndBegin.create = 0;
+            break;
+        case QQmlInstruction::StoreMetaObject:
+            ok = encodeVMEMetaData(instr->storeMeta.aliasData);
+            break;
+        case QQmlInstruction::StoreBinding:
+        case QQmlInstruction::StoreV8Binding:
+            ok = propertyDataFixups(BytecodeSection, base, &instr->assignBinding.property);
+            break;
+        case QQmlInstruction::StoreValueSource:
+            ok = propertyDataFixups(BytecodeSection, base, &instr->assignValueSource.property);
+            break;
+        case QQmlInstruction::StoreValueInterceptor:
+            ok = propertyDataFixups(BytecodeSection, base, &instr->assignValueInterceptor.property);
+            break;
+        case QQmlInstruction::StoreV4Binding:
+            ok = metaTypeFixup(BytecodeSection, base, &instr->assignV4Binding.propType);
+            break;
+        case QQmlInstruction::AssignCustomType:
+            ok = metaTypeFixup(BytecodeSection, base, &instr->assignCustomType.type);
+            break;
+        case QQmlInstruction::FetchValueType:
+        case QQmlInstruction::PopValueType:
+            ok = metaTypeFixup(BytecodeSection, base, &instr->fetchValue.type);
+            break;
+        case QQmlInstruction::FetchQList:
+            ok = metaTypeFixup(BytecodeSection, base, &instr->fetchQmlList.type);
+            break;
+        case QQmlInstruction::FetchAttached:
+            ok = attachedPropertiesFixup(BytecodeSection, base, &instr->fetchAttached.id);
+            break;
+        default:
+            break;
+        }
+
+        if (!ok)
+            return false;
+
+        code += QQmlInstruction::size(type);
+    }
+
+    return true;
+}
+
+bool QQmlDiskCache::Writer::encodeV4Program(qint32 index)
+{
+    if (encodedDatas.contains(index))
+        return true;
+    encodedDatas.insert(index);
+
+    QByteArray &programData = datas[index];
+    char *base = programData.data();
+    QV4Program *program = reinterpret_cast<QV4Program *>(base);
+
+    Bytecode bc;
+    char *code = const_cast<char *>(program->instructions());
+    const char *end = code + program->instructionCount;
+
+    while (code < end) {
+        V4Instr *instr = reinterpret_cast<V4Instr *>(code);
+        V4Instr::Type type = bc.instructionType(instr);
+
+#ifdef QML_THREADED_INTERPRETER
+        instr->common.code = reinterpret_cast<void *>(quintptr(type));
+#endif
+
+        if (type == V4Instr::FetchAndSubscribe) {
+            if (!propertyDataFixups(index, base, &instr->fetchAndSubscribe.property))
+                return false;
+        } else if (type == V4Instr::LoadAttached) {
+            if (!attachedPropertiesFixup(index, base, reinterpret_cast<int *>(&instr->attached.id)))
+                return false;
+        }
+
+        code += V4Instr::size(type);
+    }
+
+    return true;
+}
+
+bool QQmlDiskCache::Writer::encodeVMEMetaData(qint32 index)
+{
+    if (encodedDatas.contains(index))
+        return true;
+    encodedDatas.insert(index);
+
+    QByteArray &metaData = datas[index];
+    const char *base = metaData.data();
+    QQmlVMEMetaData *vmd = reinterpret_cast<QQmlVMEMetaData *>(metaData.data());
+
+    for (int ii = 0; ii < vmd->propertyCount; ++ii) {
+        if (!metaTypeFixup(index, base, &(vmd->propertyData() + ii)->propertyType))
+            return false;
+    }
+
+    for (int ii = 0; ii < vmd->aliasCount; ++ii) {
+        if (!metaTypeFixup(index, base, &(vmd->aliasData() + ii)->propType))
+            return false;
+    }
+
+    return true;
+}
+
+QQmlDiskCache::Reader::Reader(QQmlTypeData *unit, QQmlCompiledData *output)
+: engine(output->engine), enginePrivate(QQmlEnginePrivate::get(output->engine)), unit(unit),
+  output(output)
+{
+}
+
+bool QQmlDiskCache::Reader::read(QDataStream &ds)
+{
+    // Resolve types as QQmlCompiler::compile() does
+    const QList<QQmlTypeData::TypeReference> &resolvedTypes = unit->resolvedTypes();
+
+    qint32 resolvedTypeCount = 0;
+    qint32 extraTypeCount = 0;
+    ds >> resolvedTypeCount >> extraTypeCount;
+    if (ds.status() != QDataStream::Ok || resolvedTypeCount != resolvedTypes.count())
+        return false;
+
+    for (int ii = 0; ii < resolvedTypes.count(); ++ii) {
+        QQmlCompiledData::TypeReference ref;
+
+        const QQmlTypeData::TypeReference &tref = resolvedTypes.at(ii);
+        if (tref.typeData) {
+            ref.component = tref.typeData->compiledData();
+            ref.component->addref();
+        } else if (tref.type) {
+            ref.type = tref.type;
+            if (!ref.type->isCreatable())
+                return false;
+
+            if (ref.type->containsRevisionedAttributes()) {
+                QQmlError cacheError;
+                ref.typePropertyCache = enginePrivate->cache(ref.type, tref.minorVersion,
+                                                             cacheError);
+                if (!ref.typePropertyCache)
+                    return false;
+                ref.typePropertyCache->addref();
+            }
+        }
+
+        output->types << ref;
+    }
+
+    for (int ii = 0; ii < extraTypeCount; ++ii) {
+        QString name;
+        qint32 majorVersion;
+        qint32 minorVersion;
+        ds >> name >> majorVersion >> minorVersion;
+
+        QQmlCompiledData::TypeReference ref;
+        ref.type = QQmlMetaType::qmlType(name, majorVersion, minorVersion);
+        if (!ref.type)
+            return false;
+        output->types << ref;
+    }
+
+    for (int ii = 0; ii < output->types.count(); ++ii) {
+        quint32 typeFingerprint;
+        ds >> typeFingerprint;
+        if (typeFingerprint != fingerprint(output->types[ii].createPropertyCache(engine)))
+            return false;
+    }
+
+    output->importCache = QQmlCompiler::createImportCache(unit);
+
+    foreach (const QQmlTypeData::ScriptReference &script, unit->resolvedScripts()) {
+        QQmlScriptData *scriptData = script.script->scriptData();
+        scriptData->addref();
+        output->scripts << scriptData;
+    }
+
+    qint32 propertyCacheCount = 0;
+    ds >> propertyCacheCount;
+    for (int ii = 0; ii < propertyCacheCount; ++ii) {
+        QQmlPropertyCache *cache = readPropertyCache(ds);
+        if (!cache)
+            return false;
+        output->propertyCaches << cache;
+    }
+
+    qint32 rootCache = -1;
+    qint32 rootType = -1;
+    ds >> rootCache >> rootType;
+    if (rootCache >= 0 && rootCache < output->propertyCaches.count())
+        output->rootPropertyCache = output->propertyCaches.at(rootCache);
+    else if (rootType >= 0 && rootType < output->types.count())
+        output->rootPropertyCache = output->types[rootType].createPropertyCache(engine);
+    else
+        return false;
+    output->rootPropertyCache->addref();
+
+    qint32 contextCacheCount = 0;
+    ds >> contextCacheCount;
+    for (int ii = 0; ds.status() == QDataStream::Ok && ii < contextCacheCount; ++ii) {
+        qint32 idCount = 0;
+        ds >> idCount;
+
+        QQmlIntegerCache *cache = new QQmlIntegerCache();
+        output->contextCaches.append(cache);
+        cache->reserve(idCount);
+        for (int id = 0; ds.status() == QDataStream::Ok && id < idCount; ++id) {
+            QString name;
+            ds >> name;
+            cache->add(name, id);
+        }
+    }
+
+    ds >> output->primitives >> output->urls;
+    enginePrivate->stringTable.intern(&output->primitives);
+
+    qint32 programCount = 0;
+    ds >> programCount;
+    for (int ii = 0; ds.status() == QDataStream::Ok && ii < programCount; ++ii) {
+        QByteArray program;
+        ds >> program;
+        output->programs.append(QQmlCompiledData::V8Program(program, output));
+    }
+
+    qint32 fixupCount = 0;
+    QByteArray fixupData;
+    ds >> output->bytecode >> output->datas >> fixupCount >> fixupData;
+    if (ds.status() != QDataStream::Ok)
+        return false;
+
+    if (!decodeInstructions() || !applyFixups(fixupCount, fixupData))
+        return false;
+
+    if (rootCache != -1) {
+        enginePrivate->registerInternalCompositeType(output);
+    } else if (output->types.at(rootType).component) {
+        output->metaTypeId = output->types.at(rootType).component->metaTypeId;
+        output->listMetaTypeId = output->types.at(rootType).component->listMetaTypeId;
+    } else {
+        output->metaTypeId = output->types.at(rootType).type->typeId();
+        output->listMetaTypeId = output->types.at(rootType).type->qListTypeId();
+    }
+
+    return true;
+}
+
+bool QQmlDiskCache::Reader::readMetaType(QDataStream &ds, int *type)
+{
+    quint8 kind = 0;
+    ds >> kind;
+
+    switch (kind) {
+    case BuiltinMetaType: {
+        qint32 id;
+        ds >> id;
+        *type = id;
+        return true;
+    }
+    case NamedMetaType: {
+        QByteArray name;
+        ds >> name;
+        *type = QMetaType::type(name.constData());
+        return *type != QMetaType::UnknownType;
+    }
+    case CompositeMetaType:
+    case CompositeListMetaType: {
+        qint32 index;
+        ds >> index;
+        if (index < 0 || index >= output->types.count() || !output->types.at(index).component)
+            return false;
+        QQmlCompiledData *component = output->types.at(index).component;
+        *type = kind == CompositeMetaType ? component->metaTypeId : component->listMetaTypeId;
+        return *type != -1;
+    }
+    default:
+        return false;
+    }
+}
+
+QQmlPropertyCache *QQmlDiskCache::Reader::readPropertyCache(QDataStream &ds)
+{
+    qint32 parent;
+    QByteArray className;
+    QString defaultPropertyName;
+    qint32 propertyCount;
+    qint32 methodCount;
+    qint32 signalCount;
+    ds >> parent >> className >> defaultPropertyName >> propertyCount >> methodCount >> signalCount;
+    if (ds.status() != QDataStream::Ok || parent < 0 || parent >= output->types.count())
+        return 0;
+
+    QQmlPropertyCache *parentCache = output->types[parent].createPropertyCache(engine);
+    QQmlPropertyCache *cache = parentCache->copyAndReserve(engine, propertyCount, methodCount,
+                                                           signalCount);
+    cache->_dynamicClassName = className + QByteArray::number(QQmlCompiler::nextClassIndex());
+    cache->_defaultPropertyName = defaultPropertyName;
+
+    bool ok = true;
+    for (int ii = 0; ok && ii < methodCount; ++ii) {
+        QString name;
+        quint32 flags;
+        qint32 coreIndex;
+        QList<QByteArray> parameterNames;
+        ds >> name >> flags >> coreIndex >> parameterNames;
+
+        if (!(flags & QQmlPropertyData::IsSignal)) {
+            cache->appendMethod(name, flags, coreIndex, parameterNames);
+        } else if (!(flags & QQmlPropertyData::HasArguments)) {
+            cache->appendSignal(name, flags, coreIndex);
+        } else {
+            qint32 parameterCount = 0;
+            ds >> parameterCount;
+            QVarLengthArray<int, 10> parameterTypes(parameterCount + 1);
+            parameterTypes[0] = parameterCount;
+            for (int jj = 0; ok && jj < parameterCount; ++jj)
+                ok = readMetaType(ds, &parameterTypes[jj + 1]);
+            if (ok)
+                cache->appendSignal(name, flags, coreIndex, parameterTypes.constData(), parameterNames);
+        }
+
+        ok = ok && ds.status() == QDataStream::Ok;
+    }
+
+    for (int ii = 0; ok && ii < propertyCount; ++ii) {
+        QString name;
+        quint32 flags;
+        qint32 coreIndex;
+        qint32 notifyIndex;
+        int propType;
+        ds >> name >> flags >> coreIndex >> notifyIndex;
+        ok = readMetaType(ds, &propType) && ds.status() == QDataStream::Ok;
+        if (ok)
+            cache->appendProperty(name, flags, coreIndex, propType, notifyIndex);
+    }
+
+    if (!ok) {
+        cache->release();
+        return 0;
+    }
+
+    return cache;
+}
+
+bool QQmlDiskCache::Reader::decodeInstructions()
+{
+    char *code = output->bytecode.data();
+    const char *end = code + output->bytecode.size();
+
+    while (code < end) {
+        QQmlInstruction *instr = reinterpret_cast<QQmlInstruction *>(code);
+
+#ifdef QML_THREADED_VME_INTERPRETER
+        quintptr typeId = reinterpret_cast<quintptr>(instr->common.code);
+#else
+        quintptr typeId = instr->common.instructionType;
+#endif
+        if (typeId >= quintptr(qmlInstructionCount))
+            return false;
+        QQmlInstruction::Type type = static_cast<QQmlInstruction::Type>(typeId);
+
+#ifdef QML_THREADED_VME_INTERPRETER
+        instr->common.code = QQmlVME::instructionJumpTable()[typeId];
+#endif
+
+        if (type == QQmlInstruction::CreateSimpleObject) {
+            int index = instr->createSimple.type;
+            if (index < 0 || index >= output->types.count() || !output->types.at(index).type)
+                return false;
+            instr->createSimple.create = output->types.at(index).type->createFunction();
+            instr->createSimple.typeSize = output->types.at(index).type->createSize();
+        } else if (type == QQmlInstruction::CreateSimpleObjectAndBegin) {
+            int index = instr->createSimpleAndBegin.type;
+            if (index < 0 || index >= output->types.count() || !output->types.at(index).type)
+                return false;
+            instr->createSimpleAndBegin.create = output->types.at(index).type->createFunction();
+            instr->createSimpleAndBegin.typeSize = output->types.at(index).type->createSize();
+        } else if (type == QQmlInstruction::Init) {
+            if (instr->init.compiledBinding != -1 && !decodeV4Program(instr->init.compiledBinding))
+                return false;
+        }
+
+        code += QQmlInstruction::size(type);
+    }
+
+    return code == end;
+}
+
+bool QQmlDiskCache::Reader::decodeV4Program(qint32 index)
+{
+    if (decodedDatas.contains(index))
+        return true;
+    decodedDatas.insert(index);
+
+    if (index < 0 || index >= output->datas.count())
+        return false;
+
+    QByteArray &programData = output->datas[index];
+    if (programData.size() < int(sizeof(QV4Program)))
+        return false;
+
+    QV4Program *program = reinterpret_cast<QV4Program *>(programData.data());
+    if (int(sizeof(QV4Program) + program->dataLength + program->instructionCount) > programData.size())
+        return false;
+
+    char *code = const_cast<char *>(program->instructions());
+    const char *end = code + program->instructionCount;
+
+    while (code < end) {
+        V4Instr *instr = reinterpret_cast<V4Instr *>(code);
+
+#ifdef QML_THREADED_INTERPRETER
+        quintptr typeId = reinterpret_cast<quintptr>(instr->common.code);
+#else
+        quintptr typeId = instr->common.type;
+#endif
+        if (typeId >= quintptr(qmlV4InstructionCount))
+            return false;
+
+#ifdef QML_THREADED_INTERPRETER
+        instr->common.code = QV4Bindings::getDecodeInstrTable()[typeId];
+#endif
+
+        code += V4Instr::size(static_cast<V4Instr::Type>(typeId));
+    }
+
+    return code == end;
+}
+
+bool QQmlDiskCache::Reader::applyFixups(int count, const QByteArray &fixupData)
+{
+    QDataStream ds(fixupData);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    for (int ii = 0; ii < count; ++ii) {
+        quint8 kind = 0;
+        qint32 section = 0;
+        qint32 offset = 0;
+        ds >> kind >> section >> offset;
+
+        char *base = 0;
+        int size = 0;
+        if (section == BytecodeSection) {
+            base = output->bytecode.data();
+            size = output->bytecode.size();
+        } else if (section >= 0 && section < output->datas.count()) {
+            base = output->datas[section].data();
+            size = output->datas.at(section).size();
+        }
+
+        if (!base || offset < 0)
+            return false;
+
+        switch (kind) {
+        case MetaTypeFixup: {
+            int type;
+            if (!readMetaType(ds, &type) || offset + int(sizeof(int)) > size)
+                return false;
+            *reinterpret_cast<int *>(base + offset) = type;
+            break;
+        }
+        case AttachedPropertiesFixup: {
+            QString name;
+            qint32 majorVersion;
+            qint32 minorVersion;
+            ds >> name >> majorVersion >> minorVersion;
+
+            QQmlType *type = QQmlMetaType::qmlType(name, majorVersion, minorVersion);
+            if (!type || !type->attachedPropertiesFunction() || offset + int(sizeof(int)) > size)
+                return false;
+            *reinterpret_cast<int *>(base + offset) = type->attachedPropertiesId();
+            break;
+        }
+        case AccessorsFixup: {
+            QByteArray className;
+            QByteArray propertyName;
+            ds >> className >> propertyName;
+
+            QQmlAccessorProperties::Property *accessor =
+                QQmlAccessorProperties::findProperty(className, propertyName);
+            if (!accessor || offset + int(sizeof(QQmlPropertyRawData)) > size)
+                return false;
+
+            QQmlPropertyRawData *property = reinterpret_cast<QQmlPropertyRawData *>(base + offset);
+            property->accessors = accessor->accessors;
+            property->accessorData = accessor->data;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+
+    return ds.status() == QDataStream::Ok;
+}
+
+QT_END_NAMESPACE
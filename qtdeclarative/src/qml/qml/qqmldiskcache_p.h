@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLDISKCACHE_P_H
+#define QQMLDISKCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qqmlscript_p.h>
+#include <private/qtqmlglobal_p.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qurl.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQmlEngine;
+class QQmlError;
+class QQmlTypeData;
+class QQmlCompiledData;
+class QQmlPropertyCache;
+
+// QQmlDiskCache persists the QQmlCompiledData produced for a QML file, so that
+// subsequent runs can skip both parsing and compilation.  A cache file is only
+// used if both the SHA1 of the QML source and the build id of the QtQml library
+// match those it was written with.
+//
+// The cache is split in two sections.  The first contains the imports and type
+// references of the document - the information QQmlTypeData needs to resolve the
+// document's dependencies in place of the parser.  The second section is the
+// compiled data itself, which can only be restored once all dependencies are
+// complete.  As instruction streams contain process specific values (interpreter
+// jump addresses, function pointers, meta type ids and attached property ids)
+// these are written in a position independent form and fixed up on restore.
+//
+// The cache is enabled by setting QML_DISK_CACHE.  Cache files are written next
+// to local QML files, with a "c" suffix (Foo.qml -> Foo.qmlc), or into the
+// directory named by QML_DISK_CACHE_PATH if it is set.
+//
+// The same format is used for the "qml:compiled" meta data that qmlcompile adds
+// to QQmlBundle entries.  These precompiled entries are used whether or not
+// the cache is enabled.
+//
+// If QML_SHARE_COMPILED_DATA is set, units are also kept in memory, so that other
+// engines in the same process loading the same document restore it rather than
+// parsing and compiling it again.  A unit is dropped when the last compiled
+// data using it is destroyed.  Property caches, type references and V8
+// state are engine specific and are rebuilt by each engine on restore.
+class Q_QML_PRIVATE_EXPORT QQmlDiskCache
+{
+public:
+    class Q_QML_PRIVATE_EXPORT Unit
+    {
+    public:
+        ~Unit();
+
+        QList<QQmlScript::Import> imports;
+        QStringList typeNames;
+        QList<QQmlScript::Location> typeLocations;
+
+    private:
+        friend class QQmlDiskCache;
+        Unit();
+        Q_DISABLE_COPY(Unit)
+
+        QFile file;
+        QByteArray buffer;
+        QByteArray sharedSourceHash; // Set for units returned by loadShared()
+        const char *data;
+        int size;
+        int compiledDataOffset;
+    };
+
+    static bool isEnabled();
+    static void setEnabled(bool);
+
+    static bool isSharingEnabled();
+    static void setSharingEnabled(bool);
+
+    static QString cacheDirectory();
+    static void setCacheDirectory(const QString &);
+
+    static QString cacheFilePath(const QUrl &);
+    static QByteArray sourceHash(const char *data, int size);
+    static QByteArray buildId();
+
+    static Unit *load(const QUrl &, const QByteArray &sourceHash);
+    static Unit *load(const QByteArray &, const QByteArray &sourceHash);
+    static Unit *loadShared(const QUrl &, const QByteArray &sourceHash);
+    static bool restore(QQmlTypeData *, const Unit *, QQmlCompiledData *);
+
+    static QByteArray serialize(QQmlTypeData *, QQmlCompiledData *, const QByteArray &sourceHash);
+    static bool save(QQmlTypeData *, QQmlCompiledData *, const QByteArray &sourceHash);
+    static bool share(QQmlTypeData *, QQmlCompiledData *, const QByteArray &sourceHash);
+    static void releaseShared(QQmlCompiledData *);
+    static void clearShared();
+
+    static QByteArray precompile(QQmlEngine *, const QUrl &, const QByteArray &source,
+                                 QList<QQmlError> *errors);
+
+private:
+    class Writer;
+    class Reader;
+
+    static bool readUnit(Unit *, const QByteArray &sourceHash);
+    static void acquireShared(QQmlCompiledData *, const QByteArray &sourceHash);
+    static quint32 fingerprint(QQmlPropertyCache *);
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLDISKCACHE_P_H
@@ -69,6 +69,7 @@
 #include "qqmlabstracturlinterceptor_p.h"
 #include <private/qv8profilerservice_p.h>
 #include <private/qqmlboundsignal_p.h>
+#include <private/qqmlvaluetypeproxybinding_p.h>
 
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qsettings.h>
@@ -80,6 +81,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qthreadstorage.h>
 #include <private/qthread_p.h>
 #include <QtNetwork/qnetworkconfigmanager.h>
 
@@ -1402,6 +1404,10 @@ public:
     ~QQmlDataExtended();
 
     QHash<int, QObject *> attachedProperties;
+    // Encoded property indices of bindings marked dirty while suspended or queued
+    QVector<int> dirtyBindings;
+    // Bindings being run from the dirty list, innermost last
+    QVector<int> runningBindings;
 };
 
 QQmlDataExtended::QQmlDataExtended()
@@ -1516,6 +1522,224 @@ QHash<int, QObject *> *QQmlData::attachedProperties() const
     return &extendedData->attachedProperties;
 }
 
+static QQmlAbstractBinding *QQmlData_findBinding(QQmlAbstractBinding *b, int propertyIndex)
+{
+    int coreIndex = propertyIndex & 0x0000FFFF;
+    while (b && b->propertyIndex() != coreIndex)
+        b = b->nextBinding();
+
+    if (b && propertyIndex != coreIndex) {
+        if (b->bindingType() != QQmlAbstractBinding::ValueTypeProxy)
+            return 0;
+        b = static_cast<QQmlValueTypeProxyBinding *>(b)->binding(propertyIndex);
+    }
+    return b;
+}
+
+/*
+Returns false if the binding was already dirty.
+*/
+bool QQmlData::markBindingDirty(QQmlAbstractBinding *binding)
+{
+    if (!extendedData) extendedData = new QQmlDataExtended;
+
+    int propertyIndex = binding->propertyIndex();
+    // A binding may be notified of inputs it brings up to date itself while it runs
+    if (extendedData->dirtyBindings.contains(propertyIndex)
+            || extendedData->runningBindings.contains(propertyIndex))
+        return false;
+
+    extendedData->dirtyBindings.append(propertyIndex);
+    hasDirtyBindings = true;
+    return true;
+}
+
+DEFINE_BOOL_CONFIG_OPTION(qmlCoalesceBindings, QML_COALESCE_BINDINGS);
+
+// Set by setBindingCoalescingEnabled(), or -1 to use QML_COALESCE_BINDINGS
+static QBasicAtomicInt coalesceBindingsOverride = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+/*!
+Returns true if binding evaluations are coalesced per event loop iteration.  This
+is controlled by the QML_COALESCE_BINDINGS environment variable, unless overridden
+by setBindingCoalescingEnabled().
+*/
+bool QQmlData::isBindingCoalescingEnabled()
+{
+    int enabled = coalesceBindingsOverride.load();
+    return enabled == -1 ? qmlCoalesceBindings() : enabled;
+}
+
+void QQmlData::setBindingCoalescingEnabled(bool enabled)
+{
+    coalesceBindingsOverride.store(enabled);
+}
+
+/*
+The objects with bindings waiting to be evaluated on this thread.  The queue is
+flushed from QQuickWindowPrivate::polishItems() before a frame is prepared, or
+from a posted event if no frame is rendered in this event loop iteration.
+*/
+class QQmlBindingQueue : public QObject
+{
+public:
+    QQmlBindingQueue() : flushPosted(false), coalesced(0) {}
+
+    static QQmlBindingQueue *instance();
+
+    void append(QObject *);
+    void flush();
+
+    virtual bool event(QEvent *);
+
+    QVector<QPointer<QObject> > objects;
+    bool flushPosted;
+    // Notifications to bindings that were already queued
+    int coalesced;
+};
+
+static QThreadStorage<QQmlBindingQueue *> qmlBindingQueues;
+
+QQmlBindingQueue *QQmlBindingQueue::instance()
+{
+    if (!qmlBindingQueues.hasLocalData())
+        qmlBindingQueues.setLocalData(new QQmlBindingQueue);
+    return qmlBindingQueues.localData();
+}
+
+void QQmlBindingQueue::append(QObject *object)
+{
+    objects.append(object);
+    if (!flushPosted) {
+        flushPosted = true;
+        QCoreApplication::postEvent(this, new QEvent(QEvent::User));
+    }
+}
+
+void QQmlBindingQueue::flush()
+{
+    int evaluated = 0;
+    int maxFlushCycles = 1000;
+
+    // Evaluating a binding may queue further bindings, which are then run in
+    // the next cycle, so that each binding sees the final value of its inputs.
+    while (!objects.isEmpty() && --maxFlushCycles > 0) {
+        QVector<QPointer<QObject> > pending;
+        qSwap(pending, objects);
+
+        for (int ii = 0; ii < pending.count(); ++ii) {
+            QObject *object = pending.at(ii);
+            QQmlData *ddata = object ? QQmlData::get(object) : 0;
+            if (!ddata)
+                continue;
+            ddata->bindingsQueued = false;
+            if (ddata->hasDirtyBindings && !ddata->bindingsSuspended)
+                evaluated += ddata->flushDirtyBindings();
+        }
+    }
+
+    if (maxFlushCycles == 0)
+        qWarning("QQmlEngine: possible binding loop while flushing coalesced bindings");
+
+    if (evaluated || coalesced)
+        QQmlProfilerService::bindingsCoalesced(evaluated, coalesced);
+    coalesced = 0;
+}
+
+bool QQmlBindingQueue::event(QEvent *e)
+{
+    if (e->type() == QEvent::User) {
+        flushPosted = false;
+        flush();
+        return true;
+    }
+    return QObject::event(e);
+}
+
+void QQmlData::queueBinding(QObject *object, QQmlAbstractBinding *binding)
+{
+    QQmlBindingQueue *queue = QQmlBindingQueue::instance();
+    if (!markBindingDirty(binding))
+        ++queue->coalesced;
+
+    if (!bindingsQueued) {
+        bindingsQueued = true;
+        queue->append(object);
+    }
+}
+
+/*!
+Evaluates the bindings queued on this thread while QML_COALESCE_BINDINGS is set.
+*/
+void QQmlData::flushQueuedBindings()
+{
+    if (isBindingCoalescingEnabled() && qmlBindingQueues.hasLocalData())
+        qmlBindingQueues.localData()->flush();
+}
+
+/*
+Removes \a propertyIndex from the dirty list and runs its binding.  Returns false
+if the binding was not dirty.
+*/
+bool QQmlData::runDirtyBinding(int propertyIndex)
+{
+    QVector<int> &dirty = extendedData->dirtyBindings;
+    int index = dirty.indexOf(propertyIndex);
+    if (index == -1)
+        return false;
+    dirty.remove(index);
+    hasDirtyBindings = !dirty.isEmpty();
+
+    QQmlAbstractBinding *b = QQmlData_findBinding(bindings, propertyIndex);
+    if (!b)
+        return false;
+
+    extendedData->runningBindings.append(propertyIndex);
+    b->update(QQmlPropertyPrivate::DontRemoveBinding);
+    extendedData->runningBindings.removeLast();
+    return true;
+}
+
+void QQmlData::flushDirtyBindingImpl(int coreIndex)
+{
+    const QVector<int> dirty = extendedData->dirtyBindings;
+    for (int ii = 0; ii < dirty.count(); ++ii) {
+        if ((dirty.at(ii) & 0x0000FFFF) == coreIndex)
+            runDirtyBinding(dirty.at(ii));
+    }
+}
+
+/*
+Bindings stay in the dirty list until they run, so a binding that reads a property
+whose binding is still dirty runs that binding first (see flushPendingBinding()).
+This evaluates bindings on the same object in dependency order.  Bindings that
+become dirty while flushing are left for the next flush.
+*/
+int QQmlData::flushDirtyBindings()
+{
+    const QVector<int> dirty = extendedData->dirtyBindings;
+    int count = 0;
+    for (int ii = 0; ii < dirty.count(); ++ii) {
+        if (runDirtyBinding(dirty.at(ii)))
+            ++count;
+    }
+    return count;
+}
+
+/*!
+Suspends or resumes evaluation of the bindings on this object.  Bindings that
+were marked dirty while suspended are re-evaluated on resume.
+*/
+void QQmlData::setBindingsSuspended(bool suspended)
+{
+    if (bindingsSuspended == suspended)
+        return;
+
+    bindingsSuspended = suspended;
+    if (!suspended && hasDirtyBindings)
+        flushDirtyBindings();
+}
+
 void QQmlData::destroyed(QObject *object)
 {
     if (nextContextObject)
@@ -2173,6 +2397,12 @@ QQmlPropertyCache *QQmlEnginePrivate::rawPropertyCacheForType(int t)
     }
 }
 
+bool QQmlEnginePrivate::isInternalCompositeType(int t) const
+{
+    Locker locker(this);
+    return m_compositeTypes.contains(t) || m_qmlLists.contains(t);
+}
+
 void QQmlEnginePrivate::registerInternalCompositeType(QQmlCompiledData *data)
 {
     QByteArray name = data->rootPropertyCache->className();
@@ -67,6 +67,7 @@
 #include "qqmlpropertycache_p.h"
 #include "qqmlmetatype_p.h"
 #include "qqmldirparser_p.h"
+#include "qqmlstringtable_p.h"
 #include <private/qintrusivelist_p.h>
 #include <private/qrecyclepool_p.h>
 
@@ -197,6 +198,7 @@ public:
 
     QQmlImportDatabase importDatabase;
     QQmlTypeLoader typeLoader;
+    QQmlStringTable stringTable;
 
     QString offlineStoragePath;
 
@@ -240,6 +242,7 @@ public:
     QQmlMetaObject metaObjectForType(int) const;
     QQmlPropertyCache *propertyCacheForType(int);
     QQmlPropertyCache *rawPropertyCacheForType(int);
+    bool isInternalCompositeType(int) const;
     void registerInternalCompositeType(QQmlCompiledData *);
     void unregisterInternalCompositeType(QQmlCompiledData *);
 
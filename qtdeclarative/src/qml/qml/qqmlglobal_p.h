@@ -64,6 +64,19 @@ QT_BEGIN_NAMESPACE
         return status == Yes; \
     }
 
+// Returns the positive integer set in the environment variable \a var, or 0.
+#define DEFINE_INT_CONFIG_OPTION(name, var) \
+    static int name() \
+    { \
+        static int value = -1; \
+        if (value == -1) { \
+            bool ok = false; \
+            int v = qgetenv(#var).toInt(&ok); \
+            value = (ok && v > 0) ? v : 0; \
+        } \
+        return value; \
+    }
+
 /*!
     Connect \a Signal of \a Sender to \a Method of \a Receiver.  \a Signal must be
     of type \a SenderType and \a Receiver of type \a ReceiverType.
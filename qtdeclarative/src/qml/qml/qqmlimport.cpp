@@ -754,8 +754,15 @@ bool QQmlImportsPrivate::importExtension(const QString &qmldirFilePath,
             qmldirPath.truncate(slash);
 
         foreach (const QQmlDirParser::Plugin &plugin, qmldir->plugins()) {
-            QString resolvedFilePath = database->resolvePlugin(typeLoader, qmldirPath,
-                                                               plugin.path, plugin.name);
+            QString resolvedFilePath = database->importIndex.findPlugin(qmldirPath, plugin.path,
+                                                                        plugin.name);
+            if (resolvedFilePath.isEmpty()) {
+                resolvedFilePath = database->resolvePlugin(typeLoader, qmldirPath,
+                                                           plugin.path, plugin.name);
+                if (!resolvedFilePath.isEmpty())
+                    database->importIndex.addPlugin(qmldirPath, plugin.path, plugin.name,
+                                                    resolvedFilePath);
+            }
             if (!resolvedFilePath.isEmpty()) {
                 if (!database->importPlugin(resolvedFilePath, uri, qmldir->typeNamespace(), errors)) {
                     if (errors) {
@@ -886,7 +893,28 @@ bool QQmlImportsPrivate::locateQmldir(const QString &uri, int vmaj, int vmin, QQ
 
     QStringList localImportPaths = database->importPathList(QQmlImportDatabase::Local);
 
+    // Check the persistent index next, as searching the import paths means stat()ing
+    // a candidate qmldir in every path for each of the versioned locations
+    QString indexedContent;
+    database->importIndex.setSearchPaths(localImportPaths, database->filePluginPath);
+    if (database->importIndex.findModule(uri, vmaj, vmin, outQmldirFilePath, outQmldirPathUrl,
+                                         &indexedContent)) {
+        if (!indexedContent.isEmpty())
+            typeLoader.setQmldirContent(*outQmldirFilePath, indexedContent);
+
+        QQmlImportDatabase::QmldirCache *cache = new QQmlImportDatabase::QmldirCache;
+        cache->versionMajor = vmaj;
+        cache->versionMinor = vmin;
+        cache->qmldirFilePath = *outQmldirFilePath;
+        cache->qmldirPathUrl = *outQmldirPathUrl;
+        cache->next = cacheHead;
+        database->qmldirCache.insert(uri, cache);
+
+        return true;
+    }
+
     // Search local import paths for a matching version
+    QStringList precedingQmldirPaths;
     for (int version = QQmlImports::FullyVersioned; version <= QQmlImports::Unversioned; ++version) {
         foreach (const QString &path, localImportPaths) {
             QString qmldirPath = QQmlImports::completeQmldirPath(uri, path, vmaj, vmin, static_cast<QQmlImports::ImportVersion>(version));
@@ -907,12 +935,15 @@ bool QQmlImportsPrivate::locateQmldir(const QString &uri, int vmaj, int vmin, QQ
                 cache->qmldirPathUrl = url;
                 cache->next = cacheHead;
                 database->qmldirCache.insert(uri, cache);
+                database->importIndex.addModule(uri, vmaj, vmin, absoluteFilePath, url,
+                                                precedingQmldirPaths);
 
                 *outQmldirFilePath = absoluteFilePath;
                 *outQmldirPathUrl = url;
 
                 return true;
             }
+            precedingQmldirPaths.append(qmldirPath);
         }
     }
 
@@ -1379,6 +1410,7 @@ QQmlImportDatabase::QQmlImportDatabase(QQmlEngine *e)
 
 QQmlImportDatabase::~QQmlImportDatabase()
 {
+    importIndex.save();
     qDeleteAll(qmldirCache);
     qmldirCache.clear();
 }
@@ -46,6 +46,7 @@
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstringlist.h>
+#include <private/qqmlimportindex_p.h>
 #include <private/qqmldirparser_p.h>
 #include <private/qqmlscript_p.h>
 #include <private/qqmlmetatype_p.h>
@@ -173,6 +174,9 @@ private:
     // Used in QQmlImportsPrivate::locateQmldir()
     QStringHash<QmldirCache *> qmldirCache;
 
+    // Persists qmldirCache and resolved plugins across runs, if enabled
+    QQmlImportIndex importIndex;
+
     // XXX thread
     QStringList filePluginPath;
     QStringList fileImportPath;
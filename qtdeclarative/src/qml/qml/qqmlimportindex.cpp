@@ -0,0 +1,463 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qqmlimportindex_p.h"
+
+#include <private/qqmldiskcache_p.h>
+#include <private/qqmlbundle_p.h>
+#include <private/qqmlglobal_p.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdebug.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtQml/qqmlfile.h>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(importIndexEnabled, QML_IMPORT_INDEX);
+DEFINE_BOOL_CONFIG_OPTION(qmlImportTrace, QML_IMPORT_TRACE);
+
+// Increase whenever the layout of the index file changes
+static const quint32 qmliMagic = 0x514d4c49; // "QMLI"
+static const quint32 qmliVersion = 2;
+
+namespace {
+
+struct ImportIndexSettings
+{
+    ImportIndexSettings() : enabled(-1) {}
+
+    QMutex mutex;
+    int enabled;
+};
+
+}
+
+Q_GLOBAL_STATIC(ImportIndexSettings, importIndexSettings)
+
+static qint64 modificationTime(const QString &path)
+{
+    QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+// Returns the deepest existing directory on the way to \a qmldirFilePath.  A qmldir
+// file appearing there changes the modification time of that directory.
+static QString watchedDirectory(const QString &qmldirFilePath)
+{
+    QString directory = QDir::cleanPath(QFileInfo(qmldirFilePath).absolutePath());
+    while (!QFileInfo(directory).isDir()) {
+        int index = directory.lastIndexOf(QLatin1Char('/'));
+        if (index <= 0)
+            return QString();
+        directory.truncate(index);
+    }
+    return directory;
+}
+
+static QList<qint64> importPathsModified(const QStringList &importPaths)
+{
+    QList<qint64> rv;
+    foreach (const QString &path, importPaths) {
+        // Resources cannot change while the application binary stays the same
+        if (path.startsWith(QLatin1Char(':')) || path.startsWith(QLatin1String("qrc:"), Qt::CaseInsensitive))
+            rv.append(0);
+        else
+            rv.append(modificationTime(path));
+    }
+    return rv;
+}
+
+static QString moduleKey(const QString &uri, int vmaj, int vmin)
+{
+    return uri + QLatin1Char(' ') + QString::number(vmaj) + QLatin1Char('.') + QString::number(vmin);
+}
+
+static QString pluginKey(const QString &qmldirPath, const QString &qmldirPluginPath, const QString &name)
+{
+    return qmldirPath + QLatin1Char('\n') + qmldirPluginPath + QLatin1Char('\n') + name;
+}
+
+QQmlImportIndex::QQmlImportIndex()
+: m_initialized(false), m_dirty(false)
+{
+}
+
+QQmlImportIndex::~QQmlImportIndex()
+{
+}
+
+/*!
+    Returns true if import lookups should be persisted.  This is controlled by the
+    QML_IMPORT_INDEX environment variable, unless overridden by setEnabled().
+*/
+bool QQmlImportIndex::isEnabled()
+{
+    ImportIndexSettings *settings = importIndexSettings();
+    QMutexLocker locker(&settings->mutex);
+    if (settings->enabled == -1)
+        settings->enabled = importIndexEnabled();
+    return settings->enabled;
+}
+
+void QQmlImportIndex::setEnabled(bool enabled)
+{
+    ImportIndexSettings *settings = importIndexSettings();
+    QMutexLocker locker(&settings->mutex);
+    settings->enabled = enabled;
+}
+
+/*!
+    Selects the index for \a importPaths and \a pluginPaths, loading it from disk
+    if necessary.  The previously selected index is saved first.
+*/
+void QQmlImportIndex::setSearchPaths(const QStringList &importPaths, const QStringList &pluginPaths)
+{
+    if (m_initialized && importPaths == m_importPaths && pluginPaths == m_pluginPaths)
+        return;
+
+    if (m_initialized)
+        save();
+    clear();
+
+    if (!isEnabled())
+        return;
+
+    m_importPaths = importPaths;
+    m_pluginPaths = pluginPaths;
+    m_importPathsModified = importPathsModified(importPaths);
+    m_initialized = true;
+
+    load();
+}
+
+/*!
+    Looks up the qmldir file of module \a uri version \a vmaj.vmin.  Returns false
+    if the module is not in the index, or has changed since it was indexed.
+
+    \a content is set to the content of the qmldir file, or an empty string if the
+    index does not hold it.
+*/
+bool QQmlImportIndex::findModule(const QString &uri, int vmaj, int vmin,
+                                 QString *qmldirFilePath, QString *qmldirPathUrl, QString *content)
+{
+    if (!m_initialized)
+        return false;
+
+    QHash<QString, Module>::Iterator it = m_modules.find(moduleKey(uri, vmaj, vmin));
+    if (it == m_modules.end())
+        return false;
+
+    if (!it->validated) {
+        QFileInfo info(it->qmldirFilePath);
+        bool changed = !info.isFile() || info.lastModified().toMSecsSinceEpoch() != it->modified
+                || info.size() != it->size;
+        for (int ii = 0; !changed && ii < it->watchedDirectories.count(); ++ii)
+            changed = modificationTime(it->watchedDirectories.at(ii)) != it->watchedModified.at(ii);
+        if (changed) {
+            if (qmlImportTrace())
+                qDebug().nospace() << "QQmlImportIndex::findModule: " << uri << ' ' << vmaj << '.' << vmin
+                                   << " changed since it was indexed";
+            m_modules.erase(it);
+            m_dirty = true;
+            return false;
+        }
+        it->validated = true;
+    }
+
+    *qmldirFilePath = it->qmldirFilePath;
+    *qmldirPathUrl = it->qmldirPathUrl;
+    *content = it->content;
+    return true;
+}
+
+/*!
+    Records that module \a uri version \a vmaj.vmin was found at \a qmldirFilePath,
+    after the search tried each of \a precedingQmldirPaths.  Modules in resources
+    or bundles are not indexed.
+*/
+void QQmlImportIndex::addModule(const QString &uri, int vmaj, int vmin,
+                                const QString &qmldirFilePath, const QString &qmldirPathUrl,
+                                const QStringList &precedingQmldirPaths)
+{
+    if (!m_initialized || qmldirFilePath.startsWith(QLatin1Char(':')) || QQmlFile::isBundle(qmldirFilePath))
+        return;
+
+    QFileInfo info(qmldirFilePath);
+    if (!info.isFile())
+        return;
+
+    Module module;
+    module.qmldirFilePath = qmldirFilePath;
+    module.qmldirPathUrl = qmldirPathUrl;
+    module.modified = info.lastModified().toMSecsSinceEpoch();
+    module.size = info.size();
+    foreach (const QString &path, precedingQmldirPaths) {
+        // Resources cannot change while the application binary stays the same
+        if (path.startsWith(QLatin1Char(':')))
+            continue;
+
+        QString directory = watchedDirectory(path);
+        if (directory.isEmpty() || module.watchedDirectories.contains(directory))
+            continue;
+        module.watchedDirectories.append(directory);
+        module.watchedModified.append(modificationTime(directory));
+    }
+    module.validated = true;
+
+    m_modules.insert(moduleKey(uri, vmaj, vmin), module);
+    m_dirty = true;
+}
+
+/*!
+    Returns the plugin file previously resolved for plugin \a name of the qmldir in
+    \a qmldirPath, or an empty string if there is none or it has changed since.
+*/
+QString QQmlImportIndex::findPlugin(const QString &qmldirPath, const QString &qmldirPluginPath,
+                                    const QString &name)
+{
+    if (!m_initialized)
+        return QString();
+
+    QHash<QString, Plugin>::Iterator it = m_plugins.find(pluginKey(qmldirPath, qmldirPluginPath, name));
+    if (it == m_plugins.end())
+        return QString();
+
+    if (!it->validated) {
+        if (modificationTime(it->filePath) != it->modified) {
+            m_plugins.erase(it);
+            m_dirty = true;
+            return QString();
+        }
+        it->validated = true;
+    }
+
+    return it->filePath;
+}
+
+void QQmlImportIndex::addPlugin(const QString &qmldirPath, const QString &qmldirPluginPath,
+                                const QString &name, const QString &filePath)
+{
+    if (!m_initialized || filePath.startsWith(QLatin1Char(':')))
+        return;
+
+    Plugin plugin;
+    plugin.filePath = filePath;
+    plugin.modified = modificationTime(filePath);
+    plugin.validated = true;
+    if (plugin.modified == -1)
+        return;
+
+    m_plugins.insert(pluginKey(qmldirPath, qmldirPluginPath, name), plugin);
+    m_dirty = true;
+}
+
+/*!
+    Returns the file the index for the current search paths is stored in, or an
+    empty string if there is no writable location.
+*/
+QString QQmlImportIndex::indexFilePath() const
+{
+    QString directory = QQmlDiskCache::cacheDirectory();
+    if (directory.isEmpty())
+        directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (directory.isEmpty())
+        return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    foreach (const QString &path, m_importPaths) {
+        hash.addData(path.toUtf8());
+        hash.addData("\n", 1);
+    }
+    hash.addData("\0", 1);
+    foreach (const QString &path, m_pluginPaths) {
+        hash.addData(path.toUtf8());
+        hash.addData("\n", 1);
+    }
+
+    return directory + QLatin1String("/imports-") + QString::fromLatin1(hash.result().toHex())
+            + QLatin1String(".qmli");
+}
+
+void QQmlImportIndex::load()
+{
+    QString fileName = indexFilePath();
+    if (fileName.isEmpty())
+        return;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream ds(&file);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, version;
+    ds >> magic >> version;
+    if (ds.status() != QDataStream::Ok || magic != qmliMagic || version != qmliVersion)
+        return;
+
+    QByteArray buildId;
+    QStringList importPaths;
+    QStringList pluginPaths;
+    QList<qint64> modified;
+    ds >> buildId >> importPaths >> pluginPaths >> modified;
+    if (ds.status() != QDataStream::Ok || buildId != QQmlDiskCache::buildId()
+            || importPaths != m_importPaths || pluginPaths != m_pluginPaths
+            || modified != m_importPathsModified) {
+        if (qmlImportTrace())
+            qDebug().nospace() << "QQmlImportIndex::load: discarding outdated index " << fileName;
+        return;
+    }
+
+    qint32 moduleCount;
+    ds >> moduleCount;
+    for (qint32 ii = 0; ds.status() == QDataStream::Ok && ii < moduleCount; ++ii) {
+        QString key;
+        Module module;
+        ds >> key >> module.qmldirFilePath >> module.qmldirPathUrl >> module.content
+           >> module.modified >> module.size >> module.watchedDirectories >> module.watchedModified;
+        if (module.watchedDirectories.count() != module.watchedModified.count())
+            ds.setStatus(QDataStream::ReadCorruptData);
+        m_modules.insert(key, module);
+    }
+
+    qint32 pluginCount;
+    ds >> pluginCount;
+    for (qint32 ii = 0; ds.status() == QDataStream::Ok && ii < pluginCount; ++ii) {
+        QString key;
+        Plugin plugin;
+        ds >> key >> plugin.filePath >> plugin.modified;
+        m_plugins.insert(key, plugin);
+    }
+
+    if (ds.status() != QDataStream::Ok) {
+        m_modules.clear();
+        m_plugins.clear();
+        return;
+    }
+
+    if (qmlImportTrace())
+        qDebug().nospace() << "QQmlImportIndex::load: " << m_modules.count() << " modules and "
+                           << m_plugins.count() << " plugins from " << fileName;
+}
+
+/*!
+    Writes the index to disk if it changed since it was loaded.
+*/
+void QQmlImportIndex::save()
+{
+    if (!m_initialized || !m_dirty)
+        return;
+    m_dirty = false;
+
+    QString fileName = indexFilePath();
+    if (fileName.isEmpty())
+        return;
+
+    // The qmldir content is only read now, so that indexing costs nothing while
+    // the imports are being resolved.
+    QHash<QString, Module>::Iterator it = m_modules.begin();
+    while (it != m_modules.end()) {
+        if (it->content.isEmpty()) {
+            QFile file(it->qmldirFilePath);
+            QFileInfo info(it->qmldirFilePath);
+            if (!file.open(QIODevice::ReadOnly)
+                    || info.lastModified().toMSecsSinceEpoch() != it->modified
+                    || info.size() != it->size) {
+                it = m_modules.erase(it);
+                continue;
+            }
+
+            QByteArray data = file.readAll();
+            // Bundles, and files the loader refuses, must keep going through the loader
+            if (!QQmlBundle::isBundleHeader(data.constData(), data.length())
+                    && QQml_isFileCaseCorrect(it->qmldirFilePath))
+                it->content = QString::fromUtf8(data);
+        }
+        ++it;
+    }
+
+    QByteArray bytes;
+    QDataStream ds(&bytes, QIODevice::WriteOnly);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    ds << qmliMagic << qmliVersion << QQmlDiskCache::buildId()
+       << m_importPaths << m_pluginPaths << m_importPathsModified;
+
+    ds << qint32(m_modules.count());
+    for (QHash<QString, Module>::ConstIterator it = m_modules.constBegin(); it != m_modules.constEnd(); ++it) {
+        ds << it.key() << it->qmldirFilePath << it->qmldirPathUrl << it->content
+           << it->modified << it->size << it->watchedDirectories << it->watchedModified;
+    }
+
+    ds << qint32(m_plugins.count());
+    for (QHash<QString, Plugin>::ConstIterator it = m_plugins.constBegin(); it != m_plugins.constEnd(); ++it)
+        ds << it.key() << it->filePath << it->modified;
+
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() || !file.commit()) {
+        if (qmlImportTrace())
+            qWarning() << "QQmlImportIndex: Cannot write" << fileName;
+    }
+}
+
+void QQmlImportIndex::clear()
+{
+    m_importPaths.clear();
+    m_pluginPaths.clear();
+    m_importPathsModified.clear();
+    m_modules.clear();
+    m_plugins.clear();
+    m_initialized = false;
+    m_dirty = false;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQMLIMPORTINDEX_P_H
+#define QQMLIMPORTINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtqmlglobal_p.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+// QQmlImportIndex persists where QQmlImportDatabase found the qmldir file of each
+// module, together with the qmldir content and the plugin files it resolved, so
+// that subsequent runs need not search the import paths again.
+//
+// An index is only used for the import and plugin paths it was written with.  It
+// is discarded as a whole if the QtQml build or the modification time of any of
+// the import path directories has changed.  Individual modules are checked against
+// the modification time and size of their qmldir file.  For every location the
+// search tried before finding the module, the modification time of the deepest
+// existing directory on the way to it is checked as well, which covers the module
+// being installed in a location that takes precedence, such as a more specific
+// version or an earlier import path.  Anything that fails validation falls back
+// to the regular search.  Failed lookups are never persisted.
+//
+// The index is enabled by setting QML_IMPORT_INDEX.  It is written to the
+// QQmlDiskCache directory if one is set, or to the application's cache location.
+class Q_QML_PRIVATE_EXPORT QQmlImportIndex
+{
+public:
+    QQmlImportIndex();
+    ~QQmlImportIndex();
+
+    static bool isEnabled();
+    static void setEnabled(bool);
+
+    void setSearchPaths(const QStringList &importPaths, const QStringList &pluginPaths);
+
+    bool findModule(const QString &uri, int vmaj, int vmin,
+                    QString *qmldirFilePath, QString *qmldirPathUrl, QString *content);
+    void addModule(const QString &uri, int vmaj, int vmin,
+                   const QString &qmldirFilePath, const QString &qmldirPathUrl,
+                   const QStringList &precedingQmldirPaths);
+
+    QString findPlugin(const QString &qmldirPath, const QString &qmldirPluginPath,
+                       const QString &name);
+    void addPlugin(const QString &qmldirPath, const QString &qmldirPluginPath,
+                   const QString &name, const QString &filePath);
+
+    QString indexFilePath() const;
+    void save();
+
+private:
+    Q_DISABLE_COPY(QQmlImportIndex)
+
+    struct Module {
+        Module() : modified(-1), size(-1), validated(false) {}
+
+        QString qmldirFilePath;
+        QString qmldirPathUrl;
+        QString content;
+        qint64 modified;
+        qint64 size;
+        QStringList watchedDirectories;
+        QList<qint64> watchedModified;
+        bool validated;
+    };
+
+    struct Plugin {
+        Plugin() : modified(-1), validated(false) {}
+
+        QString filePath;
+        qint64 modified;
+        bool validated;
+    };
+
+    void load();
+    void clear();
+
+    QStringList m_importPaths;
+    QStringList m_pluginPaths;
+    QList<qint64> m_importPathsModified;
+    QHash<QString, Module> m_modules;
+    QHash<QString, Plugin> m_plugins;
+    bool m_initialized:1;
+    bool m_dirty:1;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLIMPORTINDEX_P_H
@@ -75,6 +75,9 @@ void QQmlCompiledData::dump(QQmlInstruction *instr, int idx)
     case QQmlInstruction::CreateSimpleObject:
         qWarning().nospace() << idx << "\t\t" << "CREATE_SIMPLE\t\t" << instr->createSimple.typeSize;
         break;
+    case QQmlInstruction::CreateSimpleObjectAndBegin:
+        qWarning().nospace() << idx << "\t\t" << "CREATE_SIMPLE_BEGIN\t" << instr->createSimpleAndBegin.typeSize << "\t" << instr->createSimpleAndBegin.id << "\t" << instr->createSimpleAndBegin.castValue;
+        break;
     case QQmlInstruction::SetId:
         qWarning().nospace() << idx << "\t\t" << "SETID\t\t\t" << instr->setId.value << "\t\t\t" << primitives.at(instr->setId.value);
         break;
@@ -137,6 +140,9 @@ void QQmlCompiledData::dump(QQmlInstruction *instr, int idx)
     case QQmlInstruction::StoreColor:
         qWarning().nospace() << idx << "\t\t" << "STORE_COLOR\t\t" << instr->storeColor.propertyIndex << "\t\t\t" << QString::number(instr->storeColor.value, 16);
         break;
+    case QQmlInstruction::StoreLiteralBlock:
+        qWarning().nospace() << idx << "\t\t" << "STORE_LITERAL_BLOCK\t" << instr->storeLiteralBlock.data << "\t" << instr->storeLiteralBlock.count;
+        break;
     case QQmlInstruction::StoreDate:
         qWarning().nospace() << idx << "\t\t" << "STORE_DATE\t\t" << instr->storeDate.propertyIndex << "\t" << instr->storeDate.value;
         break;
@@ -231,7 +237,7 @@ void QQmlCompiledData::dump(QQmlInstruction *instr, int idx)
         qWarning().nospace() << idx << "\t\t" << "STORE_COMPILED_BINDING\t" << instr->assignV4Binding.property << "\t" << instr->assignV4Binding.value << "\t" << instr->assignV4Binding.context;
         break;
     case QQmlInstruction::StoreV8Binding:
-        qWarning().nospace() << idx << "\t\t" << "STORE_V8_BINDING\t" << instr->assignBinding.property.coreIndex << "\t" << instr->assignBinding.value << "\t" << instr->assignBinding.context;
+        qWarning().nospace() << idx << "\t\t" << "STORE_V8_BINDING\t" << instr->assignBinding.property.coreIndex << "\t" << instr->assignBinding.value << "\t" << instr->assignBinding.context << (instr->assignBinding.isStatic ? "\tSTATIC" : "");
         break;
     case QQmlInstruction::StoreValueSource:
         qWarning().nospace() << idx << "\t\t" << "STORE_VALUE_SOURCE\t" << instr->assignValueSource.property.coreIndex << "\t" << instr->assignValueSource.castValue;
@@ -67,6 +67,7 @@ QT_BEGIN_NAMESPACE
     F(CompleteQMLObject, completeQml) \
     F(CreateSimpleObject, createSimple) \
     F(SetId, setId) \
+    F(CreateSimpleObjectAndBegin, createSimpleAndBegin) \
     F(SetDefault, common) \
     F(CreateComponent, createComponent) \
     F(StoreMetaObject, storeMeta) \
@@ -98,6 +99,7 @@ QT_BEGIN_NAMESPACE
     F(StoreInteger, storeInteger) \
     F(StoreIntegerQList, storeInteger) \
     F(StoreColor, storeColor) \
+    F(StoreLiteralBlock, storeLiteralBlock) \
     F(StoreDate, storeDate) \
     F(StoreTime, storeTime) \
     F(StoreDateTime, storeDateTime) \
@@ -161,6 +163,24 @@ QT_BEGIN_NAMESPACE
 #define QML_INSTR_ENUM(I, FMT)  I,
 #define QML_INSTR_SIZE(I, FMT) ((sizeof(QQmlInstruction::instr_##FMT) + QML_INSTR_ALIGN_MASK) & ~QML_INSTR_ALIGN_MASK)
 
+// An entry in the table referenced by StoreLiteralBlock.  String and Url
+// entries hold an index into the primitives and urls of the compiled data.
+struct QQmlPackedLiteral
+{
+    enum Type { Integer, Bool, Float, Double, Color, String, Url };
+
+    int coreIndex;
+    int type;
+    union {
+        int intValue;
+        bool boolValue;
+        float floatValue;
+        double doubleValue;
+        unsigned int colorValue;
+        int index;
+    };
+};
+
 class QQmlCompiledData;
 union QQmlInstruction
 {
@@ -217,6 +237,17 @@ union QQmlInstruction
         ushort line; 
         bool parentToSuper;
     };
+    struct instr_createSimpleAndBegin {
+        QML_INSTR_HEADER
+        void (*create)(void *);
+        int typeSize;
+        int type;
+        ushort column;
+        ushort line; 
+        bool parentToSuper;
+        int id;
+        int castValue;
+    };
     struct instr_storeMeta {
         QML_INSTR_HEADER
         int aliasData;
@@ -265,6 +296,7 @@ union QQmlInstruction
         bool isAlias:1;
         bool isFallback:1;
         bool isSafe:1;
+        bool isStatic:1;
         ushort line;
         ushort column;
     };
@@ -358,6 +390,11 @@ union QQmlInstruction
         int propertyIndex;
         unsigned int value;
     };
+    struct instr_storeLiteralBlock {
+        QML_INSTR_HEADER
+        int data;
+        int count;
+    };
     struct instr_storeDate {
         QML_INSTR_HEADER
         int propertyIndex;
@@ -506,6 +543,7 @@ union QQmlInstruction
     instr_createQml createQml;
     instr_completeQml completeQml;
     instr_createSimple createSimple;
+    instr_createSimpleAndBegin createSimpleAndBegin;
     instr_storeMeta storeMeta;
     instr_setId setId;
     instr_assignValueSource assignValueSource;
@@ -529,6 +567,7 @@ union QQmlInstruction
     instr_storeScript storeScript;
     instr_storeUrl storeUrl;
     instr_storeColor storeColor;
+    instr_storeLiteralBlock storeLiteralBlock;
     instr_storeDate storeDate;
     instr_storeTime storeTime;
     instr_storeDateTime storeDateTime;
@@ -131,7 +131,7 @@ v8::Local<v8::Value>
 QQmlJavaScriptExpression::evaluate(QQmlContextData *context,
                                    v8::Handle<v8::Function> function,
                                    int argc, v8::Handle<v8::Value> args[],
-                                   bool *isUndefined)
+                                   bool *isUndefined, bool captureGuards)
 {
     Q_ASSERT(context && context->engine);
 
@@ -145,11 +145,15 @@ QQmlJavaScriptExpression::evaluate(QQmlContextData *context,
     Q_ASSERT(notifyOnValueChanged() || activeGuards.isEmpty());
     GuardCapture capture(context->engine, this);
 
+    // If the caller knows that the expression depends on the same properties each
+    // time, the guards from the previous evaluation are kept as they are.
+    bool capturing = notifyOnValueChanged() && captureGuards;
+
     QQmlEnginePrivate::PropertyCapture *lastPropertyCapture = ep->propertyCapture;
-    ep->propertyCapture = notifyOnValueChanged()?&capture:0;
+    ep->propertyCapture = capturing?&capture:0;
 
 
-    if (notifyOnValueChanged())
+    if (capturing)
         capture.guards.copyAndClearPrepend(activeGuards);
 
     QQmlContextData *lastSharedContext = 0;
@@ -114,13 +114,14 @@ public:
                                   bool *isUndefined);
     v8::Local<v8::Value> evaluate(QQmlContextData *, v8::Handle<v8::Function>,
                                   int argc, v8::Handle<v8::Value> args[],
-                                  bool *isUndefined);
+                                  bool *isUndefined, bool captureGuards = true);
 
     inline bool requiresThisObject() const;
     inline void setRequiresThisObject(bool v);
     inline bool useSharedContext() const;
     inline void setUseSharedContext(bool v);
     inline bool notifyOnValueChanged() const;
+    inline bool hasGuards() const;
 
     void setNotifyOnValueChanged(bool v);
     void resetNotifyOnValueChanged();
@@ -241,6 +242,11 @@ bool QQmlJavaScriptExpression::notifyOnValueChanged() const
     return activeGuards.flag();
 }
 
+bool QQmlJavaScriptExpression::hasGuards() const
+{
+    return !activeGuards.isEmpty();
+}
+
 QObject *QQmlJavaScriptExpression::scopeObject() const
 {
     if (m_scopeObject.isT1()) return m_scopeObject.asT1();
@@ -52,6 +52,7 @@
 #include <private/qqmlrewrite_p.h>
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qmutex.h>
 
 #include <ctype.h> // for toupper
 #include <limits.h>
@@ -242,8 +243,9 @@ Creates a new empty QQmlPropertyCache.
 */
 QQmlPropertyCache::QQmlPropertyCache(QQmlEngine *e)
 : engine(e), _parent(0), propertyIndexCacheStart(0), methodIndexCacheStart(0),
-  signalHandlerIndexCacheStart(0), _hasPropertyOverrides(false), _ownMetaObject(false),
-  _metaObject(0), argumentsCache(0)
+  signalHandlerIndexCacheStart(0), _lookupCount(0), _lookupId(nextLookupId()),
+  _hasPropertyOverrides(false),
+  _ownMetaObject(false), _metaObject(0), argumentsCache(0)
 {
     Q_ASSERT(engine);
 }
@@ -253,8 +255,9 @@ Creates a new QQmlPropertyCache of \a metaObject.
 */
 QQmlPropertyCache::QQmlPropertyCache(QQmlEngine *e, const QMetaObject *metaObject)
 : engine(e), _parent(0), propertyIndexCacheStart(0), methodIndexCacheStart(0),
-  signalHandlerIndexCacheStart(0), _hasPropertyOverrides(false), _ownMetaObject(false),
-  _metaObject(0), argumentsCache(0)
+  signalHandlerIndexCacheStart(0), _lookupCount(0), _lookupId(nextLookupId()),
+  _hasPropertyOverrides(false),
+  _ownMetaObject(false), _metaObject(0), argumentsCache(0)
 {
     Q_ASSERT(engine);
     Q_ASSERT(metaObject);
@@ -277,6 +280,7 @@ QQmlPropertyCache::~QQmlPropertyCache()
 
     // We must clear this prior to releasing the parent incase it is a
     // linked hash
+    invalidateLookupTable();
     stringCache.clear();
     if (_parent) _parent->release();
 
@@ -359,7 +363,7 @@ void QQmlPropertyCache::appendProperty(const QString &name,
     int index = propertyIndexCache.count();
     propertyIndexCache.append(data);
 
-    setNamedProperty(name, index + propertyOffset(), propertyIndexCache.data() + index, (old != 0));
+    setNamedProperty(QQmlStringTable::intern(engine, name), index + propertyOffset(), propertyIndexCache.data() + index, (old != 0));
 }
 
 void QQmlPropertyCache::appendProperty(const QHashedCStringRef &name,
@@ -414,8 +418,8 @@ void QQmlPropertyCache::appendSignal(const QString &name, quint32 flags, int cor
     QString handlerName = QLatin1String("on") + name;
     handlerName[2] = handlerName[2].toUpper();
 
-    setNamedProperty(name, methodIndex + methodOffset(), methodIndexCache.data() + methodIndex, (old != 0));
-    setNamedProperty(handlerName, signalHandlerIndex + signalOffset(), signalHandlerIndexCache.data() + signalHandlerIndex, (old != 0));
+    setNamedProperty(QQmlStringTable::intern(engine, name), methodIndex + methodOffset(), methodIndexCache.data() + methodIndex, (old != 0));
+    setNamedProperty(QQmlStringTable::intern(engine, handlerName), signalHandlerIndex + signalOffset(), signalHandlerIndexCache.data() + signalHandlerIndex, (old != 0));
 }
 
 void QQmlPropertyCache::appendSignal(const QHashedCStringRef &name, quint32 flags, int coreIndex,
@@ -479,7 +483,7 @@ void QQmlPropertyCache::appendMethod(const QString &name, quint32 flags, int cor
     int methodIndex = methodIndexCache.count();
     methodIndexCache.append(data);
 
-    setNamedProperty(name, methodIndex + methodOffset(), methodIndexCache.data() + methodIndex, (old != 0));
+    setNamedProperty(QQmlStringTable::intern(engine, name), methodIndex + methodOffset(), methodIndexCache.data() + methodIndex, (old != 0));
 }
 
 void QQmlPropertyCache::appendMethod(const QHashedCStringRef &name, quint32 flags, int coreIndex,
@@ -856,6 +860,7 @@ void QQmlPropertyCache::update(QQmlEngine *engine, const QMetaObject *metaObject
 */
 void QQmlPropertyCache::invalidate(QQmlEngine *engine, const QMetaObject *metaObject)
 {
+    invalidateLookupTable();
     stringCache.clear();
     propertyIndexCache.clear();
     methodIndexCache.clear();
@@ -940,6 +945,87 @@ QQmlPropertyCache::method(int index) const
     return ensureResolved(rv);
 }
 
+Q_GLOBAL_STATIC(QMutex, lookupTableMutex)
+
+/*
+    Returns the perfect hash table to use for name lookups, or 0 if the string
+    cache should be used.  The table is built once the cache has served
+    LookupTableThreshold lookups without being modified, and is built again if
+    the cache or one of its parents has been modified since.
+
+    Caches are read by the type loader thread and the engine thread at the same
+    time, so tables are built under a lock and only published once complete.
+*/
+const QQmlPropertyCache::LookupTable *QQmlPropertyCache::currentLookupTable() const
+{
+    LookupTableData *data = _lookupTable.loadAcquire();
+    if (data) {
+        if (!isLookupTableCurrent(data))
+            return buildLookupTable();
+        return data->table.isEmpty() ? 0 : &data->table;
+    }
+
+    if (_lookupCount.fetchAndAddRelaxed(1) == LookupTableThreshold - 1)
+        return buildLookupTable();
+    return 0;
+}
+
+const QQmlPropertyCache::LookupTable *QQmlPropertyCache::buildLookupTable() const
+{
+    QMutexLocker locker(lookupTableMutex());
+
+    // Another thread may have built the table in the meantime
+    LookupTableData *data = _lookupTable.loadAcquire();
+    if (!data || !isLookupTableCurrent(data)) {
+        LookupTableData *newData = new LookupTableData;
+        for (const QQmlPropertyCache *cache = this; cache; cache = cache->_parent)
+            newData->lookupIds.append(cache->_lookupId);
+
+        // If no table can be built, it is left empty and the string cache is used
+        newData->table.build(stringCache);
+
+        // Other threads may still be reading a table that is out of date
+        // because a parent changed, so it is kept until this cache changes.
+        if (data)
+            _retiredLookupTables.append(data);
+        _lookupTable.storeRelease(newData);
+        data = newData;
+    }
+
+    return data->table.isEmpty() ? 0 : &data->table;
+}
+
+bool QQmlPropertyCache::isLookupTableCurrent(const LookupTableData *data) const
+{
+    int ii = 0;
+    for (const QQmlPropertyCache *cache = this; cache; cache = cache->_parent, ++ii) {
+        if (ii == data->lookupIds.count() || data->lookupIds.at(ii) != cache->_lookupId)
+            return false;
+    }
+    return ii == data->lookupIds.count();
+}
+
+/*
+    Drops the lookup tables of the cache.  A cache is only modified while no
+    other thread reads it, so the tables can be deleted right away.
+*/
+void QQmlPropertyCache::invalidateLookupTable()
+{
+    delete _lookupTable.load();
+    _lookupTable.store(0);
+    qDeleteAll(_retiredLookupTables);
+    _retiredLookupTables.clear();
+    _lookupCount.store(0);
+    _lookupId = nextLookupId();
+}
+
+static QAtomicInt lookupIdCounter(0);
+
+quint32 QQmlPropertyCache::nextLookupId()
+{
+    return quint32(lookupIdCounter.fetchAndAddRelaxed(1) + 1);
+}
+
 QQmlPropertyData *QQmlPropertyCache::findProperty(StringCache::ConstIterator it, QObject *object, QQmlContextData *context) const
 {
     QQmlData *data = (object ? QQmlData::get(object) : 0);
@@ -1097,6 +1183,26 @@ QQmlPropertyCacheMethodArguments *QQmlPropertyCache::createArgumentsObject(int a
     return args;
 }
 
+/*! \internal
+    Returns the argument types (prefixed by the argument count) and names that were
+    passed to appendSignal() or appendMethod() for the dynamic method \a data.
+*/
+void QQmlPropertyCache::methodArguments(const QQmlPropertyData *data, QVector<int> *types,
+                                        QList<QByteArray> *names)
+{
+    QQmlPropertyCacheMethodArguments *args =
+        static_cast<QQmlPropertyCacheMethodArguments *>(data->arguments);
+    if (!data->isFunction() || !args)
+        return;
+
+    if (args->argumentsValid) {
+        types->resize(args->arguments[0] + 1);
+        ::memcpy(types->data(), args->arguments, types->size() * sizeof(int));
+    }
+    if (args->names)
+        *names = *args->names;
+}
+
 /*! \internal
     \a index MUST be in the signal index range (see QObjectPrivate::signalIndex()).
     This is different from QMetaMethod::methodIndex().
@@ -59,7 +59,9 @@
 #include "qqmlnotifier_p.h"
 
 #include <private/qhashedstring_p.h>
+#include <private/qperfectstringhash_p.h>
 #include <QtCore/qvarlengtharray.h>
+#include <QtCore/qatomic.h>
 #include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
@@ -282,11 +284,18 @@ public:
     template<typename K>
     QQmlPropertyData *property(const K &key, QObject *object, QQmlContextData *context) const
     {
-        return findProperty(stringCache.find(key), object, context);
+        return findProperty(findNamed(key), object, context);
     }
 
     QQmlPropertyData *property(int) const;
     QQmlPropertyData *method(int) const;
+
+    // Identifies the current set of names in the cache itself.  It is unique for
+    // the lifetime of the process, and changes whenever a name is added to or
+    // removed from this cache, but not when one of its parents changes.
+    inline quint32 lookupId() const;
+    // Changes whenever lookupId() of the cache or of any of its parents changes.
+    inline quint32 lookupChainId() const;
     QQmlPropertyData *signal(int index) const { return signal(index, 0); }
     int methodIndexToSignalIndex(int) const;
     QStringList propertyNames() const;
@@ -337,6 +346,7 @@ private:
     friend class QQmlEnginePrivate;
     friend class QV8QObjectWrapper;
     friend class QQmlCompiler;
+    friend class QQmlDiskCache;
 
     inline QQmlPropertyCache *copy(int reserve);
 
@@ -351,11 +361,18 @@ private:
     QQmlPropertyCacheMethodArguments *createArgumentsObject(int count,
                                                             const QList<QByteArray> &names = QList<QByteArray>());
     QQmlPropertyData *signal(int, QQmlPropertyCache **) const;
+    static void methodArguments(const QQmlPropertyData *, QVector<int> *types,
+                                QList<QByteArray> *names);
 
     typedef QVector<QQmlPropertyData> IndexCache;
     typedef QStringMultiHash<QPair<int, QQmlPropertyData *> > StringCache;
+    typedef QPerfectStringHash<QPair<int, QQmlPropertyData *> > LookupTable;
     typedef QVector<int> AllowedRevisionCache;
 
+    // Number of name lookups after the last modification before a cache is
+    // considered frozen and gets a perfect hash lookup table.
+    enum { LookupTableThreshold = 8 };
+
     QQmlPropertyData *findProperty(StringCache::ConstIterator it, QObject *, QQmlContextData *) const;
     QQmlPropertyData *findProperty(StringCache::ConstIterator it, const QQmlVMEMetaObject *, QQmlContextData *) const;
 
@@ -374,10 +391,32 @@ private:
     template<typename K>
     void setNamedProperty(const K &key, int index, QQmlPropertyData *data, bool isOverride)
     {
+        invalidateLookupTable();
         stringCache.insert(key, qMakePair(index, data));
         _hasPropertyOverrides |= isOverride;
     }
 
+    template<typename K>
+    StringCache::ConstIterator findNamed(const K &key) const
+    {
+        if (const LookupTable *table = currentLookupTable())
+            return table->find(key);
+        return stringCache.find(key);
+    }
+
+    // A lookup table, with the lookupId() of the cache and of each of its
+    // parents at the time it was built.
+    struct LookupTableData {
+        LookupTable table;
+        QVarLengthArray<quint32, 8> lookupIds;
+    };
+
+    const LookupTable *currentLookupTable() const;
+    const LookupTable *buildLookupTable() const;
+    bool isLookupTableCurrent(const LookupTableData *) const;
+    void invalidateLookupTable();
+    static quint32 nextLookupId();
+
     QQmlEngine *engine;
 
     QQmlPropertyCache *_parent;
@@ -389,6 +428,10 @@ private:
     IndexCache methodIndexCache;
     IndexCache signalHandlerIndexCache;
     StringCache stringCache;
+    mutable QAtomicPointer<LookupTableData> _lookupTable;
+    mutable QAtomicInt _lookupCount;
+    mutable QVector<LookupTableData *> _retiredLookupTables;
+    quint32 _lookupId;
     AllowedRevisionCache allowedRevisionCache;
     v8::Persistent<v8::Function> constructor;
 
@@ -497,6 +540,23 @@ QQmlEngine *QQmlPropertyCache::qmlEngine() const
     return engine;
 }
 
+quint32 QQmlPropertyCache::lookupId() const
+{
+    return _lookupId;
+}
+
+/*
+Lookup ids are handed out in increasing order and never reused, so a new id
+anywhere in the chain is larger than any id seen before, and so is the maximum.
+*/
+quint32 QQmlPropertyCache::lookupChainId() const
+{
+    quint32 rv = _lookupId;
+    for (const QQmlPropertyCache *cache = _parent; cache; cache = cache->_parent)
+        rv = qMax(rv, cache->_lookupId);
+    return rv;
+}
+
 int QQmlPropertyCache::propertyCount() const
 {
     return propertyIndexCacheStart + propertyIndexCache.count();
@@ -196,6 +196,124 @@ bool SharedBindingTester::visit(AST::BinaryExpression *e)
     return true;
 }
 
+StaticDependencyTester::StaticDependencyTester(const QSet<QString> &ids)
+: _ids(ids), _static(false)
+{
+}
+
+void StaticDependencyTester::parse(const QString &code)
+{
+    _static = false;
+
+    Engine engine;
+    Lexer lexer(&engine);
+    Parser parser(&engine);
+    lexer.setCode(code, 0);
+    parser.parseStatement();
+    if (!parser.statement())
+        return;
+
+    return parse(parser.statement());
+}
+
+void StaticDependencyTester::parse(AST::Node *node)
+{
+    _static = true;
+
+    AST::Node::acceptChild(node, this);
+}
+
+bool StaticDependencyTester::preVisit(AST::Node *node)
+{
+    if (!_static)
+        return false;
+
+    switch (node->kind) {
+    case AST::Node::Kind_ExpressionStatement:
+    case AST::Node::Kind_NestedExpression:
+    case AST::Node::Kind_Expression:
+    case AST::Node::Kind_ArgumentList:
+    case AST::Node::Kind_IdentifierExpression:
+    case AST::Node::Kind_FieldMemberExpression:
+    case AST::Node::Kind_CallExpression:
+    case AST::Node::Kind_BinaryExpression:
+    case AST::Node::Kind_NumericLiteral:
+    case AST::Node::Kind_StringLiteral:
+    case AST::Node::Kind_TrueLiteral:
+    case AST::Node::Kind_FalseLiteral:
+    case AST::Node::Kind_NullExpression:
+    case AST::Node::Kind_UnaryMinusExpression:
+    case AST::Node::Kind_UnaryPlusExpression:
+    case AST::Node::Kind_TildeExpression:
+    case AST::Node::Kind_NotExpression:
+    case AST::Node::Kind_TypeOfExpression:
+        return true;
+    default:
+        _static = false;
+        return false;
+    }
+}
+
+bool StaticDependencyTester::visit(AST::IdentifierExpression *e)
+{
+    static const QString evalString = QStringLiteral("eval");
+    if (e->name == evalString)
+        _static = false;
+
+    return false;
+}
+
+bool StaticDependencyTester::visit(AST::FieldMemberExpression *e)
+{
+    static const QString mathString = QStringLiteral("Math");
+
+    // The object whose property is read must not change between evaluations
+    AST::IdentifierExpression *base = AST::cast<AST::IdentifierExpression *>(e->base);
+    if (!base || (base->name != mathString && !_ids.contains(base->name.toString())))
+        _static = false;
+
+    return false;
+}
+
+bool StaticDependencyTester::visit(AST::CallExpression *e)
+{
+    static const QString mathString = QStringLiteral("Math");
+
+    AST::FieldMemberExpression *fme = AST::cast<AST::FieldMemberExpression *>(e->base);
+    AST::IdentifierExpression *base = fme ? AST::cast<AST::IdentifierExpression *>(fme->base) : 0;
+    if (!base || base->name != mathString) {
+        _static = false;
+        return false;
+    }
+
+    AST::Node::accept(e->arguments, this);
+    return false;
+}
+
+bool StaticDependencyTester::visit(AST::BinaryExpression *e)
+{
+    switch (e->op) {
+    case QSOperator::And:
+    case QSOperator::Or:
+    case QSOperator::Assign:
+    case QSOperator::InplaceAnd:
+    case QSOperator::InplaceSub:
+    case QSOperator::InplaceDiv:
+    case QSOperator::InplaceAdd:
+    case QSOperator::InplaceLeftShift:
+    case QSOperator::InplaceMod:
+    case QSOperator::InplaceMul:
+    case QSOperator::InplaceOr:
+    case QSOperator::InplaceRightShift:
+    case QSOperator::InplaceURightShift:
+    case QSOperator::InplaceXor:
+        _static = false;
+        return false;
+    default:
+        return true;
+    }
+}
+
 QString RewriteBinding::operator()(const QString &code, bool *ok, bool *sharable, bool *safe)
 {
     Engine engine;
@@ -58,6 +58,7 @@
 #include <private/qqmljsparser_p.h>
 #include <private/qqmljsmemorypool_p.h>
 #include <private/qhashedstring_p.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -88,6 +89,30 @@ public:
     virtual bool visit(AST::BinaryExpression *);
 };
 
+// Tests whether an expression reads the same properties every time it is evaluated,
+// so that a binding only needs to capture its dependencies once.  This is true when
+// it has no conditional evaluation, calls no functions other than Math ones, and only
+// reads plain names or properties of the ids in \a ids.
+class Q_AUTOTEST_EXPORT StaticDependencyTester : protected AST::Visitor
+{
+    const QSet<QString> &_ids;
+    bool _static;
+public:
+    StaticDependencyTester(const QSet<QString> &ids);
+
+    bool isStatic() const { return _static; }
+
+    void parse(const QString &code);
+    void parse(AST::Node *node);
+
+protected:
+    virtual bool preVisit(AST::Node *);
+    virtual bool visit(AST::IdentifierExpression *);
+    virtual bool visit(AST::FieldMemberExpression *);
+    virtual bool visit(AST::CallExpression *);
+    virtual bool visit(AST::BinaryExpression *);
+};
+
 class RewriteBinding: protected AST::Visitor
 {
     unsigned _position;
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmlstringtable_p.h"
+#include "qqmlengine_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QQmlStringTable::QQmlStringTable()
+{
+}
+
+QQmlStringTable::~QQmlStringTable()
+{
+}
+
+// Returns true for the identifiers the table holds
+bool QQmlStringTable::isInterned(const QChar *data, int length)
+{
+    if (length == 0 || length > MaximumLength)
+        return false;
+
+    for (int ii = 0; ii < length; ++ii) {
+        const QChar c = data[ii];
+        if (c.isLetter() || c == QLatin1Char('_') || c == QLatin1Char('$'))
+            continue;
+        if (ii > 0 && c.isDigit())
+            continue;
+        return false;
+    }
+    return true;
+}
+
+QString QQmlStringTable::internLocked(const QString &string)
+{
+    QHashedString key(string);
+    if (QHashedString *existing = m_strings.value(key))
+        return *existing;
+    m_strings.insert(key, key);
+    return string;
+}
+
+/*!
+    Returns a copy of \a string that shares its data with every other string
+    interned in this table with the same contents.
+*/
+QString QQmlStringTable::intern(const QString &string)
+{
+    if (!isInterned(string.constData(), string.length()))
+        return string;
+
+    QMutexLocker lock(&m_mutex);
+    return internLocked(string);
+}
+
+QString QQmlStringTable::intern(const QHashedStringRef &string)
+{
+    if (!isInterned(string.constData(), string.length()))
+        return string.toString();
+
+    QMutexLocker lock(&m_mutex);
+    if (QHashedString *existing = m_strings.value(string))
+        return *existing;
+    QHashedString key(string.toString(), string.hash());
+    m_strings.insert(key, key);
+    return key;
+}
+
+/*!
+    Interns each of \a strings in place, taking the lock once.
+*/
+void QQmlStringTable::intern(QList<QString> *strings)
+{
+    QMutexLocker lock(&m_mutex);
+    for (int ii = 0; ii < strings->count(); ++ii) {
+        const QString &string = strings->at(ii);
+        if (isInterned(string.constData(), string.length()))
+            (*strings)[ii] = internLocked(string);
+    }
+}
+
+int QQmlStringTable::count() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_strings.count();
+}
+
+void QQmlStringTable::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_strings.clear();
+}
+
+/*!
+    Interns \a string in the string table of \a engine.  If \a engine is 0 the
+    string is returned unchanged.
+*/
+QString QQmlStringTable::intern(QQmlEngine *engine, const QString &string)
+{
+    if (!engine)
+        return string;
+    return QQmlEnginePrivate::get(engine)->stringTable.intern(string);
+}
+
+QT_END_NAMESPACE
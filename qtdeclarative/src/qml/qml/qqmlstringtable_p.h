@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLSTRINGTABLE_P_H
+#define QQMLSTRINGTABLE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qhashedstring_p.h>
+
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQmlEngine;
+
+// An engine wide table of interned identifier strings.  Strings returned by
+// intern() share their storage with every other interned copy, so keys in
+// property caches and compiled data primitives refer to the same QStringData
+// and compare equal on the pointer fast path of QHashedString::compare().
+//
+// Only identifiers of up to MaximumLength characters are interned; anything
+// else (binding scripts, most string literals) is returned unchanged.  Interned
+// strings are never removed, so they live as long as the engine.  This includes
+// string literals that happen to be short identifiers, as compiled data
+// primitives mix names and literals.
+class Q_QML_PRIVATE_EXPORT QQmlStringTable
+{
+public:
+    enum { MaximumLength = 48 };
+
+    QQmlStringTable();
+    ~QQmlStringTable();
+
+    QString intern(const QString &);
+    QString intern(const QHashedStringRef &);
+    void intern(QList<QString> *);
+
+    int count() const;
+    void clear();
+
+    static QString intern(QQmlEngine *, const QString &);
+
+private:
+    Q_DISABLE_COPY(QQmlStringTable)
+
+    static bool isInterned(const QChar *, int length);
+    QString internLocked(const QString &);
+
+    mutable QMutex m_mutex;
+    QStringHash<QHashedString> m_strings;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLSTRINGTABLE_P_H
@@ -49,6 +49,7 @@
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmlprofilerservice_p.h>
 #include <private/qqmlmemoryprofiler_p.h>
+#include <private/qqmldiskcache_p.h>
 
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
@@ -59,6 +60,8 @@
 #include <QtCore/qdiriterator.h>
 #include <QtQml/qqmlcomponent.h>
 #include <QtCore/qwaitcondition.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qrunnable.h>
 #include <QtQml/qqmlextensioninterface.h>
 
 #if defined (Q_OS_UNIX)
@@ -97,6 +100,7 @@
 #endif
 
 DEFINE_BOOL_CONFIG_OPTION(dumpErrors, QML_DUMP_ERRORS);
+DEFINE_BOOL_CONFIG_OPTION(parallelLoadingEnv, QML_PARALLEL_LOADING);
 
 QT_BEGIN_NAMESPACE
 
@@ -1446,7 +1450,7 @@ QString QQmlTypeLoader::QmldirContent::pluginLocation() const
 Constructs a new type loader that uses the given \a engine.
 */
 QQmlTypeLoader::QQmlTypeLoader(QQmlEngine *engine)
-: QQmlDataLoader(engine)
+: QQmlDataLoader(engine), m_parserPool(0)
 {
 }
 
@@ -1460,6 +1464,109 @@ QQmlTypeLoader::~QQmlTypeLoader()
     shutdownThread();
 
     clearCache();
+
+    if (m_parserPool) {
+        m_parserPool->waitForDone();
+        delete m_parserPool;
+    }
+}
+
+namespace {
+
+struct ParallelLoadingSettings
+{
+    ParallelLoadingSettings() : enabled(-1) {}
+
+    QMutex mutex;
+    int enabled;
+};
+
+}
+
+Q_GLOBAL_STATIC(ParallelLoadingSettings, parallelLoadingSettings)
+
+/*!
+Returns true if QML sources are parsed concurrently.
+
+When enabled, the local QML files a document depends on are read and parsed on a
+pool of worker threads while the document's remaining dependencies are resolved.
+Type resolution and compilation remain on the loader thread, as they depend on
+engine state.  This is controlled by the QML_PARALLEL_LOADING environment
+variable, unless overridden by setParallelLoadingEnabled().
+*/
+bool QQmlTypeLoader::isParallelLoadingEnabled()
+{
+    ParallelLoadingSettings *settings = parallelLoadingSettings();
+    QMutexLocker locker(&settings->mutex);
+    if (settings->enabled == -1)
+        settings->enabled = parallelLoadingEnv();
+    return settings->enabled;
+}
+
+void QQmlTypeLoader::setParallelLoadingEnabled(bool enabled)
+{
+    ParallelLoadingSettings *settings = parallelLoadingSettings();
+    QMutexLocker locker(&settings->mutex);
+    settings->enabled = enabled;
+}
+
+// Reads and parses the source of a QQmlTypeData on the parser pool.  The source
+// is handed to the data loader by getType(), so that the file is only read once.
+class QQmlTypeDataParser : public QRunnable
+{
+public:
+    QQmlTypeDataParser(QQmlTypeData *typeData, const QString &fileName)
+    : typeData(typeData), fileName(fileName), url(typeData->url()), urlString(url.toString()) {}
+
+    virtual void run()
+    {
+        // Mismatches are left to QQmlFile to report, as for any other file
+        QFile file(fileName);
+        if (QQml_isFileCaseCorrect(fileName) && file.open(QFile::ReadOnly)) {
+            typeData->m_backgroundSource = file.readAll();
+            QString code = QString::fromUtf8(typeData->m_backgroundSource);
+            typeData->m_backgroundParseResult = typeData->scriptParser.parse(code, QByteArray(),
+                                                                             url, urlString);
+        }
+
+        typeData->m_backgroundParseDone.release();
+    }
+
+private:
+    QQmlTypeData *typeData;
+    QString fileName;
+    QUrl url;
+    QString urlString;
+};
+
+/*!
+Starts parsing the QML file at \a url on the parser pool, if parallel loading is
+enabled.  The QQmlTypeData is handed out by a subsequent getType() call for \a url.
+*/
+void QQmlTypeLoader::parseInBackground(const QUrl &url)
+{
+    // The disk cache makes parsing unnecessary in the common case
+    if (!isParallelLoadingEnabled() || QQmlDiskCache::isEnabled())
+        return;
+
+    QString fileName = QQmlFile::urlToLocalFileOrQrc(url);
+    if (fileName.isEmpty())
+        return;
+
+    LockHolder<QQmlTypeLoader> holder(this);
+
+    if (m_typeCache.contains(url) || m_parsingTypes.contains(url))
+        return;
+
+    if (!m_parserPool) {
+        m_parserPool = new QThreadPool;
+        m_parserPool->setMaxThreadCount(QThread::idealThreadCount());
+    }
+
+    QQmlTypeData *typeData = new QQmlTypeData(url, None, this);
+    typeData->m_parsingInBackground = true;
+    m_parsingTypes.insert(url, typeData);
+    m_parserPool->start(new QQmlTypeDataParser(typeData, fileName));
 }
 
 QQmlImportDatabase *QQmlTypeLoader::importDatabase()
@@ -1487,15 +1594,30 @@ QQmlTypeData *QQmlTypeLoader::getType(const QUrl &url, Mode mode)
             (QQmlFile::urlToLocalFileOrQrc(url).isEmpty() ||
              !QDir::isRelativePath(QQmlFile::urlToLocalFileOrQrc(url))));
 
+    // Sources changed by the debugger take precedence over those parsed in the
+    // background.  Checked before locking, as it takes the engine's lock.
+    const bool debugChanges = !QQmlEnginePrivate::get(engine())->debugChangesCache().isEmpty();
+
     LockHolder<QQmlTypeLoader> holder(this);
     
     QQmlTypeData *typeData = m_typeCache.value(url);
 
     if (!typeData) {
-        typeData = new QQmlTypeData(url, None, this);
+        QByteArray source;
+        typeData = m_parsingTypes.take(url);
+        if (typeData) {
+            typeData->waitForBackgroundParse();
+            if (!debugChanges)
+                source = typeData->m_backgroundSource;
+        } else {
+            typeData = new QQmlTypeData(url, None, this);
+        }
         // TODO: if (compiledData == 0), is it safe to omit this insertion?
         m_typeCache.insert(url, typeData);
-        QQmlDataLoader::load(typeData, mode);
+        if (source.isEmpty())
+            QQmlDataLoader::load(typeData, mode);
+        else
+            QQmlDataLoader::loadWithStaticData(typeData, source, mode);
     }
 
     typeData->addref();
@@ -1606,8 +1728,9 @@ void QQmlTypeLoader::addBundle(const QString &identifier, const QString &fileNam
 
 void QQmlTypeLoader::addBundleNoLock(const QString &identifier, const QString &fileName)
 {
+    // Mapped read-only, so that the pages are shared by all processes using the bundle
     QQmlBundleData *data = new QQmlBundleData(fileName);
-    if (data->open()) {
+    if (data->open(QFile::ReadOnly)) {
 
         m_bundleCache.insert(identifier, data);
 
@@ -1866,6 +1989,8 @@ void QQmlTypeLoader::clearCache()
 {
     for (TypeCache::Iterator iter = m_typeCache.begin(); iter != m_typeCache.end(); ++iter)
         (*iter)->release();
+    for (TypeCache::Iterator iter = m_parsingTypes.begin(); iter != m_parsingTypes.end(); ++iter)
+        (*iter)->release();
     for (ScriptCache::Iterator iter = m_scriptCache.begin(); iter != m_scriptCache.end(); ++iter) 
         (*iter)->release();
     for (QmldirCache::Iterator iter = m_qmldirCache.begin(); iter != m_qmldirCache.end(); ++iter)
@@ -1874,6 +1999,7 @@ void QQmlTypeLoader::clearCache()
     qDeleteAll(m_importQmlDirCache);
 
     m_typeCache.clear();
+    m_parsingTypes.clear();
     m_scriptCache.clear();
     m_qmldirCache.clear();
     m_importDirCache.clear();
@@ -1926,18 +2052,22 @@ QQmlTypeData::TypeDataCallback::~TypeDataCallback()
 QQmlTypeData::QQmlTypeData(const QUrl &url, QQmlTypeLoader::Options options, 
                                            QQmlTypeLoader *manager)
 : QQmlTypeLoader::Blob(url, QmlFile, manager), m_options(options),
-   m_typesResolved(false), m_compiledData(0), m_implicitImport(0), m_implicitImportLoaded(false)
+   m_parsingInBackground(false), m_backgroundParseResult(false), m_typesResolved(false),
+   m_compiledData(0), m_cachedUnit(0), m_implicitImport(0), m_implicitImportLoaded(false)
 {
 }
 
 QQmlTypeData::~QQmlTypeData()
 {
+    waitForBackgroundParse();
+
     for (int ii = 0; ii < m_scripts.count(); ++ii) 
         m_scripts.at(ii).script->release();
     for (int ii = 0; ii < m_types.count(); ++ii) 
         if (m_types.at(ii).typeData) m_types.at(ii).typeData->release();
     if (m_compiledData)
         m_compiledData->release();
+    delete m_cachedUnit;
     delete m_implicitImport;
 }
 
@@ -2002,7 +2132,7 @@ void QQmlTypeData::done()
         const TypeReference &type = m_types.at(ii);
         Q_ASSERT(!type.typeData || type.typeData->isCompleteOrError());
         if (type.typeData && type.typeData->isError()) {
-            QString typeName = scriptParser.referencedTypes().at(ii)->name;
+            QString typeName = typeReferenceName(ii);
 
             QList<QQmlError> errors = type.typeData->errors();
             QQmlError error;
@@ -2021,6 +2151,10 @@ void QQmlTypeData::done()
 
     if (!(m_options & QQmlTypeLoader::PreserveParser))
         scriptParser.clear();
+
+    delete m_cachedUnit;
+    m_cachedUnit = 0;
+    m_cachedSource.clear();
 }
 
 void QQmlTypeData::completed()
@@ -2053,17 +2187,57 @@ bool QQmlTypeData::loadImplicitImport()
     return true;
 }
 
+void QQmlTypeData::waitForBackgroundParse()
+{
+    if (m_parsingInBackground) {
+        m_backgroundParseDone.acquire();
+        m_parsingInBackground = false;
+    }
+}
+
 void QQmlTypeData::dataReceived(const Data &data)
 {
-    QString code = QString::fromUtf8(data.data(), data.size());
-    QByteArray preparseData;
+    waitForBackgroundParse();
 
-    if (data.isFile()) preparseData = data.asFile()->metaData(QLatin1String("qml:preparse"));
+    // The parser must be populated if it is to be preserved
+    if (!(m_options & QQmlTypeLoader::PreserveParser)) {
+        QByteArray compiled;
+        if (data.isFile()) compiled = data.asFile()->metaData(QLatin1String("qml:compiled"));
 
-    if (!scriptParser.parse(code, preparseData, finalUrl(), finalUrlString())) {
-        setError(scriptParser.errors());
-        return;
+        const bool sharing = QQmlDiskCache::isSharingEnabled();
+        if (!compiled.isEmpty() || sharing || QQmlDiskCache::isEnabled())
+            m_sourceHash = QQmlDiskCache::sourceHash(data.data(), data.size());
+
+        // Entries precompiled by qmlcompile take precedence over the disk cache
+        if (!compiled.isEmpty())
+            m_cachedUnit = QQmlDiskCache::load(compiled, m_sourceHash);
+        if (!m_cachedUnit && sharing)
+            m_cachedUnit = QQmlDiskCache::loadShared(finalUrl(), m_sourceHash);
+        if (!m_cachedUnit && QQmlDiskCache::isEnabled())
+            m_cachedUnit = QQmlDiskCache::load(finalUrl(), m_sourceHash);
+    }
+
+    if (m_cachedUnit) {
+        // Kept in case the cached data turns out to be stale
+        m_cachedSource = QByteArray(data.data(), data.size());
+    } else if (!m_backgroundSource.isEmpty() && m_backgroundSource.constData() == data.data()) {
+        // Handed over by getType() after being parsed on the parser pool
+        if (!m_backgroundParseResult) {
+            setError(scriptParser.errors());
+            return;
+        }
+    } else {
+        QString code = QString::fromUtf8(data.data(), data.size());
+        QByteArray preparseData;
+
+        if (data.isFile()) preparseData = data.asFile()->metaData(QLatin1String("qml:preparse"));
+
+        if (!scriptParser.parse(code, preparseData, finalUrl(), finalUrlString())) {
+            setError(scriptParser.errors());
+            return;
+        }
     }
+    m_backgroundSource.clear();
 
     m_imports.setBaseUrl(finalUrl(), finalUrlString());
 
@@ -2092,7 +2266,7 @@ void QQmlTypeData::dataReceived(const Data &data)
 
     QList<QQmlError> errors;
 
-    foreach (const QQmlScript::Import &import, scriptParser.imports()) {
+    foreach (const QQmlScript::Import &import, imports()) {
         if (!addImport(import, &errors)) {
             Q_ASSERT(errors.size());
             QQmlError error(errors.takeFirst());
@@ -2153,12 +2327,67 @@ void QQmlTypeData::compile()
 
     QQmlCompilingProfiler prof(m_compiledData->name);
 
+    if (m_cachedUnit) {
+        if (QQmlDiskCache::restore(this, m_cachedUnit, m_compiledData))
+            return;
+
+        // Fall back to compiling the source, and replace the stale cache
+        m_compiledData->release();
+        m_compiledData = new QQmlCompiledData(typeLoader()->engine());
+        m_compiledData->url = finalUrl();
+        m_compiledData->name = finalUrlString();
+
+        QString code = QString::fromUtf8(m_cachedSource);
+        if (!scriptParser.parse(code, QByteArray(), finalUrl(), finalUrlString())) {
+            setError(scriptParser.errors());
+            m_compiledData->release();
+            m_compiledData = 0;
+            return;
+        }
+    }
+
     QQmlCompiler compiler(&scriptParser._pool);
     if (!compiler.compile(typeLoader()->engine(), this, m_compiledData)) {
         setError(compiler.errors());
         m_compiledData->release();
         m_compiledData = 0;
+        return;
     }
+
+    if (!m_sourceHash.isEmpty() && QQmlDiskCache::isEnabled())
+        QQmlDiskCache::save(this, m_compiledData, m_sourceHash);
+    if (!m_sourceHash.isEmpty() && QQmlDiskCache::isSharingEnabled())
+        QQmlDiskCache::share(this, m_compiledData, m_sourceHash);
+}
+
+/*
+Returns the imports of the document, which are read from the disk cache if the
+document has not been parsed.
+*/
+QList<QQmlScript::Import> QQmlTypeData::imports() const
+{
+    return m_cachedUnit ? m_cachedUnit->imports : scriptParser.imports();
+}
+
+int QQmlTypeData::typeReferenceCount() const
+{
+    return m_cachedUnit ? m_cachedUnit->typeNames.count() : scriptParser.referencedTypes().count();
+}
+
+QString QQmlTypeData::typeReferenceName(int index) const
+{
+    return m_cachedUnit ? m_cachedUnit->typeNames.at(index)
+                        : scriptParser.referencedTypes().at(index)->name;
+}
+
+QQmlScript::Location QQmlTypeData::typeReferenceLocation(int index) const
+{
+    if (m_cachedUnit)
+        return m_cachedUnit->typeLocations.at(index);
+
+    QQmlScript::TypeReference *parserRef = scriptParser.referencedTypes().at(index);
+    Q_ASSERT(parserRef->firstUse);
+    return parserRef->firstUse->location.start;
 }
 
 void QQmlTypeData::resolveTypes()
@@ -2184,7 +2413,10 @@ void QQmlTypeData::resolveTypes()
         m_scripts << ref;
     }
 
-    foreach (QQmlScript::TypeReference *parserRef, scriptParser.referencedTypes()) {
+    QList<int> compositeTypes;
+
+    for (int ii = 0; ii < typeReferenceCount(); ++ii) {
+        const QString typeName = typeReferenceName(ii);
         TypeReference ref;
 
         QString url;
@@ -2193,14 +2425,14 @@ void QQmlTypeData::resolveTypes()
         QQmlImportNamespace *typeNamespace = 0;
         QList<QQmlError> errors;
 
-        bool typeFound = m_imports.resolveType(parserRef->name, &ref.type,
+        bool typeFound = m_imports.resolveType(typeName, &ref.type,
                 &majorVersion, &minorVersion, &typeNamespace, &errors);
         if (!typeNamespace && !typeFound && !m_implicitImportLoaded) {
             // Lazy loading of implicit import
             if (loadImplicitImport()) {
                 // Try again to find the type
                 errors.clear();
-                typeFound = m_imports.resolveType(parserRef->name, &ref.type,
+                typeFound = m_imports.resolveType(typeName, &ref.type,
                     &majorVersion, &minorVersion, &typeNamespace, &errors);
             } else {
                 return; //loadImplicitImport() hit an error, and called setError already
@@ -2213,7 +2445,7 @@ void QQmlTypeData::resolveTypes()
             //  - type with unknown namespace (UnknownNamespace.SomeType {})
             QQmlError error;
             if (typeNamespace) {
-                error.setDescription(QQmlTypeLoader::tr("Namespace %1 cannot be used as a type").arg(parserRef->name));
+                error.setDescription(QQmlTypeLoader::tr("Namespace %1 cannot be used as a type").arg(typeName));
             } else {
                 if (errors.size()) {
                     error = errors.takeFirst();
@@ -2223,30 +2455,37 @@ void QQmlTypeData::resolveTypes()
                     error.setDescription(QQmlTypeLoader::tr("Unreported error adding script import to import database"));
                 }
                 error.setUrl(m_imports.baseUrl());
-                error.setDescription(QQmlTypeLoader::tr("%1 %2").arg(parserRef->name).arg(error.description()));
+                error.setDescription(QQmlTypeLoader::tr("%1 %2").arg(typeName).arg(error.description()));
             }
 
-            Q_ASSERT(parserRef->firstUse);
-            error.setLine(parserRef->firstUse->location.start.line);
-            error.setColumn(parserRef->firstUse->location.start.column);
+            error.setLine(typeReferenceLocation(ii).line);
+            error.setColumn(typeReferenceLocation(ii).column);
 
             errors.prepend(error);
             setError(errors);
             return;
         }
 
-        if (ref.type->isComposite()) {
-            ref.typeData = typeLoader()->getType(ref.type->sourceUrl());
-            addDependency(ref.typeData);
-        }
+        if (ref.type->isComposite())
+            compositeTypes.append(m_types.count());
         ref.majorVersion = majorVersion;
         ref.minorVersion = minorVersion;
 
-        Q_ASSERT(parserRef->firstUse);
-        ref.location = parserRef->firstUse->location.start;
+        ref.location = typeReferenceLocation(ii);
 
         m_types << ref;
     }
+
+    // Composite types are loaded once all references are resolved, so that their
+    // sources can be parsed concurrently
+    for (int ii = 0; ii < compositeTypes.count(); ++ii)
+        typeLoader()->parseInBackground(m_types.at(compositeTypes.at(ii)).type->sourceUrl());
+
+    for (int ii = 0; ii < compositeTypes.count(); ++ii) {
+        TypeReference &ref = m_types[compositeTypes.at(ii)];
+        ref.typeData = typeLoader()->getType(ref.type->sourceUrl());
+        addDependency(ref.typeData);
+    }
 }
 
 void QQmlTypeData::scriptImported(QQmlScriptBlob *blob, const QQmlScript::Location &location, const QString &qualifier, const QString &/*nameSpace*/)
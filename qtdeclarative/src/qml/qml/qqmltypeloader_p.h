@@ -55,6 +55,7 @@
 
 #include <QtCore/qobject.h>
 #include <QtCore/qatomic.h>
+#include <QtCore/qsemaphore.h>
 #include <QtNetwork/qnetworkreply.h>
 #include <QtQml/qqmlerror.h>
 #include <QtQml/qqmlengine.h>
@@ -67,6 +68,7 @@
 #include <private/qqmlcleanup_p.h>
 #include <private/qqmldirparser_p.h>
 #include <private/qqmlbundle_p.h>
+#include <private/qqmldiskcache_p.h>
 #include <private/qflagpointer_p.h>
 #include <private/qqmlabstracturlinterceptor_p.h>
 
@@ -79,6 +81,7 @@ class QQmlTypeLoader;
 class QQmlCompiledData;
 class QQmlComponentPrivate;
 class QQmlTypeData;
+class QThreadPool;
 class QQmlDataLoader;
 class QQmlExtensionInterface;
 
@@ -258,7 +261,7 @@ public:
     QString fileName;
 };
 
-class QQmlTypeLoader : public QQmlDataLoader
+class Q_AUTOTEST_EXPORT QQmlTypeLoader : public QQmlDataLoader
 {
     Q_DECLARE_TR_FUNCTIONS(QQmlTypeLoader)
 public:
@@ -351,7 +354,14 @@ public:
     bool isTypeLoaded(const QUrl &url) const;
     bool isScriptLoaded(const QUrl &url) const;
 
+    static bool isParallelLoadingEnabled();
+    static void setParallelLoadingEnabled(bool);
+
 private:
+    friend class QQmlTypeData;
+
+    void parseInBackground(const QUrl &);
+
     void addBundleNoLock(const QString &, const QString &);
     QString bundleIdForQmldir(const QString &qmldir, const QString &uriHint);
 
@@ -381,6 +391,8 @@ private:
     typedef QStringHash<QString> QmldirBundleIdCache;
 
     TypeCache m_typeCache;
+    TypeCache m_parsingTypes;
+    QThreadPool *m_parserPool;
     ScriptCache m_scriptCache;
     QmldirCache m_qmldirCache;
     ImportDirCache m_importDirCache;
@@ -416,6 +428,7 @@ public:
 
 private:
     friend class QQmlTypeLoader;
+    friend class QQmlTypeDataParser;
 
     QQmlTypeData(const QUrl &, QQmlTypeLoader::Options, QQmlTypeLoader *);
 
@@ -450,12 +463,26 @@ private:
     void resolveTypes();
     void compile();
 
+    QList<QQmlScript::Import> imports() const;
+    int typeReferenceCount() const;
+    QString typeReferenceName(int) const;
+    QQmlScript::Location typeReferenceLocation(int) const;
+
+    void waitForBackgroundParse();
+
     virtual void scriptImported(QQmlScriptBlob *blob, const QQmlScript::Location &location, const QString &qualifier, const QString &nameSpace);
 
     QQmlTypeLoader::Options m_options;
 
     QQmlScript::Parser scriptParser;
 
+    // Set if scriptParser is populated on the type loader's parser pool.  The
+    // source and result are written by the pool thread.
+    bool m_parsingInBackground;
+    bool m_backgroundParseResult;
+    QByteArray m_backgroundSource;
+    QSemaphore m_backgroundParseDone;
+
     QList<ScriptReference> m_scripts;
 
     QSet<QString> m_namespaces;
@@ -465,6 +492,11 @@ private:
 
     QQmlCompiledData *m_compiledData;
 
+    // Set if the compiled data can be restored from the disk cache
+    QQmlDiskCache::Unit *m_cachedUnit;
+    QByteArray m_cachedSource;
+    QByteArray m_sourceHash;
+
     QList<TypeDataCallback *> m_callbacks;
 
     QQmlScript::Import *m_implicitImport;
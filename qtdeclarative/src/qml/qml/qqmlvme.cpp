@@ -264,13 +264,17 @@ static QVariant variantFromString(const QString &string)
     } break;
 #endif
 
+// Declared properties of the target's own QQmlVMEMetaObject are written directly
+// to their typed storage where possible
 #define QML_STORE_VALUE(name, cpptype, value) \
     QML_BEGIN_INSTR(name) \
         cpptype v = value; \
-        void *a[] = { (void *)&v, 0, &status, &flags }; \
         QObject *target = objects.top(); \
         CLEAN_PROPERTY(target, instr.propertyIndex); \
-        QMetaObject::metacall(target, QMetaObject::WriteProperty, instr.propertyIndex, a); \
+        if (!QQmlVMEMetaObject::writeTypedProperty(target, instr.propertyIndex, &v)) { \
+            void *a[] = { (void *)&v, 0, &status, &flags }; \
+            QMetaObject::metacall(target, QMetaObject::WriteProperty, instr.propertyIndex, a); \
+        } \
     QML_END_INSTR(name)
 
 #define QML_STORE_PROVIDER_VALUE(name, type, value) \
@@ -306,12 +310,57 @@ static QVariant variantFromString(const QString &string)
 
 #define QML_STORE_POINTER(name, value) \
     QML_BEGIN_INSTR(name) \
-        void *a[] = { (void *)value, 0, &status, &flags }; \
         QObject *target = objects.top(); \
         CLEAN_PROPERTY(target, instr.propertyIndex); \
-        QMetaObject::metacall(target, QMetaObject::WriteProperty, instr.propertyIndex, a); \
+        if (!QQmlVMEMetaObject::writeTypedProperty(target, instr.propertyIndex, value)) { \
+            void *a[] = { (void *)value, 0, &status, &flags }; \
+            QMetaObject::metacall(target, QMetaObject::WriteProperty, instr.propertyIndex, a); \
+        } \
     QML_END_INSTR(name)
 
+// Shared by CreateSimpleObject and the CreateSimpleObjectAndBegin superinstruction
+#define QML_CREATE_SIMPLE_OBJECT(o) \
+    QObject *o = (QObject *)operator new(instr.typeSize + sizeof(QQmlData)); \
+    ::memset(o, 0, instr.typeSize + sizeof(QQmlData)); \
+    instr.create(o); \
+    { \
+        QQmlData *ddata = (QQmlData *)(((const char *)o) + instr.typeSize); \
+        const QQmlCompiledData::TypeReference &ref = TYPES.at(instr.type); \
+        if (!ddata->propertyCache && ref.typePropertyCache) { \
+            ddata->propertyCache = ref.typePropertyCache; \
+            ddata->propertyCache->addref(); \
+        } \
+        ddata->lineNumber = instr.line; \
+        ddata->columnNumber = instr.column; \
+        QObjectPrivate::get(o)->declarativeData = ddata; \
+        ddata->context = ddata->outerContext = CTXT; \
+        ddata->nextContextObject = CTXT->contextObjects; \
+        if (ddata->nextContextObject) \
+            ddata->nextContextObject->prevContextObject = &ddata->nextContextObject; \
+        ddata->prevContextObject = &CTXT->contextObjects; \
+        CTXT->contextObjects = ddata; \
+        QObject *parent = objects.at(objects.count() - 1 - (instr.parentToSuper?1:0)); \
+        QQml_setParent_noEvent(o, parent); \
+        ddata->parentFrozen = true; \
+    } \
+    objects.push(o)
+
+#ifdef QML_ENABLE_TRACE
+#  define QML_PUSH_PARSER_STATUS_DATA(target) \
+    Q_ASSERT(QObjectPrivate::get(target)->declarativeData); \
+    parserStatusData.push(static_cast<QQmlData *>(QObjectPrivate::get(target)->declarativeData));
+#else
+#  define QML_PUSH_PARSER_STATUS_DATA(target)
+#endif
+
+#define QML_BEGIN_OBJECT(target, castValue) { \
+    QQmlParserStatus *status = reinterpret_cast<QQmlParserStatus *>(reinterpret_cast<char *>(target) + castValue); \
+    parserStatus.push(status); \
+    QML_PUSH_PARSER_STATUS_DATA(target) \
+    status->d = &parserStatus.top(); \
+    status->classBegin(); \
+    }
+
 #define CLEAN_PROPERTY(o, index) \
     if (fastHasBinding(o, index)) \
         removeBindingOnProperty(o, index)
@@ -384,6 +433,48 @@ QObject *QQmlVME::run(QList<QQmlError> *errors,
         QML_STORE_VALUE(StoreBool, bool, instr.value);
         QML_STORE_VALUE(StoreInteger, int, instr.value);
         QML_STORE_PROVIDER_VALUE(StoreColor, QMetaType::QColor, instr.value);
+
+        QML_BEGIN_INSTR(StoreLiteralBlock)
+            QObject *target = objects.top();
+            const QQmlPackedLiteral *literal =
+                reinterpret_cast<const QQmlPackedLiteral *>(DATAS.at(instr.data).constData());
+            for (int ii = 0; ii < instr.count; ++ii, ++literal) {
+                struct { void *data[4]; } buffer;
+                void *value = 0;
+                switch (literal->type) {
+                case QQmlPackedLiteral::Integer:
+                    value = const_cast<int *>(&literal->intValue);
+                    break;
+                case QQmlPackedLiteral::Bool:
+                    value = const_cast<bool *>(&literal->boolValue);
+                    break;
+                case QQmlPackedLiteral::Float:
+                    value = const_cast<float *>(&literal->floatValue);
+                    break;
+                case QQmlPackedLiteral::Double:
+                    value = const_cast<double *>(&literal->doubleValue);
+                    break;
+                case QQmlPackedLiteral::Color:
+                    if (QQml_valueTypeProvider()->storeValueType(QMetaType::QColor, &literal->colorValue, &buffer, sizeof(buffer)))
+                        value = &buffer;
+                    break;
+                case QQmlPackedLiteral::String:
+                    value = const_cast<QString *>(&PRIMITIVES.at(literal->index));
+                    break;
+                case QQmlPackedLiteral::Url:
+                    value = const_cast<QUrl *>(&URLS.at(literal->index));
+                    break;
+                }
+                if (!value)
+                    continue;
+
+                CLEAN_PROPERTY(target, literal->coreIndex);
+                if (!QQmlVMEMetaObject::writeTypedProperty(target, literal->coreIndex, value)) {
+                    void *a[] = { value, 0, &status, &flags };
+                    QMetaObject::metacall(target, QMetaObject::WriteProperty, literal->coreIndex, a);
+                }
+            }
+        QML_END_INSTR(StoreLiteralBlock)
         QML_STORE_VALUE(StoreDate, QDate, QDate::fromJulianDay(instr.value));
         QML_STORE_VALUE(StoreDateTime, QDateTime,
                         QDateTime(QDate::fromJulianDay(instr.date), *(QTime *)&instr.time));
@@ -627,34 +718,17 @@ QObject *QQmlVME::run(QList<QQmlError> *errors,
         QML_END_INSTR(CreateCppObject)
 
         QML_BEGIN_INSTR(CreateSimpleObject)
-            QObject *o = (QObject *)operator new(instr.typeSize + sizeof(QQmlData));   
-            ::memset(o, 0, instr.typeSize + sizeof(QQmlData));
-            instr.create(o);
-
-            QQmlData *ddata = (QQmlData *)(((const char *)o) + instr.typeSize);
-            const QQmlCompiledData::TypeReference &ref = TYPES.at(instr.type);
-            if (!ddata->propertyCache && ref.typePropertyCache) {
-                ddata->propertyCache = ref.typePropertyCache;
-                ddata->propertyCache->addref();
-            }
-            ddata->lineNumber = instr.line;
-            ddata->columnNumber = instr.column;
-
-            QObjectPrivate::get(o)->declarativeData = ddata;                                                      
-            ddata->context = ddata->outerContext = CTXT;
-            ddata->nextContextObject = CTXT->contextObjects; 
-            if (ddata->nextContextObject) 
-                ddata->nextContextObject->prevContextObject = &ddata->nextContextObject; 
-            ddata->prevContextObject = &CTXT->contextObjects; 
-            CTXT->contextObjects = ddata; 
-
-            QObject *parent = objects.at(objects.count() - 1 - (instr.parentToSuper?1:0));
-            QQml_setParent_noEvent(o, parent);                                                        
-
-            ddata->parentFrozen = true;
-            objects.push(o);
+            QML_CREATE_SIMPLE_OBJECT(o);
         QML_END_INSTR(CreateSimpleObject)
 
+        QML_BEGIN_INSTR(CreateSimpleObjectAndBegin)
+            QML_CREATE_SIMPLE_OBJECT(o);
+            if (instr.id != -1)
+                CTXT->setIdProperty(instr.id, o);
+            if (instr.castValue != -1)
+                QML_BEGIN_OBJECT(o, instr.castValue);
+        QML_END_INSTR(CreateSimpleObjectAndBegin)
+
         QML_BEGIN_INSTR(SetId)
             QObject *target = objects.top();
             CTXT->setIdProperty(instr.index, target);
@@ -795,15 +869,7 @@ QObject *QQmlVME::run(QList<QQmlError> *errors,
 
         QML_BEGIN_INSTR(BeginObject)
             QObject *target = objects.top();
-            QQmlParserStatus *status = reinterpret_cast<QQmlParserStatus *>(reinterpret_cast<char *>(target) + instr.castValue);
-            parserStatus.push(status);
-#ifdef QML_ENABLE_TRACE
-            Q_ASSERT(QObjectPrivate::get(target)->declarativeData);
-            parserStatusData.push(static_cast<QQmlData *>(QObjectPrivate::get(target)->declarativeData));
-#endif
-            status->d = &parserStatus.top();
-
-            status->classBegin();
+            QML_BEGIN_OBJECT(target, instr.castValue);
         QML_END_INSTR(BeginObject)
 
         QML_BEGIN_INSTR(InitV8Bindings)
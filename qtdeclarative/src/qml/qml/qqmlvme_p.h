@@ -157,6 +157,7 @@ private:
 #ifdef QML_THREADED_VME_INTERPRETER
     static void *const*instructionJumpTable();
     friend class QQmlCompiledData;
+    friend class QQmlDiskCache;
 #endif
 
     QQmlEngine *engine;
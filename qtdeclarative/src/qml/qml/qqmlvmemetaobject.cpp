@@ -53,6 +53,8 @@
 #include <private/qv8variantresource_p.h>
 #include <private/qqmlglobal_p.h>
 
+#include <stdlib.h>
+
 QT_BEGIN_NAMESPACE
 
 QQmlVMEVariantQObjectPtr::QQmlVMEVariantQObjectPtr(bool isVar)
@@ -135,6 +137,120 @@ private:
     inline void cleanup();
 };
 
+static inline int typedValueSize(int type)
+{
+    switch (type) {
+    case QMetaType::Int:
+        return sizeof(int);
+    case QMetaType::Bool:
+        return sizeof(bool);
+    case QMetaType::Double:
+        return sizeof(double);
+    case QMetaType::QString:
+        return sizeof(QString);
+    case QMetaType::QUrl:
+        return sizeof(QUrl);
+    default:
+        return 0;
+    }
+}
+
+template<typename T>
+static inline void readTypedValue(const char *storage, void *value)
+{
+    *reinterpret_cast<T *>(value) = *reinterpret_cast<const T *>(storage);
+}
+
+template<typename T>
+static inline bool writeTypedValue(char *storage, const void *value)
+{
+    T &current = *reinterpret_cast<T *>(storage);
+    const T &v = *reinterpret_cast<const T *>(value);
+    if (current == v)
+        return false;
+    current = v;
+    return true;
+}
+
+static inline void readTypedStorage(int type, const char *storage, void *value)
+{
+    switch (type) {
+    case QMetaType::Int:
+        readTypedValue<int>(storage, value);
+        break;
+    case QMetaType::Bool:
+        readTypedValue<bool>(storage, value);
+        break;
+    case QMetaType::Double:
+        readTypedValue<double>(storage, value);
+        break;
+    case QMetaType::QString:
+        readTypedValue<QString>(storage, value);
+        break;
+    case QMetaType::QUrl:
+        readTypedValue<QUrl>(storage, value);
+        break;
+    default:
+        Q_ASSERT(!"readTypedStorage: not a typed storage type");
+        break;
+    }
+}
+
+// Returns true if the stored value changed
+static inline bool writeTypedStorage(int type, char *storage, const void *value)
+{
+    switch (type) {
+    case QMetaType::Int:
+        return writeTypedValue<int>(storage, value);
+    case QMetaType::Bool:
+        return writeTypedValue<bool>(storage, value);
+    case QMetaType::Double:
+        return writeTypedValue<double>(storage, value);
+    case QMetaType::QString:
+        return writeTypedValue<QString>(storage, value);
+    case QMetaType::QUrl:
+        return writeTypedValue<QUrl>(storage, value);
+    default:
+        Q_ASSERT(!"writeTypedStorage: not a typed storage type");
+        return false;
+    }
+}
+
+/*!
+    Assigns the declared properties their storage.  Typed storage is laid out in
+    order of decreasing alignment, so that it needs no padding.  This is called
+    by the compiler once all properties have been added.
+*/
+void QQmlVMEMetaData::layoutStorage()
+{
+    static const int typedStorageOrder[] = {
+        QMetaType::Double, QMetaType::QString, QMetaType::QUrl, QMetaType::Int, QMetaType::Bool
+    };
+
+    const int dataPropertyCount = propertyCount - varPropertyCount;
+
+    typedStorageSize = 0;
+    for (uint ii = 0; ii < sizeof(typedStorageOrder) / sizeof(int); ++ii) {
+        const int type = typedStorageOrder[ii];
+        for (int jj = 0; jj < dataPropertyCount; ++jj) {
+            PropertyData *p = propertyData() + jj;
+            if (p->propertyType == type) {
+                p->storageOffset = typedStorageSize;
+                typedStorageSize += typedValueSize(type);
+            }
+        }
+    }
+
+    variantPropertyCount = 0;
+    for (int ii = 0; ii < propertyCount; ++ii) {
+        PropertyData *p = propertyData() + ii;
+        if (ii >= dataPropertyCount)
+            p->storageOffset = -1;
+        else if (!isTypedStorageType(p->propertyType))
+            p->storageOffset = variantPropertyCount++;
+    }
+}
+
 class QQmlVMEMetaObjectEndpoint : public QQmlNotifierEndpoint
 {
 public:
@@ -552,7 +668,7 @@ QQmlVMEMetaObject::QQmlVMEMetaObject(QObject *obj,
                                      const QQmlVMEMetaData *meta)
 : QV8GCCallback::Node(GcPrologueCallback), object(obj),
   ctxt(QQmlData::get(obj, true)->outerContext), cache(cache), metaData(meta),
-  hasAssignedMetaObjectData(false), data(0), aliasEndpoints(0), firstVarPropertyIndex(-1),
+  hasAssignedMetaObjectData(false), data(0), typedData(0), aliasEndpoints(0), firstVarPropertyIndex(-1),
   varPropertiesInitialized(false), interceptors(0), v8methods(0)
 {
     QObjectPrivate *op = QObjectPrivate::get(obj);
@@ -567,7 +683,11 @@ QQmlVMEMetaObject::QQmlVMEMetaObject(QObject *obj,
     op->metaObject = this;
     QQmlData::get(obj)->hasVMEMetaObject = true;
 
-    data = new QQmlVMEVariant[metaData->propertyCount - metaData->varPropertyCount];
+    data = new QQmlVMEVariant[metaData->variantPropertyCount];
+    if (metaData->typedStorageSize) {
+        // Zeroed memory is a valid int, bool and double
+        typedData = static_cast<char *>(::calloc(metaData->typedStorageSize, 1));
+    }
 
     aConnected.resize(metaData->aliasCount);
     int list_type = qMetaTypeId<QQmlListProperty<QObject> >();
@@ -577,10 +697,15 @@ QQmlVMEMetaObject::QQmlVMEMetaObject(QObject *obj,
 
     // ### Optimize
     for (int ii = 0; ii < metaData->propertyCount - metaData->varPropertyCount; ++ii) {
-        int t = (metaData->propertyData() + ii)->propertyType;
-        if (t == list_type) {
+        const QQmlVMEMetaData::PropertyData *p = metaData->propertyData() + ii;
+        int t = p->propertyType;
+        if (t == QMetaType::QString) {
+            new (typedData + p->storageOffset) QString;
+        } else if (t == QMetaType::QUrl) {
+            new (typedData + p->storageOffset) QUrl;
+        } else if (t == list_type) {
             listProperties.append(List(methodOffset() + ii, this));
-            data[ii].setValue(listProperties.count() - 1);
+            data[p->storageOffset].setValue(listProperties.count() - 1);
         } else if (!needsGcCallback && (t == qobject_type || t == variant_type)) {
             needsGcCallback = true;
         }
@@ -601,6 +726,16 @@ QQmlVMEMetaObject::~QQmlVMEMetaObject()
 {
     if (parent.isT1()) parent.asT1()->objectDestroyed(object);
     delete [] data;
+    if (typedData) {
+        for (int ii = 0; ii < firstVarPropertyIndex; ++ii) {
+            const QQmlVMEMetaData::PropertyData *p = metaData->propertyData() + ii;
+            if (p->propertyType == QMetaType::QString)
+                reinterpret_cast<QString *>(typedData + p->storageOffset)->~QString();
+            else if (p->propertyType == QMetaType::QUrl)
+                reinterpret_cast<QUrl *>(typedData + p->storageOffset)->~QUrl();
+        }
+        ::free(typedData);
+    }
     delete [] aliasEndpoints;
 
     for (int ii = 0; v8methods && ii < metaData->methodCount; ++ii) {
@@ -717,52 +852,46 @@ int QQmlVMEMetaObject::metaCall(QMetaObject::Call c, int _id, void **a)
                         *reinterpret_cast<QVariant *>(a[0]) = QVariant();
                     }
 
+                } else if (QQmlVMEMetaData::isTypedStorageType(t)) {
+                    char *storage = typedData + (metaData->propertyData() + id)->storageOffset;
+
+                    if (c == QMetaObject::ReadProperty)
+                        readTypedStorage(t, storage, a[0]);
+                    else if (c == QMetaObject::WriteProperty)
+                        needActivate = writeTypedStorage(t, storage, a[0]);
+
                 } else {
+                    QQmlVMEVariant &variant = data[(metaData->propertyData() + id)->storageOffset];
 
                     if (c == QMetaObject::ReadProperty) {
                         switch(t) {
-                        case QVariant::Int:
-                            *reinterpret_cast<int *>(a[0]) = data[id].asInt();
-                            break;
-                        case QVariant::Bool:
-                            *reinterpret_cast<bool *>(a[0]) = data[id].asBool();
-                            break;
-                        case QVariant::Double:
-                            *reinterpret_cast<double *>(a[0]) = data[id].asDouble();
-                            break;
-                        case QVariant::String:
-                            *reinterpret_cast<QString *>(a[0]) = data[id].asQString();
-                            break;
-                        case QVariant::Url:
-                            *reinterpret_cast<QUrl *>(a[0]) = data[id].asQUrl();
-                            break;
                         case QVariant::Date:
-                            *reinterpret_cast<QDate *>(a[0]) = data[id].asQDate();
+                            *reinterpret_cast<QDate *>(a[0]) = variant.asQDate();
                             break;
                         case QVariant::DateTime:
-                            *reinterpret_cast<QDateTime *>(a[0]) = data[id].asQDateTime();
+                            *reinterpret_cast<QDateTime *>(a[0]) = variant.asQDateTime();
                             break;
                         case QVariant::RectF:
-                            *reinterpret_cast<QRectF *>(a[0]) = data[id].asQRectF();
+                            *reinterpret_cast<QRectF *>(a[0]) = variant.asQRectF();
                             break;
                         case QVariant::SizeF:
-                            *reinterpret_cast<QSizeF *>(a[0]) = data[id].asQSizeF();
+                            *reinterpret_cast<QSizeF *>(a[0]) = variant.asQSizeF();
                             break;
                         case QVariant::PointF:
-                            *reinterpret_cast<QPointF *>(a[0]) = data[id].asQPointF();
+                            *reinterpret_cast<QPointF *>(a[0]) = variant.asQPointF();
                             break;
                         case QMetaType::QObjectStar:
-                            *reinterpret_cast<QObject **>(a[0]) = data[id].asQObject();
+                            *reinterpret_cast<QObject **>(a[0]) = variant.asQObject();
                             break;
                         case QMetaType::QVariant:
                             *reinterpret_cast<QVariant *>(a[0]) = readPropertyAsVariant(id);
                             break;
                         default:
-                            QQml_valueTypeProvider()->readValueType(data[id].dataType(), data[id].dataPtr(), data->dataSize(), t, a[0]);
+                            QQml_valueTypeProvider()->readValueType(variant.dataType(), variant.dataPtr(), variant.dataSize(), t, a[0]);
                             break;
                         }
                         if (t == qMetaTypeId<QQmlListProperty<QObject> >()) {
-                            int listIndex = data[id].asInt();
+                            int listIndex = variant.asInt();
                             const List *list = &listProperties.at(listIndex);
                             *reinterpret_cast<QQmlListProperty<QObject> *>(a[0]) = 
                                 QQmlListProperty<QObject>(object, (void *)list,
@@ -773,63 +902,42 @@ int QQmlVMEMetaObject::metaCall(QMetaObject::Call c, int _id, void **a)
                     } else if (c == QMetaObject::WriteProperty) {
 
                         switch(t) {
-                        case QVariant::Int:
-                            needActivate = *reinterpret_cast<int *>(a[0]) != data[id].asInt();
-                            data[id].setValue(*reinterpret_cast<int *>(a[0]));
-                            break;
-                        case QVariant::Bool:
-                            needActivate = *reinterpret_cast<bool *>(a[0]) != data[id].asBool();
-                            data[id].setValue(*reinterpret_cast<bool *>(a[0]));
-                            break;
-                        case QVariant::Double:
-                            needActivate = *reinterpret_cast<double *>(a[0]) != data[id].asDouble();
-                            data[id].setValue(*reinterpret_cast<double *>(a[0]));
-                            break;
-                        case QVariant::String:
-                            needActivate = *reinterpret_cast<QString *>(a[0]) != data[id].asQString();
-                            data[id].setValue(*reinterpret_cast<QString *>(a[0]));
-                            break;
-                        case QVariant::Url:
-                            needActivate = *reinterpret_cast<QUrl *>(a[0]) != data[id].asQUrl();
-                            data[id].setValue(*reinterpret_cast<QUrl *>(a[0]));
-                            break;
                         case QVariant::Date:
-                            needActivate = *reinterpret_cast<QDate *>(a[0]) != data[id].asQDate();
-                            data[id].setValue(*reinterpret_cast<QDate *>(a[0]));
+                            needActivate = *reinterpret_cast<QDate *>(a[0]) != variant.asQDate();
+                            variant.setValue(*reinterpret_cast<QDate *>(a[0]));
                             break;
                         case QVariant::DateTime:
-                            needActivate = *reinterpret_cast<QDateTime *>(a[0]) != data[id].asQDateTime();
-                            data[id].setValue(*reinterpret_cast<QDateTime *>(a[0]));
+                            needActivate = *reinterpret_cast<QDateTime *>(a[0]) != variant.asQDateTime();
+                            variant.setValue(*reinterpret_cast<QDateTime *>(a[0]));
                             break;
                         case QVariant::RectF:
-                            needActivate = *reinterpret_cast<QRectF *>(a[0]) != data[id].asQRectF();
-                            data[id].setValue(*reinterpret_cast<QRectF *>(a[0]));
+                            needActivate = *reinterpret_cast<QRectF *>(a[0]) != variant.asQRectF();
+                            variant.setValue(*reinterpret_cast<QRectF *>(a[0]));
                             break;
                         case QVariant::SizeF:
-                            needActivate = *reinterpret_cast<QSizeF *>(a[0]) != data[id].asQSizeF();
-                            data[id].setValue(*reinterpret_cast<QSizeF *>(a[0]));
+                            needActivate = *reinterpret_cast<QSizeF *>(a[0]) != variant.asQSizeF();
+                            variant.setValue(*reinterpret_cast<QSizeF *>(a[0]));
                             break;
                         case QVariant::PointF:
-                            needActivate = *reinterpret_cast<QPointF *>(a[0]) != data[id].asQPointF();
-                            data[id].setValue(*reinterpret_cast<QPointF *>(a[0]));
+                            needActivate = *reinterpret_cast<QPointF *>(a[0]) != variant.asQPointF();
+                            variant.setValue(*reinterpret_cast<QPointF *>(a[0]));
                             break;
                         case QMetaType::QObjectStar:
-                            needActivate = *reinterpret_cast<QObject **>(a[0]) != data[id].asQObject();
-                            data[id].setValue(*reinterpret_cast<QObject **>(a[0]), this, id);
+                            needActivate = *reinterpret_cast<QObject **>(a[0]) != variant.asQObject();
+                            variant.setValue(*reinterpret_cast<QObject **>(a[0]), this, id);
                             break;
                         case QMetaType::QVariant:
                             writeProperty(id, *reinterpret_cast<QVariant *>(a[0]));
                             break;
                         default:
-                            data[id].ensureValueType(t);
-                            needActivate = !QQml_valueTypeProvider()->equalValueType(t, a[0], data[id].dataPtr(), data[id].dataSize());
-                            QQml_valueTypeProvider()->writeValueType(t, a[0], data[id].dataPtr(), data[id].dataSize());
+                            variant.ensureValueType(t);
+                            needActivate = !QQml_valueTypeProvider()->equalValueType(t, a[0], variant.dataPtr(), variant.dataSize());
+                            QQml_valueTypeProvider()->writeValueType(t, a[0], variant.dataPtr(), variant.dataSize());
                             break;
                         }
                     }
 
                 }
-
                 if (c == QMetaObject::WriteProperty && needActivate) {
                     activate(object, methodOffset() + id, 0);
                 }
@@ -1014,10 +1122,11 @@ QVariant QQmlVMEMetaObject::readPropertyAsVariant(int id)
             return QQmlEnginePrivate::get(ctxt->engine)->v8engine()->toVariant(varProperties->Get(id - firstVarPropertyIndex), -1);
         return QVariant();
     } else {
-        if (data[id].dataType() == QMetaType::QObjectStar) {
-            return QVariant::fromValue(data[id].asQObject());
+        QQmlVMEVariant &variant = data[(metaData->propertyData() + id)->storageOffset];
+        if (variant.dataType() == QMetaType::QObjectStar) {
+            return QVariant::fromValue(variant.asQObject());
         } else {
-            return data[id].asQVariant();
+            return variant.asQVariant();
         }
     }
 }
@@ -1100,15 +1209,16 @@ void QQmlVMEMetaObject::writeProperty(int id, const QVariant &value)
             activate(object, methodOffset() + id, 0);
     } else {
         bool needActivate = false;
+        QQmlVMEVariant &variant = data[(metaData->propertyData() + id)->storageOffset];
         if (value.userType() == QMetaType::QObjectStar) {
             QObject *o = *(QObject **)value.data();
-            needActivate = (data[id].dataType() != QMetaType::QObjectStar || data[id].asQObject() != o);
-            data[id].setValue(o, this, id);
+            needActivate = (variant.dataType() != QMetaType::QObjectStar || variant.asQObject() != o);
+            variant.setValue(o, this, id);
         } else {
-            needActivate = (data[id].dataType() != qMetaTypeId<QVariant>() ||
-                            data[id].asQVariant().userType() != value.userType() ||
-                            data[id].asQVariant() != value);
-            data[id].setValue(value);
+            needActivate = (variant.dataType() != qMetaTypeId<QVariant>() ||
+                            variant.asQVariant().userType() != value.userType() ||
+                            variant.asQVariant() != value);
+            variant.setValue(value);
         }
 
         if (needActivate)
@@ -1266,7 +1376,7 @@ void QQmlVMEMetaObject::GcPrologueCallback(QV8GCCallback::Node *node)
     QQmlEnginePrivate *ep = QQmlEnginePrivate::get(vmemo->ctxt->engine);
 
     // add references created by VMEVariant properties
-    int maxDataIdx = vmemo->metaData->propertyCount - vmemo->metaData->varPropertyCount;
+    int maxDataIdx = vmemo->metaData->variantPropertyCount;
     for (int ii = 0; ii < maxDataIdx; ++ii) { // XXX TODO: optimize?
         if (vmemo->data[ii].dataType() == QMetaType::QObjectStar) {
             // possible QObject reference.
@@ -1360,6 +1470,39 @@ QQmlVMEMetaObject *QQmlVMEMetaObject::getForProperty(QObject *o, int coreIndex)
     return vme;
 }
 
+bool QQmlVMEMetaObject::readTypedProperty(int coreIndex, void *value)
+{
+    int id = coreIndex - propOffset();
+    if (id < 0 || id >= firstVarPropertyIndex)
+        return false;
+
+    const QQmlVMEMetaData::PropertyData *p = metaData->propertyData() + id;
+    if (!QQmlVMEMetaData::isTypedStorageType(p->propertyType))
+        return false;
+
+    readTypedStorage(p->propertyType, typedData + p->storageOffset, value);
+    return true;
+}
+
+bool QQmlVMEMetaObject::writeTypedProperty(int coreIndex, const void *value)
+{
+    // Interceptors (such as Behaviors) need the full metaCall()
+    if (interceptors)
+        return false;
+
+    int id = coreIndex - propOffset();
+    if (id < 0 || id >= firstVarPropertyIndex)
+        return false;
+
+    const QQmlVMEMetaData::PropertyData *p = metaData->propertyData() + id;
+    if (!QQmlVMEMetaData::isTypedStorageType(p->propertyType))
+        return false;
+
+    if (writeTypedStorage(p->propertyType, typedData + p->storageOffset, value))
+        activate(object, methodOffset() + id, 0);
+    return true;
+}
+
 QQmlVMEMetaObject *QQmlVMEMetaObject::getForMethod(QObject *o, int coreIndex)
 {
     QQmlVMEMetaObject *vme = QQmlVMEMetaObject::get(o);
@@ -84,8 +84,8 @@ struct QQmlVMEMetaData
     short aliasCount;
     short signalCount;
     short methodCount;
-    short dummyForAlignment; // Add padding to ensure that the following
-                             // AliasData/PropertyData/MethodData is int aligned.
+    short variantPropertyCount; // Properties stored in a QQmlVMEVariant
+    int typedStorageSize;       // Size of the typed property storage, in bytes
 
     struct AliasData {
         int contextIdx;
@@ -114,8 +114,13 @@ struct QQmlVMEMetaData
         }
     };
     
+    // Declared int, bool, real, string and url properties are packed into one
+    // block of typed storage, with storageOffset giving the property's byte
+    // offset in it.  For other properties, except var properties, storageOffset
+    // is the index of the property's QQmlVMEVariant.
     struct PropertyData {
         int propertyType;
+        int storageOffset;
     };
 
     struct MethodData {
@@ -136,6 +141,13 @@ struct QQmlVMEMetaData
     MethodData *methodData() const {
         return (MethodData *)(aliasData() + aliasCount);
     }
+
+    static inline bool isTypedStorageType(int type) {
+        return type == QMetaType::Int || type == QMetaType::Bool || type == QMetaType::Double ||
+               type == QMetaType::QString || type == QMetaType::QUrl;
+    }
+
+    void layoutStorage();
 };
 
 class QQmlVMEMetaObject;
@@ -181,6 +193,9 @@ public:
     static QQmlVMEMetaObject *getForMethod(QObject *o, int coreIndex);
     static QQmlVMEMetaObject *getForSignal(QObject *o, int coreIndex);
 
+    static inline bool readTypedProperty(QObject *o, int coreIndex, void *value);
+    static inline bool writeTypedProperty(QObject *o, int coreIndex, const void *value);
+
 protected:
     virtual int metaCall(QMetaObject::Call _c, int _id, void **_a);
 
@@ -201,6 +216,10 @@ public:
 
     bool hasAssignedMetaObjectData;
     QQmlVMEVariant *data;
+    char *typedData;
+
+    bool readTypedProperty(int coreIndex, void *value);
+    bool writeTypedProperty(int coreIndex, const void *value);
     QQmlVMEMetaObjectEndpoint *aliasEndpoints;
 
     v8::Persistent<v8::Array> varProperties;
@@ -265,6 +284,29 @@ QQmlVMEMetaObject *QQmlVMEMetaObject::get(QObject *obj)
     return 0;
 }
 
+/*!
+    Reads property \a coreIndex of \a o into \a value, if it is one of the declared
+    properties kept in typed storage.  Returns false, without reading anything,
+    for any other property.  \a value must point to an instance of the property's
+    type.
+*/
+bool QQmlVMEMetaObject::readTypedProperty(QObject *o, int coreIndex, void *value)
+{
+    QQmlVMEMetaObject *vmemo = get(o);
+    return vmemo && vmemo->readTypedProperty(coreIndex, value);
+}
+
+/*!
+    Writes \a value to property \a coreIndex of \a o and emits its change signal
+    as QMetaObject::WriteProperty would, if it is one of the declared properties
+    kept in typed storage.  Returns false for any other property.
+*/
+bool QQmlVMEMetaObject::writeTypedProperty(QObject *o, int coreIndex, const void *value)
+{
+    QQmlVMEMetaObject *vmemo = get(o);
+    return vmemo && vmemo->writeTypedProperty(coreIndex, value);
+}
+
 int QQmlVMEMetaObject::propOffset() const
 {
     return cache->propertyOffset();
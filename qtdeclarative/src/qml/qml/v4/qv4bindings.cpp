@@ -508,6 +508,8 @@ void QV4Bindings::subscriptionNotify(int id)
         Binding *binding = bindings + bindingRef->binding;
 
         if (binding->executedBlocks & bindingRef->blockMask) {
+            if (QQmlData::deferBindingUpdate(Binding::object(binding), binding))
+                continue;
             run(binding, QQmlPropertyPrivate::DontRemoveBinding);
         }
     }
@@ -1966,6 +1968,18 @@ void QV4Bindings::run(int instrIndex, quint32 &executedBlocks,
     }
     QML_V4_END_INSTR(LoadString, string_value)
 
+    QML_V4_BEGIN_INSTR(LoadColor, color_value)
+    {
+        Register &output = registers[instr->color_value.reg];
+        if (QQml_valueTypeProvider()->storeValueType(QMetaType::QColor, &instr->color_value.value,
+                                                     output.typeDataPtr(), output.dataSize())) {
+            COLOR_REGISTER(instr->color_value.reg);
+        } else {
+            output.setUndefined();
+        }
+    }
+    QML_V4_END_INSTR(LoadColor, color_value)
+
     QML_V4_BEGIN_INSTR(EnableV4Test, string_value)
     {
         testBindingSource = new QString((QChar *)(data + instr->string_value.offset), instr->string_value.length);
@@ -2354,8 +2368,10 @@ void QV4Bindings::run(int instrIndex, quint32 &executedBlocks,
 
             QQmlData::flushPendingBinding(object, instr->fetch.index);
 
-            void *argv[] = { reg.typeDataPtr(), 0 };
-            QMetaObject::metacall(object, QMetaObject::ReadProperty, instr->fetch.index, argv);
+            if (!QQmlVMEMetaObject::readTypedProperty(object, instr->fetch.index, reg.typeDataPtr())) {
+                void *argv[] = { reg.typeDataPtr(), 0 };
+                QMetaObject::metacall(object, QMetaObject::ReadProperty, instr->fetch.index, argv);
+            }
             if (valueType == FloatType) {
                 // promote floats
                 const double v = reg.getfloat();
@@ -2422,7 +2438,7 @@ void QV4Bindings::run(int instrIndex, quint32 &executedBlocks,
             QQmlVMEMetaObject *vmemo = QQmlVMEMetaObject::get(output);
             Q_ASSERT(vmemo);
             vmemo->setVMEProperty(instr->store.index, *data.gethandleptr());
-        } else {
+        } else if (!QQmlVMEMetaObject::writeTypedProperty(output, instr->store.index, data.typeDataPtr())) {
             int status = -1;
             void *argv[] = { data.typeDataPtr(), 0, &status, &storeFlags };
             QMetaObject::metacall(output, QMetaObject::WriteProperty,
@@ -389,7 +389,8 @@ void QV4CompilerPrivate::visitName(IR::Name *e)
             } else {
                 if (qmlVerboseCompiler())
                     qWarning() << "Discard unsupported property type:" << QMetaType::typeName(propTy);
-                discard(); // Unsupported type
+                discard(QString::fromLatin1("unsupported property type %1")
+                        .arg(QLatin1String(QMetaType::typeName(propTy)))); // Unsupported type
                 return;
             }
 
@@ -765,7 +766,10 @@ void QV4CompilerPrivate::visitBinop(IR::Binop *e)
                                  << "' and `"
                                  << IR::binaryOperator(e->right->type)
                                  << '\'';
-        discard();
+        discard(QString::fromLatin1("invalid operands to %1 (%2 and %3)")
+                .arg(QLatin1String(IR::opname(e->op)))
+                .arg(QLatin1String(IR::typeName(e->left->type)))
+                .arg(QLatin1String(IR::typeName(e->right->type))));
         return;
     }
 
@@ -927,7 +931,10 @@ void QV4CompilerPrivate::visitCall(IR::Call *call)
 
     if (qmlVerboseCompiler())
         qWarning() << "TODO:" << Q_FUNC_INFO << __LINE__;
-    discard();
+    if (IR::Name *name = call->base->asName())
+        discard(QString::fromLatin1("unsupported call to %1()").arg(*name->id));
+    else
+        discard(QLatin1String("unsupported function call"));
 }
 
 
@@ -956,6 +963,19 @@ void QV4CompilerPrivate::visitMove(IR::Move *s)
     if (targetTy == IR::FloatType)
         targetTy = IR::NumberType;
 
+    if (targetTy == IR::ColorType && s->source->asString()) {
+        // Parse constant colors at compile time
+        bool ok = false;
+        const unsigned rgba = QQml_colorProvider()->rgbaFromString(s->source->asString()->value.toString(), &ok);
+        if (ok) {
+            Instr::LoadColor i;
+            i.reg = dest;
+            i.value = rgba;
+            gen(i);
+            return;
+        }
+    }
+
     if (sourceTy != targetTy) {
         quint8 src = dest;
 
@@ -1133,7 +1153,9 @@ void QV4CompilerPrivate::visitMove(IR::Move *s)
                 gen(V4Instr::ResolveUrl, resolveUrl);
             }
         } else {
-            discard();
+            discard(QString::fromLatin1("cannot convert %1 to %2")
+                    .arg(QLatin1String(IR::typeName(sourceTy)))
+                    .arg(QLatin1String(IR::typeName(targetTy))));
         }
     } else {
         traceExpression(s->source, dest);
@@ -1258,6 +1280,7 @@ void QV4CompilerPrivate::resetInstanceState()
     pool.clear();
     currentReg = 0;
     invalidatable = false;
+    _discardReason.clear();
 }
 
 /*!
@@ -1284,8 +1307,10 @@ bool QV4CompilerPrivate::compile(QQmlJS::AST::Node *node)
 {
     resetInstanceState();
 
-    if (expression->property->type == -1)
+    if (expression->property->type == -1) {
+        _discardReason = QLatin1String("unknown property type");
         return false;
+    }
 
     AST::SourceLocation location;
     if (AST::ExpressionNode *astExpression = node->expressionCast()) {
@@ -1295,17 +1320,22 @@ bool QV4CompilerPrivate::compile(QQmlJS::AST::Node *node)
             location = block->lbraceToken;
         else if (AST::IfStatement *ifStmt = AST::cast<AST::IfStatement *>(astStatement))
             location = ifStmt->ifToken;
-        else
+        else {
+            _discardReason = QLatin1String("unsupported statement");
             return false;
+        }
     } else {
+        _discardReason = QLatin1String("unsupported statement");
         return false;
     }
 
     IR::Function thisFunction(&pool), *function = &thisFunction;
 
     QV4IRBuilder irBuilder(expression, engine);
-    if (!irBuilder(function, node, &invalidatable))
+    if (!irBuilder(function, node, &invalidatable)) {
+        _discardReason = irBuilder.discardReason();
         return false;
+    }
 
     bool discarded = false;
     qSwap(_discarded, discarded);
@@ -1328,6 +1358,11 @@ bool QV4CompilerPrivate::compile(QQmlJS::AST::Node *node)
         qerr << endl;
     }
 
+    if (!discarded && subscriptionIds.count() > 0xFFFF)
+        _discardReason = QLatin1String("too many subscriptions");
+    else if (!discarded && registerCount > 31)
+        _discardReason = QLatin1String("too many registers");
+
     if (discarded || subscriptionIds.count() > 0xFFFF || registerCount > 31)
         return false;
 
@@ -1449,8 +1484,10 @@ int QV4Compiler::compile(const Expression &expression, QQmlEnginePrivate *engine
 {
     if (!expression.expression.asAST()) return false;
 
-    if (qmlDisableOptimizer() || !qmlEnableV4)
+    if (qmlDisableOptimizer() || !qmlEnableV4) {
+        d->_discardReason = QLatin1String("optimizer disabled");
         return -1;
+    }
 
     d->expression = &expression;
     d->engine = engine;
@@ -1463,6 +1500,15 @@ int QV4Compiler::compile(const Expression &expression, QQmlEnginePrivate *engine
     }
 }
 
+/*!
+Returns why the last call to compile() did not produce a binding, or an
+empty string if it did.
+*/
+QString QV4Compiler::discardReason() const
+{
+    return d->_discardReason;
+}
+
 QByteArray QV4CompilerPrivate::buildSignalTable() const
 {
     QHash<int, QList<QPair<int, quint32> > > table;
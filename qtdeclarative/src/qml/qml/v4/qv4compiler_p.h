@@ -89,6 +89,9 @@ public:
     // -1 on failure, otherwise the binding index to use
     int compile(const Expression &, QQmlEnginePrivate *, bool *);
 
+    // Why the last compile() failed
+    QString discardReason() const;
+
     // Returns the compiled program
     QByteArray program() const;
 
@@ -123,6 +123,8 @@ public:
 
     QString contextName() const { return QLatin1String("$$$SCOPE_") + QString::number((quintptr)expression->context, 16); }
 
+    QString _discardReason;
+
     bool compile(QQmlJS::AST::Node *);
 
     bool isInvalidatable() const { return invalidatable; }
@@ -227,6 +229,7 @@ private:
     QQmlJS::IR::Function *_function;
     QQmlJS::IR::BasicBlock *_block;
     void discard() { _discarded = true; }
+    void discard(const QString &reason) { if (_discardReason.isEmpty()) _discardReason = reason; _discarded = true; }
     bool _discarded;
     quint8 currentReg;
     quint8 registerCount;
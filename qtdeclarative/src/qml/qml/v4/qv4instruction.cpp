@@ -309,6 +309,9 @@ void Bytecode::dump(const V4Instr *i, int address) const
     case V4Instr::LoadString:
         INSTR_DUMP << '\t' << "LoadString" << "\t\t" << "String_DataIndex(" << i->string_value.offset << ") String_Length(" << i->string_value.length << ") -> Output_Register(" << i->string_value.reg << ')';
         break;
+    case V4Instr::LoadColor:
+        INSTR_DUMP << '\t' << "LoadColor" << "\t\t" << "Constant(" << i->color_value.value << ") -> Output_Reg(" << i->color_value.reg << ')';
+        break;
     case V4Instr::EnableV4Test:
         INSTR_DUMP << '\t' << "EnableV4Test" << "\t\t" << "String_DataIndex(" << i->string_value.offset << ") String_Length(" << i->string_value.length << ')';
         break;
@@ -136,6 +136,7 @@ QT_BEGIN_NAMESPACE
     F(LoadInt, int_value) \
     F(LoadBool, bool_value) \
     F(LoadString, string_value) \
+    F(LoadColor, color_value) \
     F(EnableV4Test, string_value) \
     F(TestV4Store, storetest) \
     F(BitAndInt, binaryop) \
@@ -326,6 +327,12 @@ union Q_AUTOTEST_EXPORT V4Instr {
         bool value;
     };
 
+    struct instr_color_value {
+        QML_V4_INSTR_HEADER
+        qint8 reg;
+        quint32 value;
+    };
+
     struct instr_string_value {
         QML_V4_INSTR_HEADER
         qint8 reg;
@@ -405,6 +412,7 @@ union Q_AUTOTEST_EXPORT V4Instr {
     instr_number_value number_value;
     instr_int_value int_value;
     instr_bool_value bool_value;
+    instr_color_value color_value;
     instr_string_value string_value;
     instr_binaryop binaryop;
     instr_unaryop unaryop;
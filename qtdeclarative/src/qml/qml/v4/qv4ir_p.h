@@ -136,6 +136,7 @@ enum AluOp {
     OpOr
 };
 AluOp binaryOperator(int op);
+const char *opname(AluOp op);
 
 enum Type {
     InvalidType,
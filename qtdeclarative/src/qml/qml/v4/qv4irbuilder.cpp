@@ -92,7 +92,7 @@ static IR::Type irTypeFromVariantType(int t, QQmlEnginePrivate *engine)
 QV4IRBuilder::QV4IRBuilder(const QV4Compiler::Expression *expr,
                            QQmlEnginePrivate *engine)
 : m_expression(expr), m_engine(engine), _function(0), _block(0), _discard(false),
-  _invalidatable(false)
+  _invalidatable(false), _conditionalType(IR::InvalidType)
 {
 }
 
@@ -100,9 +100,17 @@ bool QV4IRBuilder::operator()(QQmlJS::IR::Function *function,
                               QQmlJS::AST::Node *ast, bool *invalidatable)
 {
     bool discarded = false;
+    _discardReason.clear();
 
     IR::BasicBlock *block = function->newBasicBlock();
 
+    // Colors are the only type where it pays to specialise the branches of
+    // a conditional binding: "cond ? \"red\" : \"blue\"" then loads two
+    // constant colors instead of parsing a string on every evaluation.
+    _conditionalType = IR::InvalidType;
+    if (m_expression->property->core.propType == QMetaType::QColor)
+        _conditionalType = IR::ColorType;
+
     qSwap(_discard, discarded);
     qSwap(_function, function);
     qSwap(_block, block);
@@ -173,18 +181,40 @@ void QV4IRBuilder::discard()
     _discard = true; 
 }
 
+/*
+    Records why the binding cannot be compiled.  Only the first reason is
+    kept, as it describes the innermost unsupported expression.
+*/
+void QV4IRBuilder::reject(const QString &reason)
+{
+    if (_discardReason.isEmpty())
+        _discardReason = reason;
+}
+
 QV4IRBuilder::ExprResult 
 QV4IRBuilder::expression(AST::ExpressionNode *ast)
 {
     ExprResult r;
     if (ast) {
+        IR::Type conditionalType = IR::InvalidType;
+        if (ast->kind != AST::Node::Kind_ConditionalExpression &&
+            ast->kind != AST::Node::Kind_NestedExpression)
+            qSwap(_conditionalType, conditionalType);
+
         qSwap(_expr, r);
         accept(ast);
         qSwap(_expr, r);
 
-        if (r.is(IR::InvalidType))
+        if (ast->kind != AST::Node::Kind_ConditionalExpression &&
+            ast->kind != AST::Node::Kind_NestedExpression)
+            qSwap(_conditionalType, conditionalType);
+
+        if (r.is(IR::InvalidType)) {
+            const AST::SourceLocation location = ast->firstSourceLocation();
+            reject(QString::fromLatin1("unsupported expression at %1:%2")
+                   .arg(location.startLine).arg(location.startColumn));
             discard();
-        else {
+        } else {
             Q_ASSERT(r.hint == r.format);
         }
     }
@@ -196,10 +226,13 @@ void QV4IRBuilder::condition(AST::ExpressionNode *ast, IR::BasicBlock *iftrue, I
 {
     if (! ast)
         return;
+    IR::Type conditionalType = IR::InvalidType;
+    qSwap(_conditionalType, conditionalType);
     ExprResult r(iftrue, iffalse);
     qSwap(_expr, r);
     accept(ast);
     qSwap(_expr, r);
+    qSwap(_conditionalType, conditionalType);
 
     if (r.format != ExprResult::cx) {
         if (! r.code)
@@ -227,9 +260,12 @@ QV4IRBuilder::statement(AST::Statement *ast)
         accept(ast);
         qSwap(_expr, r);
 
-        if (r.is(IR::InvalidType))
+        if (r.is(IR::InvalidType)) {
+            const AST::SourceLocation location = ast->firstSourceLocation();
+            reject(QString::fromLatin1("unsupported statement at %1:%2")
+                   .arg(location.startLine).arg(location.startColumn));
             discard();
-        else {
+        } else {
             Q_ASSERT(r.hint == r.format);
         }
     }
@@ -443,6 +479,7 @@ bool QV4IRBuilder::visit(AST::IdentifierExpression *ast)
         _expr.code = _block->CONST(IR::UndefinedType, 0); // ### undefined value
     } else if (m_engine->v8engine()->illegalNames().contains(name) ) {
         if (qmlVerboseCompiler()) qWarning() << "*** illegal symbol:" << name;
+        reject(QString::fromLatin1("illegal symbol \"%1\"").arg(name));
         return false;
     } else if (const QQmlScript::Object *obj = m_expression->ids->value(name)) {
         IR::Name *code = _block->ID_OBJECT(name, obj, line, column);
@@ -479,6 +516,7 @@ bool QV4IRBuilder::visit(AST::IdentifierExpression *ast)
                 if (data && data->hasRevision()) {
                     if (qmlVerboseCompiler()) 
                         qWarning() << "*** versioned symbol:" << name;
+                    reject(QString::fromLatin1("versioned symbol \"%1\"").arg(name));
                     discard();
                     return false;
                 }
@@ -499,6 +537,7 @@ bool QV4IRBuilder::visit(AST::IdentifierExpression *ast)
                 if (data && data->hasRevision()) {
                     if (qmlVerboseCompiler()) 
                         qWarning() << "*** versioned symbol:" << name;
+                    reject(QString::fromLatin1("versioned symbol \"%1\"").arg(name));
                     discard();
                     return false;
                 }
@@ -510,8 +549,11 @@ bool QV4IRBuilder::visit(AST::IdentifierExpression *ast)
                 } 
             }
 
-            if (!found && qmlVerboseCompiler())
-                qWarning() << "*** unknown symbol:" << name;
+            if (!found) {
+                if (qmlVerboseCompiler())
+                    qWarning() << "*** unknown symbol:" << name;
+                reject(QString::fromLatin1("unknown symbol \"%1\"").arg(name));
+            }
         }
     }
 
@@ -622,8 +664,11 @@ bool QV4IRBuilder::visit(AST::FieldMemberExpression *ast)
                     QQmlPropertyCache *cache = m_engine->cache(attachedMeta);
                     QQmlPropertyData *data = cache->property(name, 0, 0);
 
-                    if (!data || data->isFunction())
-                        return false; // Don't support methods (or non-existing properties ;)
+                    if (!data || data->isFunction()) {
+                        // Don't support methods (or non-existing properties ;)
+                        reject(QString::fromLatin1("\"%1\" is a method or unknown property").arg(name));
+                        return false;
+                    }
 
                     if (!data->isFinal())
                         _invalidatable = true;
@@ -664,8 +709,11 @@ bool QV4IRBuilder::visit(AST::FieldMemberExpression *ast)
                     if (!cache) return false;
                     QQmlPropertyData *data = cache->property(name, 0, 0);
 
-                    if (!data || data->isFunction())
-                        return false; // Don't support methods (or non-existing properties ;)
+                    if (!data || data->isFunction()) {
+                        // Don't support methods (or non-existing properties ;)
+                        reject(QString::fromLatin1("\"%1\" is a method or unknown property").arg(name));
+                        return false;
+                    }
 
                     if (!data->isFinal())
                         _invalidatable = true;
@@ -683,12 +731,16 @@ bool QV4IRBuilder::visit(AST::FieldMemberExpression *ast)
 
                 QQmlPropertyData *data = cache->property(name, 0, 0);
 
-                if (!data || data->isFunction())
-                    return false; // Don't support methods (or non-existing properties ;)
+                if (!data || data->isFunction()) {
+                    // Don't support methods (or non-existing properties ;)
+                    reject(QString::fromLatin1("\"%1\" is a method or unknown property").arg(name));
+                    return false;
+                }
 
                 if (data->hasRevision()) {
                     if (qmlVerboseCompiler()) 
                         qWarning() << "*** versioned symbol:" << name;
+                    reject(QString::fromLatin1("versioned symbol \"%1\"").arg(name));
                     discard();
                     return false;
                 }
@@ -899,8 +951,13 @@ void QV4IRBuilder::binop(AST::BinaryExpression *ast, ExprResult left, ExprResult
             implicitCvt(right, t);
         }
     } else if ((left.type() != IR::ObjectType && left.type() != IR::NullType) ||
-               (right.type() != IR::ObjectType && right.type() != IR::NullType))
+               (right.type() != IR::ObjectType && right.type() != IR::NullType)) {
+        reject(QString::fromLatin1("unsupported operands to %1 (%2 and %3)")
+               .arg(QLatin1String(IR::opname(IR::binaryOperator(ast->op))))
+               .arg(QLatin1String(IR::typeName(left.type())))
+               .arg(QLatin1String(IR::typeName(right.type()))));
         return;
+    }
 
     if (_expr.hint == ExprResult::cx) {
         _expr.format = ExprResult::cx;
@@ -1088,7 +1145,9 @@ bool QV4IRBuilder::visit(AST::BinaryExpression *ast)
             return false;
 
         if (left.isPrimitive() && right.isPrimitive()) {
-            if (left.type() == IR::StringType || right.type() == IR::StringType) {
+            if (left.type() == IR::StringType || right.type() == IR::StringType ||
+                left.type() == IR::UrlType || right.type() == IR::UrlType) {
+                // Urls are concatenated as strings, as they would be in JavaScript
                 implicitCvt(left, IR::StringType);
                 implicitCvt(right, IR::StringType);
             }
@@ -1152,17 +1211,26 @@ bool QV4IRBuilder::visit(AST::ConditionalExpression *ast)
 
     qSwap(_block, iftrue);
     ExprResult ok = expression(ast->ok);
+    if (_conditionalType == IR::ColorType && ok.is(IR::StringType))
+        implicitCvt(ok, IR::ColorType);
     _block->MOVE(r, ok);
     _block->JUMP(endif);
     qSwap(_block, iftrue);
 
     qSwap(_block, iffalse);
     ExprResult ko = expression(ast->ko);
+    if (_conditionalType == IR::ColorType && ko.is(IR::StringType))
+        implicitCvt(ko, IR::ColorType);
     _block->MOVE(r, ko);
     _block->JUMP(endif);
     qSwap(_block, iffalse);
 
-    r->type = maxType(ok.type(), ko.type());
+    // Keep the type of branches that agree, so that colors and urls are
+    // not needlessly converted to strings and back.
+    if (ok.type() == ko.type())
+        r->type = ok.type();
+    else
+        r->type = maxType(ok.type(), ko.type());
     _expr.code = r;
 
     _block = endif;
@@ -1229,6 +1297,7 @@ bool QV4IRBuilder::visit(AST::IfStatement *ast)
 {
     if (! ast->ko) {
         // This is an if statement without an else branch.
+        reject(QLatin1String("if statement without an else branch"));
         discard();
     } else {
         IR::BasicBlock *iftrue = _function->newBasicBlock();
@@ -55,6 +55,8 @@ public:
 
     bool operator()(QQmlJS::IR::Function *, QQmlJS::AST::Node *, bool *invalidatable);
 
+    QString discardReason() const { return _discardReason; }
+
 protected:
     struct ExprResult {
         enum Format {
@@ -87,10 +89,10 @@ protected:
             switch (type()) {
             case QQmlJS::IR::UndefinedType: // ### TODO
             case QQmlJS::IR::NullType: // ### TODO
-            case QQmlJS::IR::UrlType: // ### TODO
                 return false;
 
             case QQmlJS::IR::StringType:
+            case QQmlJS::IR::UrlType:
             case QQmlJS::IR::BoolType:
             case QQmlJS::IR::IntType:
             case QQmlJS::IR::FloatType:
@@ -222,6 +224,7 @@ private:
     bool buildName(QList<QStringRef> &name, QQmlJS::AST::Node *node,
                    QList<QQmlJS::AST::ExpressionNode *> *nodes);
     void discard();
+    void reject(const QString &reason);
 
     const QV4Compiler::Expression *m_expression;
     QQmlEnginePrivate *m_engine;
@@ -230,6 +233,10 @@ private:
     QQmlJS::IR::BasicBlock *_block;
     bool _discard;
     bool _invalidatable;
+    QString _discardReason;
+
+    // The type a conditional expression in tail position should produce
+    QQmlJS::IR::Type _conditionalType;
 
     ExprResult _expr;
 };
@@ -46,6 +46,7 @@
 #include <private/qqmlcompiler_p.h>
 #include <private/qqmlproperty_p.h>
 #include <private/qqmlexpression_p.h>
+#include <private/qqmldata_p.h>
 #include <private/qobject_p.h>
 #include <private/qqmltrace_p.h>
 #include <private/qqmlprofilerservice_p.h>
@@ -170,12 +171,16 @@ void QV8Bindings::Binding::update(QQmlPropertyPrivate::WriteFlags flags)
         DeleteWatcher watcher(this);
         ep->referenceScarceResources();
 
+        // The dependencies of a static binding only need to be captured by the
+        // first evaluation that succeeds
+        bool captureGuards = !instruction->isStatic || hasError() || !hasGuards();
+
         v8::HandleScope handle_scope;
         v8::Context::Scope scope(ep->v8engine()->context());
         v8::Local<v8::Value> result =
             evaluate(context,
                      v8::Handle<v8::Function>::Cast(parent->functions()->Get(instruction->value)),
-                     &isUndefined);
+                     0, 0, &isUndefined, captureGuards);
 
         trace.event("writing V8 result");
         bool needsErrorLocationData = false;
@@ -217,6 +222,8 @@ QString QV8Bindings::Binding::expressionIdentifier(QQmlJavaScriptExpression *e)
 void QV8Bindings::Binding::expressionChanged(QQmlJavaScriptExpression *e)
 {
     Binding *This = static_cast<Binding *>(e);
+    if (QQmlData::deferBindingUpdate(Binding::object(This), This))
+        return;
     This->update(QQmlPropertyPrivate::DontRemoveBinding);
 }
 
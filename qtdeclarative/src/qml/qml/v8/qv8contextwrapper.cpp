@@ -61,6 +61,20 @@ public:
     inline QQmlContextData *getContext() const;
     inline QObject *getScopeObject() const;
 
+    // Ids resolved in the resource's own context, cached by the symbol id of the
+    // property name.  Ids are only added once, when the context's propertyNames
+    // are set, so an entry remains valid for as long as they are unchanged.
+    struct IdLookup {
+        IdLookup() : symbolId(0), names(0), index(-1) {}
+        quint32 symbolId;
+        QQmlIntegerCache *names;
+        int index;
+    };
+    enum { IdLookupCacheSize = 4 };
+    inline int cachedIdIndex(const QHashedV8String &) const;
+    inline void cacheIdIndex(const QHashedV8String &, int);
+    IdLookup idLookups[IdLookupCacheSize];
+
     quint32 isSharedContext:1;
     quint32 hasSubContexts:1;
     quint32 readOnly:1;
@@ -129,6 +143,32 @@ QQmlContextData *QV8ContextResource::getContext() const
     return sc->context;
 }
 
+// Returns the index of the id named \a name in the resource's context, if it
+// has been resolved before, or -1
+int QV8ContextResource::cachedIdIndex(const QHashedV8String &name) const
+{
+    if (!name.symbolId() || isSharedContext || hasSubContexts)
+        return -1;
+
+    const IdLookup &lookup = idLookups[name.symbolId() & (IdLookupCacheSize - 1)];
+    if (lookup.symbolId != name.symbolId() || !context ||
+        lookup.names != context->propertyNames || lookup.index >= context->idValueCount)
+        return -1;
+
+    return lookup.index;
+}
+
+void QV8ContextResource::cacheIdIndex(const QHashedV8String &name, int index)
+{
+    if (!name.symbolId() || isSharedContext || hasSubContexts)
+        return;
+
+    IdLookup &lookup = idLookups[name.symbolId() & (IdLookupCacheSize - 1)];
+    lookup.symbolId = name.symbolId();
+    lookup.names = context->propertyNames;
+    lookup.index = index;
+}
+
 QV8ContextWrapper::QV8ContextWrapper()
 : m_engine(0)
 {
@@ -270,6 +310,16 @@ v8::Handle<v8::Value> QV8ContextWrapper::Getter(v8::Local<v8::String> property,
 
     QHashedV8String propertystring(property);
 
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine->engine());
+
+    // Ids of the innermost context take precedence over everything but type
+    // names, which cannot clash as ids must start with a lower case letter
+    int idIndex = resource->cachedIdIndex(propertystring);
+    if (idIndex != -1) {
+        ep->captureProperty(&context->idValues[idIndex].bindings);
+        return engine->newQObject(context->idValues[idIndex]);
+    }
+
     if (context->imports && QV8Engine::startsWithUpper(property)) {
         // Search for attached properties, enums and imported scripts
         QQmlTypeNameCache::Result r = context->imports->query(propertystring);
@@ -292,7 +342,6 @@ v8::Handle<v8::Value> QV8ContextWrapper::Getter(v8::Local<v8::String> property,
         // Fall through
     }
 
-    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine->engine());
     QV8QObjectWrapper *qobjectWrapper = engine->qobjectWrapper();
 
     while (context) {
@@ -304,6 +353,9 @@ v8::Handle<v8::Value> QV8ContextWrapper::Getter(v8::Local<v8::String> property,
 
                 if (propertyIdx < context->idValueCount) {
 
+                    if (context == expressionContext)
+                        resource->cacheIdIndex(propertystring, propertyIdx);
+
                     ep->captureProperty(&context->idValues[propertyIdx].bindings);
                     return engine->newQObject(context->idValues[propertyIdx]);
                 } else {
@@ -53,6 +53,7 @@
 #include <private/qqmlaccessors_p.h>
 #include <private/qqmlexpression_p.h>
 #include <private/qqmlglobal_p.h>
+#include <private/qqmlprofilerservice_p.h>
 
 #include <QtQml/qjsvalue.h>
 #include <QtCore/qjsonarray.h>
@@ -186,8 +187,9 @@ QV8SignalHandlerResource::QV8SignalHandlerResource(QV8Engine *engine, QObject *o
 static QAtomicInt objectIdCounter(1);
 
 QV8QObjectWrapper::QV8QObjectWrapper()
-: m_engine(0), m_id(objectIdCounter.fetchAndAddOrdered(1))
+: m_engine(0), m_id(objectIdCounter.fetchAndAddOrdered(1)), m_lookupHits(0), m_lookupMisses(0)
 {
+    ::memset(m_propertyLookups, 0, sizeof(m_propertyLookups));
 }
 
 QV8QObjectWrapper::~QV8QObjectWrapper()
@@ -473,6 +475,56 @@ static v8::Handle<v8::Value> LoadProperty(QV8Engine *engine, QObject *object,
     }
 }
 
+/*
+Returns the property named \a property in \a cache, for objects without a
+VME meta object.  Such lookups depend only on the cache and the name, so the
+result is remembered in a direct mapped table keyed by the property name's
+symbol id, the cache's lookup id and the lookup chain id of the cache and its
+parents.  As lookup ids are never reused, entries of caches that have been
+destroyed, or that have been modified directly or through a parent, simply
+never match again.
+*/
+QQmlPropertyData *QV8QObjectWrapper::lookupProperty(QQmlPropertyCache *cache, QObject *object,
+                                                    const QHashedV8String &property)
+{
+    const quint32 cacheId = cache->lookupId();
+    const quint32 chainId = cache->lookupChainId();
+    const quint32 symbolId = property.symbolId();
+    PropertyLookup &lookup = m_propertyLookups[(cacheId * 31 + symbolId) & (PropertyLookupCacheSize - 1)];
+
+    QQmlPropertyData *result;
+    if (lookup.cacheId == cacheId && lookup.chainId == chainId && lookup.symbolId == symbolId) {
+        ++m_lookupHits;
+        result = lookup.property;
+    } else {
+        ++m_lookupMisses;
+        result = cache->property(property, object, 0);
+        lookup.cacheId = cacheId;
+        lookup.chainId = chainId;
+        lookup.symbolId = symbolId;
+        lookup.property = result;
+    }
+
+    if (((m_lookupHits + m_lookupMisses) & 0xfff) == 0)
+        QQmlProfilerService::propertyLookups(m_lookupHits, m_lookupMisses);
+
+    return result;
+}
+
+QV8QObjectWrapper::LookupStatistics QV8QObjectWrapper::lookupStatistics() const
+{
+    LookupStatistics rv;
+    rv.hits = m_lookupHits;
+    rv.misses = m_lookupMisses;
+    return rv;
+}
+
+void QV8QObjectWrapper::resetLookupStatistics()
+{
+    m_lookupHits = 0;
+    m_lookupMisses = 0;
+}
+
 v8::Handle<v8::Value> QV8QObjectWrapper::GetProperty(QV8Engine *engine, QObject *object, 
                                                      v8::Handle<v8::Value> *objectHandle, 
                                                      const QHashedV8String &property,
@@ -522,8 +574,12 @@ v8::Handle<v8::Value> QV8QObjectWrapper::GetProperty(QV8Engine *engine, QObject
     QQmlPropertyData *result = 0;
     {
         QQmlData *ddata = QQmlData::get(object, false);
-        if (ddata && ddata->propertyCache)
-            result = ddata->propertyCache->property(property, object, context);
+        if (ddata && ddata->propertyCache) {
+            if (!ddata->hasVMEMetaObject && property.symbolId())
+                result = engine->qobjectWrapper()->lookupProperty(ddata->propertyCache, object, property);
+            else
+                result = ddata->propertyCache->property(property, object, context);
+        }
         if (!result)
             result = QQmlPropertyCache::property(engine->engine(), object, property, context, local);
     }
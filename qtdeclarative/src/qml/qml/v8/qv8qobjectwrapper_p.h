@@ -113,6 +113,13 @@ public:
         m_javaScriptOwnedWeakQObjects.remove(resource);
     }
 
+    struct LookupStatistics {
+        quint32 hits;
+        quint32 misses;
+    };
+    LookupStatistics lookupStatistics() const;
+    void resetLookupStatistics();
+
 private:
     friend class QQmlPropertyCache;
     friend class QV8QObjectConnectionList;
@@ -139,6 +146,8 @@ private:
     static QPair<QObject *, int> ExtractQtSignal(QV8Engine *, v8::Handle<v8::Object>);
     static void WeakQObjectReferenceCallback(v8::Persistent<v8::Value> handle, void *wrapper);
 
+    QQmlPropertyData *lookupProperty(QQmlPropertyCache *, QObject *, const QHashedV8String &);
+
     QV8Engine *m_engine;
     quint32 m_id;
     v8::Persistent<v8::Function> m_constructor;
@@ -153,6 +162,17 @@ private:
     typedef QHash<QObject *, QV8QObjectInstance *> TaintedHash;
     TaintedHash m_taintedObjects;
     QIntrusiveList<QV8QObjectResource, &QV8QObjectResource::weakResource> m_javaScriptOwnedWeakQObjects;
+
+    struct PropertyLookup {
+        quint32 cacheId;
+        quint32 chainId;
+        quint32 symbolId;
+        QQmlPropertyData *property;
+    };
+    enum { PropertyLookupCacheSize = 256 };
+    PropertyLookup m_propertyLookups[PropertyLookupCacheSize];
+    quint32 m_lookupHits;
+    quint32 m_lookupMisses;
 };
 
 v8::Handle<v8::Value> QV8QObjectWrapper::getProperty(QObject *object, const QHashedV8String &string,  
@@ -59,6 +59,9 @@ QT_BEGIN_NAMESPACE
 //    + Date
 //    + RegExp
 // <quint8 type><quint24 size><data>
+//
+// Arrays containing only numbers are written as a block of doubles, rather
+// than as individually tagged values.
 
 enum Type {
     WorkerUndefined,
@@ -75,7 +78,8 @@ enum Type {
     WorkerDate,
     WorkerRegexp,
     WorkerListModel,
-    WorkerSequence
+    WorkerSequence,
+    WorkerNumberArray
 };
 
 static inline quint32 valueheader(Type type, quint32 size = 0)
@@ -134,6 +138,29 @@ static inline void *popPtr(const char *&data)
     return rv;
 }
 
+// Writes array as a WorkerNumberArray.  Returns false, leaving data unchanged, if
+// any of its elements is not a number.
+static bool serializeNumberArray(QByteArray &data, v8::Handle<v8::Array> array, quint32 length)
+{
+    const int offset = data.size();
+    data.resize(offset + sizeof(quint32) + length * sizeof(double));
+
+    char *buffer = data.data() + offset;
+    *((quint32 *)buffer) = valueheader(WorkerNumberArray, length);
+    double *values = (double *)(buffer + sizeof(quint32));
+
+    for (quint32 ii = 0; ii < length; ++ii) {
+        v8::Local<v8::Value> value = array->Get(ii);
+        if (!value->IsNumber()) {
+            data.resize(offset);
+            return false;
+        }
+        values[ii] = value->NumberValue();
+    }
+
+    return true;
+}
+
 // XXX TODO: Check that worker script is exception safe in the case of 
 // serialization/deserialization failures
 
@@ -177,6 +204,8 @@ void QV8Worker::serialize(QByteArray &data, v8::Handle<v8::Value> v, QV8Engine *
             push(data, valueheader(WorkerUndefined));
             return;
         }
+        if (length && array->Get(0)->IsNumber() && serializeNumberArray(data, array, length))
+            return;
         reserve(data, sizeof(quint32) + length * sizeof(quint32));
         push(data, valueheader(WorkerArray, length));
         for (uint32_t ii = 0; ii < length; ++ii)
@@ -317,6 +346,16 @@ v8::Handle<v8::Value> QV8Worker::deserialize(const char *&data, QV8Engine *engin
         }
         return array;
     }
+    case WorkerNumberArray:
+    {
+        quint32 size = headersize(header);
+        const double *values = (const double *)data;
+        v8::Local<v8::Array> array = v8::Array::New(size);
+        for (quint32 ii = 0; ii < size; ++ii)
+            array->Set(ii, v8::Number::New(values[ii]));
+        data += size * sizeof(double);
+        return array;
+    }
     case WorkerObject:
     {
         quint32 size = headersize(header);
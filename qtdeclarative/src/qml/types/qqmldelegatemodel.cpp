@@ -54,6 +54,11 @@
 
 QT_BEGIN_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(qmlDelegateReuse, QML_DELEGATE_REUSE)
+
+// Upper bound on the number of released delegates kept around for reuse.
+static const int qmlReusableItemLimit = 64;
+
 class QQmlDelegateModelEngineData : public QV8Engine::Deletable
 {
 public:
@@ -166,12 +171,14 @@ QQmlDelegateModelPrivate::QQmlDelegateModelPrivate(QQmlContext *ctxt)
     , m_filterGroup(QStringLiteral("items"))
     , m_count(0)
     , m_groupCount(Compositor::MinimumGroupCount)
+    , m_reuseGeneration(0)
     , m_compositorGroup(Compositor::Cache)
     , m_complete(false)
     , m_delegateValidated(false)
     , m_reset(false)
     , m_transaction(false)
     , m_incubatorCleanupScheduled(false)
+    , m_reuseItems(qmlDelegateReuse())
     , m_cacheItems(0)
     , m_items(0)
     , m_persistedItems(0)
@@ -231,6 +238,16 @@ QQmlDelegateModel::~QQmlDelegateModel()
         else if (cacheItem->incubationTask)
             cacheItem->incubationTask->vdm = 0;
     }
+
+    foreach (QQmlDelegateModelItem *cacheItem, d->m_reusableItems) {
+        delete cacheItem->object;
+
+        cacheItem->object = 0;
+        cacheItem->contextData->destroy();
+        cacheItem->contextData = 0;
+        cacheItem->scriptRef -= 1;
+        delete cacheItem;
+    }
 }
 
 
@@ -327,6 +344,7 @@ void QQmlDelegateModel::setModel(const QVariant &model)
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
+    d->clearReusableItems();
     d->m_adaptorModel.setModel(model, this, d->m_context->engine());
     d->m_adaptorModel.replaceWatchedRoles(QList<QByteArray>(), d->m_watchedRoles);
     for (int i = 0; d->m_parts && i < d->m_parts->models.count(); ++i) {
@@ -362,6 +380,7 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
         return;
     }
     bool wasValid = d->m_delegate != 0;
+    d->clearReusableItems();
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
     if (wasValid && d->m_complete) {
@@ -422,6 +441,7 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     const bool changed = d->m_adaptorModel.rootIndex != modelIndex;
     if (changed || !d->m_adaptorModel.isValid()) {
         const int oldCount = d->m_count;
+        d->clearReusableItems();
         d->m_adaptorModel.rootIndex = modelIndex;
         if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim())  // The previous root index was invalidated, so we need to reconnect the model.
             d->m_adaptorModel.setModel(d->m_adaptorModel.list.list(), this, d->m_context->engine());
@@ -475,6 +495,39 @@ QVariant QQmlDelegateModel::parentModelIndex() const
     return d->m_adaptorModel.parentModelIndex();
 }
 
+/*!
+    \qmlproperty bool QtQml.Models2::DelegateModel::reuseItems
+
+    This property holds whether delegate instances released by a view are kept and reused
+    for other model indexes instead of being destroyed.
+
+    A reused delegate keeps its state; only \c index and the model roles are updated.
+    Delegates can reset any other state in the \c DelegateModel.onReused attached signal
+    handler, which is emitted when an instance is handed out again.  The
+    \c DelegateModel.onPooled handler is emitted when an instance is released into the pool.
+
+    Delegates created from object list models are never reused.
+
+    The default value is false, unless the \c QML_DELEGATE_REUSE environment variable is set.
+*/
+
+bool QQmlDelegateModel::reuseItems() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_reuseItems;
+}
+
+void QQmlDelegateModel::setReuseItems(bool reuse)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_reuseItems == reuse)
+        return;
+    d->m_reuseItems = reuse;
+    if (!reuse)
+        d->clearReusableItems();
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlproperty int QtQml.Models2::DelegateModel::count
 */
@@ -495,6 +548,9 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
 
     if (QQmlDelegateModelItem *cacheItem = QQmlDelegateModelItem::dataForObject(object)) {
         if (cacheItem->releaseObject()) {
+            if (cacheItem->object == object && poolItem(cacheItem))
+                return QQmlInstanceModel::Destroyed;
+
             cacheItem->destroyObject();
             emitDestroyingItem(object);
             if (cacheItem->incubationTask) {
@@ -824,6 +880,63 @@ void QQmlDelegateModelPrivate::removeCacheItem(QQmlDelegateModelItem *cacheItem)
     Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
 }
 
+/*
+    Detaches a released delegate instance from the cache and keeps it for reuse by a later
+    call to object() instead of destroying it.  Only plain delegates that nothing but the
+    view references are pooled; packages, object list models and items still incubating or
+    held by script are destroyed as before.
+*/
+bool QQmlDelegateModelPrivate::poolItem(QQmlDelegateModelItem *cacheItem)
+{
+    if (!m_reuseItems
+            || m_reusableItems.count() >= qmlReusableItemLimit
+            || cacheItem->reuseGeneration != m_reuseGeneration
+            || cacheItem->incubationTask
+            || cacheItem->scriptRef != 1
+            || (cacheItem->groups & Compositor::UnresolvedFlag)
+            || m_adaptorModel.hasProxyObject()
+            || qmlobject_cast<QQuickPackage *>(cacheItem->object)) {
+        return false;
+    }
+
+    emitDestroyingItem(cacheItem->object);
+    removeCacheItem(cacheItem);
+    m_reusableItems.append(cacheItem);
+
+    if (cacheItem->attached)
+        emit cacheItem->attached->pooled();
+    return true;
+}
+
+QQmlDelegateModelItem *QQmlDelegateModelPrivate::takeReusableItem(int modelIndex)
+{
+    while (modelIndex >= 0 && !m_reusableItems.isEmpty()) {
+        QQmlDelegateModelItem *cacheItem = m_reusableItems.takeLast();
+        if (cacheItem->recycle(m_adaptorModel, modelIndex))
+            return cacheItem;
+        cacheItem->destroyObject();
+        cacheItem->Dispose();
+    }
+    return 0;
+}
+
+/*
+    Destroys all pooled delegate instances.  Called whenever the delegate, model or root
+    index changes, after which the pooled instances no longer match what object() would
+    create.
+*/
+void QQmlDelegateModelPrivate::clearReusableItems()
+{
+    ++m_reuseGeneration;
+
+    const QList<QQmlDelegateModelItem *> reusableItems = m_reusableItems;
+    m_reusableItems.clear();
+    foreach (QQmlDelegateModelItem *cacheItem, reusableItems) {
+        cacheItem->destroyObject();
+        cacheItem->Dispose();
+    }
+}
+
 void QQmlDelegateModelPrivate::incubatorStatusChanged(QQDMIncubationTask *incubationTask, QQmlIncubator::Status status)
 {
     Q_Q(QQmlDelegateModel);
@@ -895,10 +1008,16 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
 
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
 
+    bool reused = false;
     if (!cacheItem) {
-        cacheItem = m_adaptorModel.createItem(m_cacheMetaType, m_context->engine(), it.modelIndex());
-        if (!cacheItem)
-            return 0;
+        cacheItem = takeReusableItem(it.modelIndex());
+        if (cacheItem) {
+            reused = true;
+        } else {
+            cacheItem = m_adaptorModel.createItem(m_cacheMetaType, m_context->engine(), it.modelIndex());
+            if (!cacheItem)
+                return 0;
+        }
 
         cacheItem->groups = it->flags;
 
@@ -912,7 +1031,18 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
     cacheItem->scriptRef += 1;
     cacheItem->referenceObject();
 
-    if (cacheItem->incubationTask) {
+    if (reused) {
+        // The delegate instance is already complete; hand it out again in the same way a
+        // synchronously incubated one would be.
+        if (QQmlDelegateModelAttached *attached = cacheItem->attached) {
+            for (int i = 1; i < m_groupCount; ++i)
+                attached->m_currentIndex[i] = it.index[i];
+            attached->emitChanges();
+            emit attached->reused();
+        }
+        emit q->initItem(it.index[m_compositorGroup], cacheItem->object);
+        emit q->createdItem(it.index[m_compositorGroup], cacheItem->object);
+    } else if (cacheItem->incubationTask) {
         if (!asynchronous && cacheItem->incubationTask->incubationMode() == QQmlIncubator::Asynchronous) {
             // previously requested async - now needed immediately
             cacheItem->incubationTask->forceCompletion();
@@ -921,6 +1051,7 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
         QQmlContext *creationContext = m_delegate->creationContext();
 
         cacheItem->scriptRef += 1;
+        cacheItem->reuseGeneration = m_reuseGeneration;
 
         cacheItem->incubationTask = new QQDMIncubationTask(this, asynchronous ? QQmlIncubator::Asynchronous : QQmlIncubator::AsynchronousIfNested);
         cacheItem->incubationTask->incubating = cacheItem;
@@ -1776,6 +1907,7 @@ QQmlDelegateModelItem::QQmlDelegateModelItem(
     , scriptRef(0)
     , groups(0)
     , index(modelIndex)
+    , reuseGeneration(0)
 {
     metaType->addref();
 }
@@ -2085,6 +2217,21 @@ bool QQmlDelegateModelAttached::isUnresolved() const
     It is attached to each instance of the delegate.
 */
 
+/*!
+    \qmlattachedsignal QtQml.Models2::DelegateModel::onPooled()
+
+    This handler is called when the delegate instance is released by its view and kept for
+    reuse rather than destroyed.  See \l reuseItems.
+*/
+
+/*!
+    \qmlattachedsignal QtQml.Models2::DelegateModel::onReused()
+
+    This handler is called when a pooled delegate instance is handed out again for a new
+    model index.  The \c index and model role properties have already been updated; any
+    other state the delegate holds should be reset here.  See \l reuseItems.
+*/
+
 void QQmlDelegateModelAttached::emitChanges()
 {
     const int groupChanges = m_previousGroups ^ m_cacheItem->groups;
@@ -145,6 +145,7 @@ public:
 
     virtual void setValue(const QString &role, const QVariant &value) { Q_UNUSED(role); Q_UNUSED(value); }
     virtual bool resolveIndex(const QQmlAdaptorModel &, int) { return false; }
+    virtual bool recycle(const QQmlAdaptorModel &, int) { return false; }
 
     QQmlDelegateModelItemMetaType * const metaType;
     QQmlContextData *contextData;
@@ -155,6 +156,7 @@ public:
     int scriptRef;
     int groups;
     int index;
+    int reuseGeneration;
 
 
 Q_SIGNALS:
@@ -257,6 +259,10 @@ public:
     void emitDestroyingItem(QObject *item) { emit q_func()->destroyingItem(item); }
     void removeCacheItem(QQmlDelegateModelItem *cacheItem);
 
+    bool poolItem(QQmlDelegateModelItem *cacheItem);
+    QQmlDelegateModelItem *takeReusableItem(int modelIndex);
+    void clearReusableItems();
+
     void updateFilterGroup();
 
     void addGroups(Compositor::iterator from, int count, Compositor::Group group, int groupFlags);
@@ -299,6 +305,7 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QList<QQmlDelegateModelItem *> m_reusableItems;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
@@ -306,6 +313,7 @@ public:
 
     int m_count;
     int m_groupCount;
+    int m_reuseGeneration;
 
     QQmlListCompositor::Group m_compositorGroup;
     bool m_complete : 1;
@@ -313,6 +321,7 @@ public:
     bool m_reset : 1;
     bool m_transaction : 1;
     bool m_incubatorCleanupScheduled : 1;
+    bool m_reuseItems : 1;
 
     union {
         struct {
@@ -54,6 +54,7 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qstack.h>
+#include <QtCore/qjsondocument.h>
 #include <QXmlStreamReader>
 
 QT_BEGIN_NAMESPACE
@@ -489,25 +490,73 @@ void ListModel::set(int elementIndex, v8::Handle<v8::Object> object, QV8Engine *
         v8::Local<v8::String> propertyName = propertyNames->Get(i)->ToString();
         v8::Local<v8::Value> propertyValue = object->Get(propertyName);
 
-        // Add the value now
-        if (propertyValue->IsString()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
-            if (r.type == ListLayout::Role::String) {
+        const ListLayout::Role *role = 0;
+        setPropertyFast(e, propertyName, propertyValue, &role, eng);
+    }
+}
+
+/*
+    Sets the \a propertyName role of a new element \a e.  If \a cachedRole
+    points to a role of the type needed for \a propertyValue, it is used
+    without looking the role up, and it is updated to the role that was set.
+    This lets callers setting the same role in many elements skip the lookup.
+*/
+void ListModel::setPropertyFast(ListElement *e, v8::Handle<v8::String> propertyName, v8::Handle<v8::Value> propertyValue,
+                                const ListLayout::Role **cachedRole, QV8Engine *eng)
+{
+    ListLayout::Role::DataType type;
+    QObject *object = 0;
+
+    if (propertyValue.IsEmpty() || propertyValue->IsUndefined() || propertyValue->IsNull()) {
+        const ListLayout::Role *r = m_layout->getExistingRole(propertyName);
+        if (r)
+            e->clearProperty(*r);
+        return;
+    } else if (propertyValue->IsString()) {
+        type = ListLayout::Role::String;
+    } else if (propertyValue->IsNumber()) {
+        type = ListLayout::Role::Number;
+    } else if (propertyValue->IsArray()) {
+        type = ListLayout::Role::List;
+    } else if (propertyValue->IsBoolean()) {
+        type = ListLayout::Role::Bool;
+    } else if (propertyValue->IsDate()) {
+        type = ListLayout::Role::DateTime;
+    } else if (propertyValue->IsObject()) {
+        QV8ObjectResource *r = (QV8ObjectResource *) propertyValue->ToObject()->GetExternalResource();
+        if (r && r->resourceType() == QV8ObjectResource::QObjectType) {
+            object = QV8QObjectWrapper::toQObject(r);
+            type = ListLayout::Role::QObject;
+        } else {
+            type = ListLayout::Role::VariantMap;
+        }
+    } else {
+        return;
+    }
+
+    const ListLayout::Role *r = *cachedRole;
+    if (!r || r->type != type)
+        r = &m_layout->getRoleOrCreate(propertyName, type);
+    if (r->type != type)
+        return;
+    *cachedRole = r;
+
+    switch (type) {
+        case ListLayout::Role::String:
+            {
                 v8::Handle<v8::String> jsString = propertyValue->ToString();
                 QString qstr;
                 qstr.resize(jsString->Length());
                 jsString->Write(reinterpret_cast<uint16_t*>(qstr.data()));
-                e->setStringPropertyFast(r, qstr);
-            }
-        } else if (propertyValue->IsNumber()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
-            if (r.type == ListLayout::Role::Number) {
-                e->setDoublePropertyFast(r, propertyValue->NumberValue());
+                e->setStringPropertyFast(*r, qstr);
             }
-        } else if (propertyValue->IsArray()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::List);
-            if (r.type == ListLayout::Role::List) {
-                ListModel *subModel = new ListModel(r.subLayout, 0, -1);
+            break;
+        case ListLayout::Role::Number:
+            e->setDoublePropertyFast(*r, propertyValue->NumberValue());
+            break;
+        case ListLayout::Role::List:
+            {
+                ListModel *subModel = new ListModel(r->subLayout, 0, -1);
 
                 v8::Handle<v8::Array> subArray = v8::Handle<v8::Array>::Cast(propertyValue);
                 int arrayLength = subArray->Length();
@@ -516,36 +565,26 @@ void ListModel::set(int elementIndex, v8::Handle<v8::Object> object, QV8Engine *
                     subModel->append(subObject, eng);
                 }
 
-                e->setListPropertyFast(r, subModel);
-            }
-        } else if (propertyValue->IsBoolean()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Bool);
-            if (r.type == ListLayout::Role::Bool) {
-                e->setBoolPropertyFast(r, propertyValue->BooleanValue());
+                e->setListPropertyFast(*r, subModel);
             }
-        } else if (propertyValue->IsDate()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::DateTime);
-            if (r.type == ListLayout::Role::DateTime) {
+            break;
+        case ListLayout::Role::Bool:
+            e->setBoolPropertyFast(*r, propertyValue->BooleanValue());
+            break;
+        case ListLayout::Role::DateTime:
+            {
                 QDateTime dt = QV8Engine::qtDateTimeFromJsDate(v8::Handle<v8::Date>::Cast(propertyValue)->NumberValue());
-                e->setDateTimePropertyFast(r, dt);
-            }
-        } else if (propertyValue->IsObject()) {
-            QV8ObjectResource *r = (QV8ObjectResource *) propertyValue->ToObject()->GetExternalResource();
-            if (r && r->resourceType() == QV8ObjectResource::QObjectType) {
-                QObject *o = QV8QObjectWrapper::toQObject(r);
-                const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::QObject);
-                if (r.type == ListLayout::Role::QObject)
-                    e->setQObjectPropertyFast(r, o);
-            } else {
-                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::VariantMap);
-                if (role.type == ListLayout::Role::VariantMap)
-                    e->setVariantMapFast(role, propertyValue->ToObject(), eng);
+                e->setDateTimePropertyFast(*r, dt);
             }
-        } else if (propertyValue.IsEmpty() || propertyValue->IsUndefined() || propertyValue->IsNull()) {
-            const ListLayout::Role *r = m_layout->getExistingRole(propertyName);
-            if (r)
-                e->clearProperty(*r);
-        }
+            break;
+        case ListLayout::Role::QObject:
+            e->setQObjectPropertyFast(*r, object);
+            break;
+        case ListLayout::Role::VariantMap:
+            e->setVariantMapFast(*r, propertyValue->ToObject(), eng);
+            break;
+        default:
+            break;
     }
 }
 
@@ -582,6 +621,158 @@ int ListModel::append(v8::Handle<v8::Object> object, QV8Engine *eng)
     return elementIndex;
 }
 
+/*
+    Appends one element for each entry in the arrays held by the properties
+    of \a columns.  Each role is looked up once per column, rather than once
+    per element.  Returns the number of elements appended.
+*/
+int ListModel::appendColumns(v8::Handle<v8::Object> columns, QV8Engine *eng)
+{
+    v8::Local<v8::Array> propertyNames = columns->GetPropertyNames();
+    int propertyCount = propertyNames->Length();
+
+    int rowCount = 0;
+    for (int i=0 ; i < propertyCount ; ++i) {
+        v8::Local<v8::Value> column = columns->Get(propertyNames->Get(i));
+        if (column->IsArray())
+            rowCount = qMax(rowCount, int(v8::Handle<v8::Array>::Cast(column)->Length()));
+    }
+
+    int firstIndex = elements.count();
+    elements.reserve(firstIndex + rowCount);
+    for (int i=0 ; i < rowCount ; ++i)
+        newElement(firstIndex + i);
+
+    for (int i=0 ; i < propertyCount ; ++i) {
+        v8::Local<v8::String> propertyName = propertyNames->Get(i)->ToString();
+        v8::Local<v8::Value> column = columns->Get(propertyName);
+        if (!column->IsArray())
+            continue;
+
+        v8::Handle<v8::Array> values = v8::Handle<v8::Array>::Cast(column);
+        int valueCount = values->Length();
+
+        const ListLayout::Role *role = 0;
+        for (int j=0 ; j < valueCount ; ++j)
+            setPropertyFast(elements[firstIndex + j], propertyName, values->Get(j), &role, eng);
+    }
+
+    return rowCount;
+}
+
+/*
+    Appends an element for each JSON object in \a rows, without creating
+    any intermediate JavaScript values.  Role types are inferred from the
+    JSON values as they are for JavaScript objects.  Entries that are not
+    objects are skipped.  Returns the number of elements appended.
+*/
+int ListModel::appendJson(const QJsonArray &rows)
+{
+    elements.reserve(elements.count() + rows.count());
+
+    int rowCount = 0;
+    QJsonArray::const_iterator row = rows.constBegin();
+    QJsonArray::const_iterator rowEnd = rows.constEnd();
+    for ( ; row != rowEnd ; ++row) {
+        if (!(*row).isObject())
+            continue;
+
+        appendJsonObject((*row).toObject());
+        ++rowCount;
+    }
+
+    return rowCount;
+}
+
+void ListModel::appendJsonObject(const QJsonObject &object)
+{
+    ListElement *e = elements[appendElement()];
+
+    QJsonObject::const_iterator it = object.constBegin();
+    QJsonObject::const_iterator end = object.constEnd();
+    for ( ; it != end ; ++it)
+        setJsonProperty(e, it.key(), it.value());
+}
+
+void ListModel::setJsonProperty(ListElement *e, const QString &key, const QJsonValue &value)
+{
+    ListLayout::Role::DataType type;
+
+    switch (value.type()) {
+        case QJsonValue::String:    type = ListLayout::Role::String;      break;
+        case QJsonValue::Double:    type = ListLayout::Role::Number;      break;
+        case QJsonValue::Bool:      type = ListLayout::Role::Bool;        break;
+        case QJsonValue::Array:     type = ListLayout::Role::List;        break;
+        case QJsonValue::Object:    type = ListLayout::Role::VariantMap;  break;
+        default:
+            {
+                const ListLayout::Role *r = m_layout->getExistingRole(key);
+                if (r)
+                    e->clearProperty(*r);
+            }
+            return;
+    }
+
+    const ListLayout::Role &r = m_layout->getRoleOrCreate(key, type);
+    if (r.type != type)
+        return;
+
+    switch (type) {
+        case ListLayout::Role::String:
+            e->setStringPropertyFast(r, value.toString());
+            break;
+        case ListLayout::Role::Number:
+            e->setDoublePropertyFast(r, value.toDouble());
+            break;
+        case ListLayout::Role::Bool:
+            e->setBoolPropertyFast(r, value.toBool());
+            break;
+        case ListLayout::Role::List:
+            {
+                ListModel *subModel = new ListModel(r.subLayout, 0, -1);
+
+                // As with append(), entries that are not objects add empty elements
+                const QJsonArray subArray = value.toArray();
+                subModel->reserve(subArray.count());
+                QJsonArray::const_iterator it = subArray.constBegin();
+                QJsonArray::const_iterator end = subArray.constEnd();
+                for ( ; it != end ; ++it)
+                    subModel->appendJsonObject((*it).toObject());
+
+                e->setListPropertyFast(r, subModel);
+            }
+            break;
+        case ListLayout::Role::VariantMap:
+            {
+                QVariantMap map = value.toObject().toVariantMap();
+                e->setVariantMapProperty(r, &map);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+int ListModel::appendRows(const QVariantList &rows)
+{
+    elements.reserve(elements.count() + rows.count());
+
+    for (int i=0 ; i < rows.count() ; ++i) {
+        ListElement *e = elements[appendElement()];
+
+        const QVariantMap map = rows.at(i).toMap();
+        QVariantMap::const_iterator it = map.constBegin();
+        QVariantMap::const_iterator end = map.constEnd();
+        for ( ; it != end ; ++it) {
+            const ListLayout::Role *r = m_layout->getRoleOrCreate(it.key(), it.value());
+            if (r)
+                e->setVariantProperty(*r, it.value());
+        }
+    }
+
+    return rows.count();
+}
+
 int ListModel::setOrCreateProperty(int elementIndex, const QString &key, const QVariant &data)
 {
     int roleIndex = -1;
@@ -2077,6 +2268,164 @@ void QQmlListModel::append(QQmlV8Function *args)
     }
 }
 
+/*!
+    \qmlmethod QtQml2::ListModel::appendRows(jsobject rows)
+
+    Adds many new items to the end of the list model at once.  Views are
+    notified of all of the new items together.
+
+    \a rows is either an array of objects, as accepted by append(), or an
+    object whose properties are arrays holding the values of one role each:
+
+    \code
+        fruitModel.appendRows({"name": ["Apple", "Orange", "Banana"],
+                               "cost": [1.95, 3.25, 2.45]})
+    \endcode
+
+    The second form is the fastest way to fill a large model, as each role
+    is only looked up once for all of its values.  If the arrays differ in
+    length, the missing values of the shorter arrays are left unset.
+
+    \sa append()
+*/
+void QQmlListModel::appendRows(QQmlV8Function *args)
+{
+    if (args->Length() != 1 || !(*args)[0]->IsObject()) {
+        qmlInfo(this) << tr("appendRows: value is not an object");
+        return;
+    }
+
+    v8::Handle<v8::Value> arg = (*args)[0];
+    QV8Engine *eng = args->engine();
+    int index = count();
+    int rowCount = 0;
+
+    if (arg->IsArray()) {
+        v8::Handle<v8::Array> objectArray = v8::Handle<v8::Array>::Cast(arg);
+        rowCount = objectArray->Length();
+
+        if (m_dynamicRoles) {
+            m_modelObjects.reserve(index + rowCount);
+            for (int i=0 ; i < rowCount ; ++i)
+                m_modelObjects.append(DynamicRoleModelNode::create(eng->variantMapFromJS(objectArray->Get(i)->ToObject()), this));
+        } else {
+            m_listModel->reserve(index + rowCount);
+            for (int i=0 ; i < rowCount ; ++i)
+                m_listModel->append(objectArray->Get(i)->ToObject(), eng);
+        }
+    } else if (m_dynamicRoles) {
+        v8::Handle<v8::Object> columns = arg->ToObject();
+        v8::Local<v8::Array> propertyNames = columns->GetPropertyNames();
+        int propertyCount = propertyNames->Length();
+
+        QVector<QString> names;
+        QVector<v8::Handle<v8::Array> > values;
+        for (int i=0 ; i < propertyCount ; ++i) {
+            v8::Local<v8::Value> column = columns->Get(propertyNames->Get(i));
+            if (!column->IsArray())
+                continue;
+            names.append(eng->toString(propertyNames->Get(i)));
+            values.append(v8::Handle<v8::Array>::Cast(column));
+            rowCount = qMax(rowCount, int(values.last()->Length()));
+        }
+
+        m_modelObjects.reserve(index + rowCount);
+        for (int i=0 ; i < rowCount ; ++i) {
+            QVariantMap row;
+            for (int j=0 ; j < names.count() ; ++j) {
+                if (uint(i) < values.at(j)->Length())
+                    row.insert(names.at(j), eng->toVariant(values.at(j)->Get(i), -1));
+            }
+            m_modelObjects.append(DynamicRoleModelNode::create(row, this));
+        }
+    } else {
+        rowCount = m_listModel->appendColumns(arg->ToObject(), eng);
+    }
+
+    emitItemsInserted(index, rowCount);
+}
+
+/*!
+    \qmlmethod int QtQml2::ListModel::appendJson(string json)
+
+    Parses the JSON text \a json and adds each object of the top-level array
+    to the end of the list model as a new item.  If \a json holds a single
+    object, one item is added.  Returns the number of items added.
+
+    The text is read directly into the model, so no JavaScript objects are
+    created for the rows.  This is considerably faster than calling
+    \c JSON.parse() and appending the resulting objects, e.g. when filling a
+    model from the \c responseText of an XMLHttpRequest:
+
+    \code
+        fruitModel.appendJson(request.responseText)
+    \endcode
+
+    Roles are created from the JSON values in the same way as for append():
+    strings, numbers and booleans become roles of the same type, arrays of
+    objects become nested list models and other objects become JavaScript
+    objects.  As with append(), entries of a nested array that are not
+    objects add empty items to the nested list model.  Entries of the
+    top-level array that are not objects are ignored.
+
+    \sa appendRows()
+*/
+int QQmlListModel::appendJson(const QString &json)
+{
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(json.toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qmlInfo(this) << tr("appendJson: %1 at offset %2").arg(error.errorString()).arg(error.offset);
+        return 0;
+    }
+
+    QJsonArray rows;
+    if (document.isArray())
+        rows = document.array();
+    else
+        rows.append(document.object());
+
+    int index = count();
+    int rowCount = 0;
+
+    if (m_dynamicRoles) {
+        m_modelObjects.reserve(index + rows.count());
+        for (int i=0 ; i < rows.count() ; ++i) {
+            const QJsonValue row = rows.at(i);
+            if (!row.isObject())
+                continue;
+            m_modelObjects.append(DynamicRoleModelNode::create(row.toObject().toVariantMap(), this));
+            ++rowCount;
+        }
+    } else {
+        rowCount = m_listModel->appendJson(rows);
+    }
+
+    emitItemsInserted(index, rowCount);
+    return rowCount;
+}
+
+/*!
+    \internal
+
+    Adds the QVariantMaps in \a rows to the end of the list model, notifying
+    views of all of the new items at once.
+*/
+void QQmlListModel::appendRows(const QVariantList &rows)
+{
+    int index = count();
+
+    if (m_dynamicRoles) {
+        m_modelObjects.reserve(index + rows.count());
+        for (int i=0 ; i < rows.count() ; ++i)
+            m_modelObjects.append(DynamicRoleModelNode::create(rows.at(i).toMap(), this));
+    } else {
+        m_listModel->appendRows(rows);
+    }
+
+    emitItemsInserted(index, rows.count());
+}
+
 /*!
     \qmlmethod object QtQml2::ListModel::get(int index)
 
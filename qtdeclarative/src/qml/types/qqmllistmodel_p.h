@@ -83,6 +83,8 @@ public:
     Q_INVOKABLE void clear();
     Q_INVOKABLE void remove(QQmlV8Function *args);
     Q_INVOKABLE void append(QQmlV8Function *args);
+    Q_INVOKABLE void appendRows(QQmlV8Function *args);
+    Q_INVOKABLE int appendJson(const QString &json);
     Q_INVOKABLE void insert(QQmlV8Function *args);
     Q_INVOKABLE QQmlV8Handle get(int index) const;
     Q_INVOKABLE void set(int index, const QQmlV8Handle &);
@@ -90,6 +92,8 @@ public:
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
 
+    void appendRows(const QVariantList &rows);
+
     QQmlListModelWorkerAgent *agent();
 
     bool dynamicRoles() const { return m_dynamicRoles; }
@@ -58,6 +58,10 @@
 #include <private/qqmlopenmetaobject_p.h>
 #include <qqml.h>
 
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qjsonvalue.h>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -293,6 +297,7 @@ private:
     ModelObject *m_objectCache;
 
     friend class ListModel;
+    friend class QQmlListModelWorkerAgent;
 };
 
 /*!
@@ -339,6 +344,11 @@ public:
     int append(v8::Handle<v8::Object> object, QV8Engine *eng);
     void insert(int elementIndex, v8::Handle<v8::Object> object, QV8Engine *eng);
 
+    void reserve(int count) { elements.reserve(count); }
+    int appendColumns(v8::Handle<v8::Object> columns, QV8Engine *eng);
+    int appendRows(const QVariantList &rows);
+    int appendJson(const QJsonArray &rows);
+
     void clear();
     void remove(int index, int count);
 
@@ -372,6 +382,11 @@ private:
 
     void updateCacheIndices();
 
+    void setPropertyFast(ListElement *e, v8::Handle<v8::String> propertyName, v8::Handle<v8::Value> propertyValue,
+                         const ListLayout::Role **cachedRole, QV8Engine *eng);
+    void appendJsonObject(const QJsonObject &object);
+    void setJsonProperty(ListElement *e, const QString &key, const QJsonValue &value);
+
     friend class ListElement;
     friend class QQmlListModelWorkerAgent;
 };
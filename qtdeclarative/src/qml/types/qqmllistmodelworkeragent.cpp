@@ -49,6 +49,7 @@
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qdebug.h>
 
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -87,6 +88,121 @@ void QQmlListModelWorkerAgent::Data::changedChange(int uid, int index, int count
     changes << c;
 }
 
+namespace {
+struct ElementSlot
+{
+    ElementSlot(ListElement *e = 0) : element(e), dirty(false) {}
+
+    ListElement *element;
+    bool dirty;
+};
+}
+
+/*
+    Applies the changes recorded by the worker to the elements of \a target,
+    so that only inserted and changed elements are copied from \a src.
+
+    Returns false without modifying \a target if the changes do not account
+    for the difference between the two lists, e.g. if a nested list was
+    changed or the list was cleared.  The caller then falls back to a full
+    ListModel::sync().
+*/
+bool QQmlListModelWorkerAgent::syncChanges(ListModel *src, ListModel *target, const QList<Change> &changes,
+                                           QHash<int, ListModel *> *targetModelHash)
+{
+    const int uid = src->getUid();
+    if (target->getUid() != uid)
+        return false;
+
+    QVector<ElementSlot> rows;
+    rows.reserve(target->elements.count());
+    for (int i=0 ; i < target->elements.count() ; ++i)
+        rows.append(ElementSlot(target->elements.at(i)));
+
+    QVector<ListElement *> removed;
+
+    for (int ii = 0; ii < changes.count(); ++ii) {
+        const Change &change = changes.at(ii);
+        if (change.modelUid != uid || change.index < 0 || change.count < 0)
+            return false;
+
+        switch (change.type) {
+        case Change::Inserted:
+            if (change.index > rows.count())
+                return false;
+            rows.insert(change.index, change.count, ElementSlot());
+            break;
+        case Change::Removed:
+            if (change.index + change.count > rows.count())
+                return false;
+            for (int i = change.index; i < change.index + change.count; ++i) {
+                if (rows.at(i).element)
+                    removed.append(rows.at(i).element);
+            }
+            rows.remove(change.index, change.count);
+            break;
+        case Change::Moved:
+            if (change.index + change.count > rows.count() || change.to < 0
+                    || change.to + change.count > rows.count())
+                return false;
+            if (change.index < change.to)
+                std::rotate(rows.begin() + change.index, rows.begin() + change.index + change.count,
+                            rows.begin() + change.to + change.count);
+            else
+                std::rotate(rows.begin() + change.to, rows.begin() + change.index,
+                            rows.begin() + change.index + change.count);
+            break;
+        case Change::Changed:
+            if (change.index + change.count > rows.count())
+                return false;
+            for (int i = change.index; i < change.index + change.count; ++i)
+                rows[i].dirty = true;
+            break;
+        }
+    }
+
+    if (rows.count() != src->elements.count())
+        return false;
+    for (int i=0 ; i < rows.count() ; ++i) {
+        ListElement *e = rows.at(i).element;
+        if (e && e->getUid() != src->elements.at(i)->getUid())
+            return false;
+    }
+
+    if (targetModelHash)
+        targetModelHash->insert(uid, target);
+
+    for (int i=0 ; i < removed.count() ; ++i) {
+        removed.at(i)->destroy(target->m_layout);
+        delete removed.at(i);
+    }
+
+    ListLayout::sync(src->m_layout, target->m_layout);
+
+    target->elements.clear();
+    for (int i=0 ; i < rows.count() ; ++i) {
+        ListElement *srcElement = src->elements.at(i);
+        ElementSlot &row = rows[i];
+        if (row.element == 0) {
+            row.element = new ListElement(srcElement->getUid());
+            row.dirty = true;
+        }
+        if (row.dirty)
+            ListElement::sync(srcElement, src->m_layout, row.element, target->m_layout, targetModelHash);
+        target->elements.append(row.element);
+    }
+
+    target->updateCacheIndices();
+
+    for (int i=0 ; i < rows.count() ; ++i) {
+        const ElementSlot &row = rows.at(i);
+        if (row.dirty && row.element->m_objectCache)
+            row.element->m_objectCache->updateValues();
+    }
+
+    return true;
+}
+
 QQmlListModelWorkerAgent::QQmlListModelWorkerAgent(QQmlListModel *model)
 : m_ref(1), m_orig(model), m_copy(new QQmlListModel(model, this))
 {
@@ -142,6 +258,16 @@ void QQmlListModelWorkerAgent::append(QQmlV8Function *args)
     m_copy->append(args);
 }
 
+void QQmlListModelWorkerAgent::appendRows(QQmlV8Function *args)
+{
+    m_copy->appendRows(args);
+}
+
+int QQmlListModelWorkerAgent::appendJson(const QString &json)
+{
+    return m_copy->appendJson(json);
+}
+
 void QQmlListModelWorkerAgent::insert(QQmlV8Function *args)
 {
     m_copy->insert(args);
@@ -197,7 +323,7 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
             Q_ASSERT(m_orig->m_dynamicRoles == s->list->m_dynamicRoles);
             if (m_orig->m_dynamicRoles)
                 QQmlListModel::sync(s->list, m_orig, &targetModelDynamicHash);
-            else
+            else if (!syncChanges(s->list->m_listModel, m_orig->m_listModel, changes, &targetModelStaticHash))
                 ListModel::sync(s->list->m_listModel, m_orig->m_listModel, &targetModelStaticHash);
 
             for (int ii = 0; ii < changes.count(); ++ii) {
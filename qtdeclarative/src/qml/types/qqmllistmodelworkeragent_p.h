@@ -64,6 +64,7 @@ QT_BEGIN_NAMESPACE
 
 
 class QQmlListModel;
+class ListModel;
 
 class QQmlListModelWorkerAgent : public QObject
 {
@@ -83,6 +84,8 @@ public:
     Q_INVOKABLE void clear();
     Q_INVOKABLE void remove(QQmlV8Function *args);
     Q_INVOKABLE void append(QQmlV8Function *args);
+    Q_INVOKABLE void appendRows(QQmlV8Function *args);
+    Q_INVOKABLE int appendJson(const QString &json);
     Q_INVOKABLE void insert(QQmlV8Function *args);
     Q_INVOKABLE QQmlV8Handle get(int index) const;
     Q_INVOKABLE void set(int index, const QQmlV8Handle &);
@@ -135,6 +138,9 @@ private:
     };
     Data data;
 
+    static bool syncChanges(ListModel *src, ListModel *target, const QList<Change> &changes,
+                            QHash<int, ListModel *> *targetModelHash);
+
     struct Sync : public QEvent {
         Sync() : QEvent(QEvent::User) {}
         Data data;
@@ -44,6 +44,7 @@
 #include "qqmllistmodelworkeragent_p.h"
 #include <private/qqmlengine_p.h>
 #include <private/qqmlexpression_p.h>
+#include <private/qqmlglobal_p.h>
 
 #include <QtCore/qcoreevent.h>
 #include <QtCore/qcoreapplication.h>
@@ -68,15 +69,17 @@ class WorkerDataEvent : public QEvent
 public:
     enum Type { WorkerData = QEvent::User };
 
-    WorkerDataEvent(int workerId, const QByteArray &data);
+    WorkerDataEvent(int workerId, const QByteArray &data, qint64 queuedAt = -1);
     virtual ~WorkerDataEvent();
 
     int workerId() const;
     QByteArray data() const;
+    qint64 queuedAt() const;
 
 private:
     int m_id;
     QByteArray m_data;
+    qint64 m_queuedAt;
 };
 
 class WorkerLoadEvent : public QEvent
@@ -125,10 +128,12 @@ class QQuickWorkerScriptEnginePrivate : public QObject
     Q_OBJECT
 public:
     enum WorkerEventTypes {
-        WorkerDestroyEvent = QEvent::User + 100
+        WorkerDestroyEvent = QEvent::User + 100,
+        WorkerRunQueueEvent
     };
 
-    QQuickWorkerScriptEnginePrivate(QQmlEngine *eng);
+    QQuickWorkerScriptEnginePrivate(QQmlEngine *eng, QQuickWorkerScriptEngine *pool,
+                                    QQuickWorkerScriptThread *thread);
 
     class WorkerEngine : public QV8Engine
     {
@@ -155,6 +160,8 @@ public:
     }
 
     QQmlEngine *qmlengine;
+    QQuickWorkerScriptEngine *pool;
+    QQuickWorkerScriptThread *thread;
 
     QMutex m_lock;
     QWaitCondition m_wait;
@@ -166,15 +173,12 @@ public:
         int id;
         QUrl source;
         bool initialized;
-        QQuickWorkerScript *owner;
         v8::Persistent<v8::Object> object;
     };
 
     QHash<int, WorkerScript *> workers;
     v8::Handle<v8::Object> getWorker(WorkerScript *);
 
-    int m_nextId;
-
     static v8::Handle<v8::Value> sendMessage(const v8::Arguments &args);
 
 signals:
@@ -186,9 +190,38 @@ protected:
 private:
     void processMessage(int, const QByteArray &);
     void processLoad(int, const QUrl &);
+    void runQueue();
     void reportScriptException(WorkerScript *, const QQmlError &error);
 };
 
+class QQuickWorkerScriptThread : public QThread
+{
+public:
+    QQuickWorkerScriptThread(QQuickWorkerScriptEngine *pool, QQmlEngine *engine);
+    ~QQuickWorkerScriptThread();
+
+    QQuickWorkerScriptEnginePrivate *d;
+
+    // Protected by the pool's lock
+    QList<QQuickWorkerScriptEngine::PendingMessage> pending;
+    int scriptCount;
+    int running;
+
+protected:
+    virtual void run();
+};
+
+struct QQuickWorkerScriptEngine::Script
+{
+    Script() : owner(0), thread(0), stateless(false) {}
+
+    QQuickWorkerScript *owner;
+    QQuickWorkerScriptThread *thread;
+    QUrl source;
+    bool stateless;
+    Statistics statistics;
+};
+
 QQuickWorkerScriptEnginePrivate::WorkerEngine::WorkerEngine(QQuickWorkerScriptEnginePrivate *parent) 
 : QV8Engine(0), p(parent), accessManager(0)
 {
@@ -270,8 +303,10 @@ QNetworkAccessManager *QQuickWorkerScriptEnginePrivate::WorkerEngine::networkAcc
     return accessManager;
 }
 
-QQuickWorkerScriptEnginePrivate::QQuickWorkerScriptEnginePrivate(QQmlEngine *engine)
-: workerEngine(0), qmlengine(engine), m_nextId(0)
+QQuickWorkerScriptEnginePrivate::QQuickWorkerScriptEnginePrivate(QQmlEngine *engine,
+                                                                 QQuickWorkerScriptEngine *pool,
+                                                                 QQuickWorkerScriptThread *thread)
+: workerEngine(0), qmlengine(engine), pool(pool), thread(thread)
 {
 }
 
@@ -283,13 +318,7 @@ v8::Handle<v8::Value> QQuickWorkerScriptEnginePrivate::sendMessage(const v8::Arg
 
     QByteArray data = QV8Worker::serialize(args[2], engine);
 
-    QMutexLocker locker(&engine->p->m_lock);
-    WorkerScript *script = engine->p->workers.value(id);
-    if (!script)
-        return v8::Undefined();
-
-    if (script->owner)
-        QCoreApplication::postEvent(script->owner, new WorkerDataEvent(0, data));
+    engine->p->pool->postToOwner(id, new WorkerDataEvent(0, data));
 
     return v8::Undefined();
 }
@@ -319,7 +348,12 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
 {
     if (event->type() == (QEvent::Type)WorkerDataEvent::WorkerData) {
         WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
+        pool->messageStarted(thread, workerEvent->workerId(), workerEvent->queuedAt());
         processMessage(workerEvent->workerId(), workerEvent->data());
+        pool->messageFinished(thread);
+        return true;
+    } else if (event->type() == (QEvent::Type)WorkerRunQueueEvent) {
+        runQueue();
         return true;
     } else if (event->type() == (QEvent::Type)WorkerLoadEvent::WorkerLoad) {
         WorkerLoadEvent *workerEvent = static_cast<WorkerLoadEvent *>(event);
@@ -330,7 +364,8 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
         return true;
     } else if (event->type() == (QEvent::Type)WorkerRemoveEvent::WorkerRemove) {
         WorkerRemoveEvent *workerEvent = static_cast<WorkerRemoveEvent *>(event);
-        workers.remove(workerEvent->workerId());
+        QMutexLocker locker(&m_lock);
+        delete workers.take(workerEvent->workerId());
         return true;
     } else {
         return QObject::event(event);
@@ -358,6 +393,33 @@ void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &d
     }
 }
 
+// Processes one message of a stateless script, which may belong to another
+// thread.  The script is loaded on first use by this thread.
+void QQuickWorkerScriptEnginePrivate::runQueue()
+{
+    QQuickWorkerScriptEngine::PendingMessage message;
+    if (!pool->takeMessage(thread, &message))
+        return;
+
+    pool->messageStarted(thread, message.id, message.queuedAt);
+
+    WorkerScript *script = workers.value(message.id);
+    if (!script) {
+        script = new WorkerScript;
+        script->id = message.id;
+        QMutexLocker locker(&m_lock);
+        workers.insert(script->id, script);
+    }
+    if (script->source != message.source && !message.source.isEmpty())
+        processLoad(message.id, message.source);
+
+    processMessage(message.id, message.data);
+    pool->messageFinished(thread);
+
+    if (pool->hasMessages(thread))
+        QCoreApplication::postEvent(this, new QEvent((QEvent::Type)WorkerRunQueueEvent));
+}
+
 void QQuickWorkerScriptEnginePrivate::processLoad(int id, const QUrl &url)
 {
     if (url.isRelative())
@@ -404,15 +466,11 @@ void QQuickWorkerScriptEnginePrivate::processLoad(int id, const QUrl &url)
 void QQuickWorkerScriptEnginePrivate::reportScriptException(WorkerScript *script, 
                                                                   const QQmlError &error)
 {
-    QQuickWorkerScriptEnginePrivate *p = QQuickWorkerScriptEnginePrivate::get(workerEngine);
-
-    QMutexLocker locker(&p->m_lock);
-    if (script->owner)
-        QCoreApplication::postEvent(script->owner, new WorkerErrorEvent(error));
+    pool->postToOwner(script->id, new WorkerErrorEvent(error));
 }
 
-WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data)
-: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data)
+WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data, qint64 queuedAt)
+: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data), m_queuedAt(queuedAt)
 {
 }
 
@@ -430,6 +488,11 @@ QByteArray WorkerDataEvent::data() const
     return m_data;
 }
 
+qint64 WorkerDataEvent::queuedAt() const
+{
+    return m_queuedAt;
+}
+
 WorkerLoadEvent::WorkerLoadEvent(int workerId, const QUrl &url)
 : QEvent((QEvent::Type)WorkerLoad), m_id(workerId), m_url(url)
 {
@@ -465,8 +528,8 @@ QQmlError WorkerErrorEvent::error() const
     return m_error;
 }
 
-QQuickWorkerScriptEngine::QQuickWorkerScriptEngine(QQmlEngine *parent)
-: QThread(parent), d(new QQuickWorkerScriptEnginePrivate(parent))
+QQuickWorkerScriptThread::QQuickWorkerScriptThread(QQuickWorkerScriptEngine *pool, QQmlEngine *engine)
+: d(new QQuickWorkerScriptEnginePrivate(engine, pool, this)), scriptCount(0), running(0)
 {
     d->m_lock.lock();
     connect(d, SIGNAL(stopThread()), this, SLOT(quit()), Qt::DirectConnection);
@@ -476,7 +539,7 @@ QQuickWorkerScriptEngine::QQuickWorkerScriptEngine(QQmlEngine *parent)
     d->m_lock.unlock();
 }
 
-QQuickWorkerScriptEngine::~QQuickWorkerScriptEngine()
+QQuickWorkerScriptThread::~QQuickWorkerScriptThread()
 {
     d->m_lock.lock();
     QCoreApplication::postEvent(d, new QEvent((QEvent::Type)QQuickWorkerScriptEnginePrivate::WorkerDestroyEvent));
@@ -495,8 +558,27 @@ QQuickWorkerScriptEngine::~QQuickWorkerScriptEngine()
     d->deleteLater();
 }
 
+void QQuickWorkerScriptThread::run()
+{
+    d->m_lock.lock();
+
+    d->workerEngine = new QQuickWorkerScriptEnginePrivate::WorkerEngine(d);
+    d->workerEngine->init();
+
+    d->m_wait.wakeAll();
+
+    d->m_lock.unlock();
+
+    exec();
+
+    qDeleteAll(d->workers);
+    d->workers.clear();
+
+    delete d->workerEngine; d->workerEngine = 0;
+}
+
 QQuickWorkerScriptEnginePrivate::WorkerScript::WorkerScript()
-: id(-1), initialized(false), owner(0)
+: id(-1), initialized(false)
 {
 }
 
@@ -505,59 +587,250 @@ QQuickWorkerScriptEnginePrivate::WorkerScript::~WorkerScript()
     qPersistentDispose(object);
 }
 
+DEFINE_INT_CONFIG_OPTION(qmlWorkerScriptThreads, QML_WORKER_SCRIPT_THREADS)
+
+/*
+    The number of threads in the pool can be set with QML_WORKER_SCRIPT_THREADS.
+    By default up to four threads are used, depending on the number of cores.
+*/
+int QQuickWorkerScriptEngine::maximumThreadCount()
+{
+    if (int threads = qmlWorkerScriptThreads())
+        return threads;
+    return qBound(1, QThread::idealThreadCount(), 4);
+}
+
+QQuickWorkerScriptEngine::QQuickWorkerScriptEngine(QQmlEngine *parent)
+: QObject(parent), m_engine(parent), m_nextId(0)
+{
+    m_clock.start();
+    m_threads.append(new QQuickWorkerScriptThread(this, m_engine));
+}
+
+QQuickWorkerScriptEngine::~QQuickWorkerScriptEngine()
+{
+    // The threads are shut down one by one without holding the lock, as their
+    // remaining events still call into the pool.
+    forever {
+        m_lock.lock();
+        if (m_threads.isEmpty()) {
+            m_lock.unlock();
+            break;
+        }
+        foreach (QQuickWorkerScriptThread *thread, m_threads)
+            thread->pending.clear();
+        QQuickWorkerScriptThread *thread = m_threads.takeLast();
+        m_lock.unlock();
+
+        delete thread;
+    }
+
+    qDeleteAll(m_scripts);
+    m_scripts.clear();
+}
+
 int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner)
 {
     typedef QQuickWorkerScriptEnginePrivate::WorkerScript WorkerScript;
-    WorkerScript *script = new WorkerScript;
 
-    script->id = d->m_nextId++;
+    QQuickWorkerScriptThread *thread = 0;
+    m_lock.lock();
+    foreach (QQuickWorkerScriptThread *t, m_threads) {
+        if (!thread || t->scriptCount < thread->scriptCount)
+            thread = t;
+    }
+    bool grow = thread->scriptCount > 0 && m_threads.count() < maximumThreadCount();
+    m_lock.unlock();
+
+    // Threads are only added from the engine's thread, so creating one
+    // outside of the lock cannot race with another registration.
+    if (grow)
+        thread = new QQuickWorkerScriptThread(this, m_engine);
+
+    QMutexLocker locker(&m_lock);
+    if (grow)
+        m_threads.append(thread);
+
+    Script *script = new Script;
     script->owner = owner;
+    script->thread = thread;
+    int id = m_nextId++;
+    m_scripts.insert(id, script);
+    ++thread->scriptCount;
 
-    d->m_lock.lock();
-    d->workers.insert(script->id, script);
-    d->m_lock.unlock();
+    WorkerScript *worker = new WorkerScript;
+    worker->id = id;
 
-    return script->id;
+    thread->d->m_lock.lock();
+    thread->d->workers.insert(id, worker);
+    thread->d->m_lock.unlock();
+
+    return id;
 }
 
 void QQuickWorkerScriptEngine::removeWorkerScript(int id)
 {
-    QQuickWorkerScriptEnginePrivate::WorkerScript* script = d->workers.value(id);
-    if (script) {
-        script->owner = 0;
-        QCoreApplication::postEvent(d, new WorkerRemoveEvent(id));
+    QMutexLocker locker(&m_lock);
+    Script *script = m_scripts.take(id);
+    if (!script)
+        return;
+
+    --script->thread->scriptCount;
+    delete script;
+
+    // Any thread may have loaded an instance of a stateless script
+    foreach (QQuickWorkerScriptThread *thread, m_threads) {
+        QMutableListIterator<PendingMessage> it(thread->pending);
+        while (it.hasNext()) {
+            if (it.next().id == id)
+                it.remove();
+        }
+        QCoreApplication::postEvent(thread->d, new WorkerRemoveEvent(id));
     }
 }
 
 void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
 {
-    QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
+    QMutexLocker locker(&m_lock);
+    Script *script = m_scripts.value(id);
+    if (!script)
+        return;
+
+    script->source = url;
+    QCoreApplication::postEvent(script->thread->d, new WorkerLoadEvent(id, url));
 }
 
 void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
 {
-    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
+    QMutexLocker locker(&m_lock);
+    Script *script = m_scripts.value(id);
+    if (!script)
+        return;
+
+    Statistics &stats = script->statistics;
+    stats.maximumQueueDepth = qMax(stats.maximumQueueDepth, ++stats.queueDepth);
+
+    QQuickWorkerScriptThread *home = script->thread;
+    qint64 now = m_clock.elapsed();
+
+    if (!script->stateless) {
+        QCoreApplication::postEvent(home->d, new WorkerDataEvent(id, data, now));
+        return;
+    }
+
+    PendingMessage message = { id, script->source, data, now };
+    home->pending.append(message);
+    QCoreApplication::postEvent(home->d, new QEvent((QEvent::Type)QQuickWorkerScriptEnginePrivate::WorkerRunQueueEvent));
+
+    // Wake an idle thread to help out if the script's own thread is behind
+    if (home->running || home->pending.count() > 1) {
+        foreach (QQuickWorkerScriptThread *thread, m_threads) {
+            if (thread != home && !thread->running && thread->pending.isEmpty()) {
+                QCoreApplication::postEvent(thread->d, new QEvent((QEvent::Type)QQuickWorkerScriptEnginePrivate::WorkerRunQueueEvent));
+                break;
+            }
+        }
+    }
 }
 
-void QQuickWorkerScriptEngine::run()
+void QQuickWorkerScriptEngine::setStateless(int id, bool stateless)
 {
-    d->m_lock.lock();
+    QMutexLocker locker(&m_lock);
+    if (Script *script = m_scripts.value(id))
+        script->stateless = stateless;
+}
 
-    d->workerEngine = new QQuickWorkerScriptEnginePrivate::WorkerEngine(d);
-    d->workerEngine->init();
+QQuickWorkerScriptEngine::Statistics QQuickWorkerScriptEngine::statistics(int id) const
+{
+    QMutexLocker locker(&m_lock);
+    Script *script = m_scripts.value(id);
+    return script ? script->statistics : Statistics();
+}
 
-    d->m_wait.wakeAll();
+int QQuickWorkerScriptEngine::threadCount() const
+{
+    QMutexLocker locker(&m_lock);
+    return m_threads.count();
+}
 
-    d->m_lock.unlock();
+QThread *QQuickWorkerScriptEngine::threadAt(int index) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_threads.value(index);
+}
 
-    exec();
+void QQuickWorkerScriptEngine::postToOwner(int id, QEvent *event)
+{
+    QMutexLocker locker(&m_lock);
+    Script *script = m_scripts.value(id);
+    if (script && script->owner)
+        QCoreApplication::postEvent(script->owner, event);
+    else
+        delete event;
+}
 
-    qDeleteAll(d->workers);
-    d->workers.clear();
+void QQuickWorkerScriptEngine::messageStarted(QQuickWorkerScriptThread *thread, int id, qint64 queuedAt)
+{
+    QMutexLocker locker(&m_lock);
+    ++thread->running;
 
-    delete d->workerEngine; d->workerEngine = 0;
+    Script *script = m_scripts.value(id);
+    if (!script)
+        return;
+
+    Statistics &stats = script->statistics;
+    --stats.queueDepth;
+    ++stats.processed;
+    if (script->thread != thread)
+        ++stats.stolen;
+    if (queuedAt >= 0) {
+        qint64 latency = m_clock.elapsed() - queuedAt;
+        stats.totalLatency += latency;
+        stats.maximumLatency = qMax(stats.maximumLatency, latency);
+    }
+}
+
+void QQuickWorkerScriptEngine::messageFinished(QQuickWorkerScriptThread *thread)
+{
+    QMutexLocker locker(&m_lock);
+    --thread->running;
 }
 
+static inline bool isBehind(const QQuickWorkerScriptThread *thread)
+{
+    return !thread->pending.isEmpty() && (thread->running || thread->pending.count() > 1);
+}
+
+// Takes the next message for \a thread: its own, or the oldest message of the
+// thread with the longest backlog.
+bool QQuickWorkerScriptEngine::takeMessage(QQuickWorkerScriptThread *thread, PendingMessage *message)
+{
+    QMutexLocker locker(&m_lock);
+    QQuickWorkerScriptThread *victim = thread->pending.isEmpty() ? 0 : thread;
+    if (!victim) {
+        foreach (QQuickWorkerScriptThread *t, m_threads) {
+            if (isBehind(t) && (!victim || t->pending.count() > victim->pending.count()))
+                victim = t;
+        }
+    }
+    if (!victim)
+        return false;
+
+    *message = victim->pending.takeFirst();
+    return true;
+}
+
+bool QQuickWorkerScriptEngine::hasMessages(QQuickWorkerScriptThread *thread) const
+{
+    QMutexLocker locker(&m_lock);
+    if (!thread->pending.isEmpty())
+        return true;
+    foreach (QQuickWorkerScriptThread *t, m_threads) {
+        if (isBehind(t))
+            return true;
+    }
+    return false;
+}
 
 /*!
     \qmltype WorkerScript
@@ -606,7 +879,7 @@ void QQuickWorkerScriptEngine::run()
         {declarative/threading/threadedlistmodel}{Threaded ListModel example}
 */
 QQuickWorkerScript::QQuickWorkerScript(QObject *parent)
-: QObject(parent), m_engine(0), m_scriptId(-1), m_componentComplete(true)
+: QObject(parent), m_engine(0), m_scriptId(-1), m_componentComplete(true), m_stateless(false)
 {
 }
 
@@ -639,6 +912,44 @@ void QQuickWorkerScript::setSource(const QUrl &source)
     emit sourceChanged();
 }
 
+/*!
+    \qmlproperty bool WorkerScript::stateless
+
+    This property holds whether the \tt WorkerScript.onMessage() handler keeps
+    no state between messages.
+
+    Messages sent to a stateless worker script may be handled by any of the
+    worker threads of the engine, each of which loads its own instance of the
+    script.  This lets a busy script use idle threads, but messages are no
+    longer guaranteed to be handled in the order they were sent.
+
+    The default value is false.
+*/
+bool QQuickWorkerScript::stateless() const
+{
+    return m_stateless;
+}
+
+void QQuickWorkerScript::setStateless(bool stateless)
+{
+    if (m_stateless == stateless)
+        return;
+
+    m_stateless = stateless;
+
+    if (m_engine)
+        m_engine->setStateless(m_scriptId, m_stateless);
+
+    emit statelessChanged();
+}
+
+QQuickWorkerScriptEngine::Statistics QQuickWorkerScript::statistics() const
+{
+    if (!m_engine)
+        return QQuickWorkerScriptEngine::Statistics();
+    return m_engine->statistics(m_scriptId);
+}
+
 /*!
     \qmlmethod WorkerScript::sendMessage(jsobject message)
 
@@ -690,6 +1001,8 @@ QQuickWorkerScriptEngine *QQuickWorkerScript::engine()
 
         m_engine = QQmlEnginePrivate::get(engine)->getWorkerScriptEngine();
         m_scriptId = m_engine->registerWorkerScript(this);
+        if (m_stateless)
+            m_engine->setStateless(m_scriptId, true);
 
         if (m_source.isValid())
             m_engine->executeUrl(m_scriptId, m_source);
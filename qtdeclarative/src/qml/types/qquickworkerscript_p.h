@@ -57,6 +57,9 @@
 
 #include <QtQml/qqmlparserstatus.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
 #include <QtQml/qjsvalue.h>
 #include <QtCore/qurl.h>
 
@@ -64,8 +67,14 @@ QT_BEGIN_NAMESPACE
 
 
 class QQuickWorkerScript;
+class QQuickWorkerScriptThread;
 class QQuickWorkerScriptEnginePrivate;
-class QQuickWorkerScriptEngine : public QThread
+
+// The pool of threads running the WorkerScripts of an engine.  Each script is
+// assigned to one thread, which loads the script and processes its messages.
+// Messages of stateless scripts may also be taken by any idle thread, which
+// loads its own instance of the script on demand.
+class Q_AUTOTEST_EXPORT QQuickWorkerScriptEngine : public QObject
 {
 Q_OBJECT
 public:
@@ -76,12 +85,49 @@ public:
     void removeWorkerScript(int);
     void executeUrl(int, const QUrl &);
     void sendMessage(int, const QByteArray &);
+    void setStateless(int, bool);
 
-protected:
-    virtual void run();
+    struct Statistics {
+        Statistics() : queueDepth(0), maximumQueueDepth(0), processed(0), stolen(0),
+                       totalLatency(0), maximumLatency(0) {}
+
+        int queueDepth;        // Messages sent, but not yet being processed
+        int maximumQueueDepth;
+        int processed;
+        int stolen;            // Messages processed by a thread other than the script's own
+        qint64 totalLatency;   // Milliseconds between sending and processing messages
+        qint64 maximumLatency;
+    };
+    Statistics statistics(int) const;
+
+    int threadCount() const;
+    QThread *threadAt(int) const;
+    static int maximumThreadCount();
 
 private:
-    QQuickWorkerScriptEnginePrivate *d;
+    friend class QQuickWorkerScriptThread;
+    friend class QQuickWorkerScriptEnginePrivate;
+
+    struct Script;
+    struct PendingMessage {
+        int id;
+        QUrl source;
+        QByteArray data;
+        qint64 queuedAt;
+    };
+
+    void postToOwner(int, QEvent *);
+    void messageStarted(QQuickWorkerScriptThread *, int, qint64 queuedAt);
+    void messageFinished(QQuickWorkerScriptThread *);
+    bool takeMessage(QQuickWorkerScriptThread *, PendingMessage *);
+    bool hasMessages(QQuickWorkerScriptThread *) const;
+
+    QQmlEngine *m_engine;
+    mutable QMutex m_lock;
+    QElapsedTimer m_clock;
+    QList<QQuickWorkerScriptThread *> m_threads;
+    QHash<int, Script *> m_scripts;
+    int m_nextId;
 };
 
 class QQmlV8Function;
@@ -90,6 +136,7 @@ class Q_AUTOTEST_EXPORT QQuickWorkerScript : public QObject, public QQmlParserSt
 {
     Q_OBJECT
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(bool stateless READ stateless WRITE setStateless NOTIFY statelessChanged)
 
     Q_INTERFACES(QQmlParserStatus)
 public:
@@ -99,11 +146,17 @@ public:
     QUrl source() const;
     void setSource(const QUrl &);
 
+    bool stateless() const;
+    void setStateless(bool);
+
+    QQuickWorkerScriptEngine::Statistics statistics() const;
+
 public slots:
     void sendMessage(QQmlV8Function*);
 
 signals:
     void sourceChanged();
+    void statelessChanged();
     void message(const QQmlV8Handle &messageObject);
 
 protected:
@@ -117,6 +170,7 @@ private:
     int m_scriptId;
     QUrl m_source;
     bool m_componentComplete;
+    bool m_stateless;
 };
 
 QT_END_NAMESPACE
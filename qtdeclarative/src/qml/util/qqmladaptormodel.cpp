@@ -114,6 +114,7 @@ public:
 
     void setValue(const QString &role, const QVariant &value);
     bool resolveIndex(const QQmlAdaptorModel &model, int idx);
+    bool recycle(const QQmlAdaptorModel &model, int idx);
 
     static v8::Handle<v8::Value> get_property(v8::Local<v8::String>, const v8::AccessorInfo &info);
     static void set_property(
@@ -330,6 +331,19 @@ bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
     }
 }
 
+bool QQmlDMCachedModelData::recycle(const QQmlAdaptorModel &, int idx)
+{
+    Q_ASSERT(idx >= 0);
+    index = idx;
+    cachedData.clear();
+    emit modelIndexChanged();
+    const QMetaObject *meta = metaObject();
+    const int propertyCount = type->propertyRoles.count();
+    for (int i = 0; i < propertyCount; ++i)
+        QMetaObject::activate(this, meta, i, 0);
+    return true;
+}
+
 v8::Handle<v8::Value> QQmlDMCachedModelData::get_property(
         v8::Local<v8::String>, const v8::AccessorInfo &info)
 {
@@ -379,7 +393,7 @@ void QQmlDMCachedModelData::set_property(
 class QQmlDMAbstractItemModelData : public QQmlDMCachedModelData
 {
     Q_OBJECT
-    Q_PROPERTY(bool hasModelChildren READ hasModelChildren CONSTANT)
+    Q_PROPERTY(bool hasModelChildren READ hasModelChildren NOTIFY hasModelChildrenChanged)
 public:
     QQmlDMAbstractItemModelData(
             QQmlDelegateModelItemMetaType *metaType,
@@ -399,6 +413,13 @@ public:
         }
     }
 
+    bool recycle(const QQmlAdaptorModel &model, int idx)
+    {
+        QQmlDMCachedModelData::recycle(model, idx);
+        emit hasModelChildrenChanged();
+        return true;
+    }
+
     QVariant value(int role) const
     {
         return type->model->aim()->index(index, 0, type->model->rootIndex).data(role);
@@ -438,6 +459,9 @@ public:
             return v8::Boolean::New(false);
         }
     }
+
+Q_SIGNALS:
+    void hasModelChildrenChanged();
 };
 
 class VDMAbstractItemModelDataType : public VDMModelDelegateDataType
@@ -626,6 +650,15 @@ public:
         }
     }
 
+    bool recycle(const QQmlAdaptorModel &model, int idx)
+    {
+        Q_ASSERT(idx >= 0);
+        index = idx;
+        cachedData = model.list.at(idx);
+        emit modelIndexChanged();
+        emit modelDataChanged();
+        return true;
+    }
 
 Q_SIGNALS:
     void modelDataChanged();
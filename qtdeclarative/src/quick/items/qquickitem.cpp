@@ -62,6 +62,7 @@
 
 #include <private/qqmlglobal_p.h>
 #include <private/qqmlengine_p.h>
+#include <private/qqmldata_p.h>
 #include <QtQuick/private/qquickstategroup_p.h>
 #include <private/qqmlopenmetaobject_p.h>
 #include <QtQuick/private/qquickstate_p.h>
@@ -83,6 +84,8 @@ QT_BEGIN_NAMESPACE
 static bool qsg_leak_check = !qgetenv("QML_LEAK_CHECK").isEmpty();
 #endif
 
+DEFINE_BOOL_CONFIG_OPTION(qmlLazyBindings, QML_LAZY_BINDINGS)
+
 #ifdef FOCUS_DEBUG
 void printFocusTree(QQuickItem *item, QQuickItem *scope = 0, int depth = 1);
 void printFocusTree(QQuickItem *item, QQuickItem *scope, int depth)
@@ -2287,7 +2290,8 @@ void QQuickItem::setParentItem(QQuickItem *parentItem)
     else if (d->window)
         QQuickWindowPrivate::get(d->window)->parentlessItems.insert(this);
 
-    d->setEffectiveVisibleRecur(d->calcEffectiveVisible());
+    if (!d->setEffectiveVisibleRecur(d->calcEffectiveVisible()))
+        d->updateBindingSuspension();
     d->setEffectiveEnableRecur(0, d->calcEffectiveEnable());
 
     if (d->parentItem) {
@@ -2692,6 +2696,7 @@ QQuickItemPrivate::QQuickItemPrivate()
     , culled(false)
     , hasCursor(false)
     , activeFocusOnTab(false)
+    , bindingsSuspended(false)
     , dirtyAttributes(0)
     , nextDirtyItem(0)
     , prevDirtyItem(0)
@@ -5122,10 +5127,13 @@ qreal QQuickItem::opacity() const
 void QQuickItem::setOpacity(qreal o)
 {
     Q_D(QQuickItem);
-    if (d->opacity() == o)
+    const qreal oldOpacity = d->opacity();
+    if (oldOpacity == o)
         return;
 
     d->extra.value().opacity = o;
+    if ((oldOpacity == 0.) != (o == 0.))
+        d->updateBindingSuspension();
 
     d->dirty(QQuickItemPrivate::OpacityValue);
 
@@ -5299,6 +5307,8 @@ bool QQuickItemPrivate::setEffectiveVisibleRecur(bool newEffectiveVisible)
     effectiveVisible = newEffectiveVisible;
     dirty(Visible);
     if (parentItem) QQuickItemPrivate::get(parentItem)->dirty(ChildrenStackingChanged);
+    // The children update their own suspension as they are visited below
+    updateBindingSuspension(false);
 
     if (window) {
         QQuickWindowPrivate *windowPriv = QQuickWindowPrivate::get(window);
@@ -5324,6 +5334,38 @@ bool QQuickItemPrivate::setEffectiveVisibleRecur(bool newEffectiveVisible)
     return true;    // effective visibility DID change
 }
 
+/*
+    With QML_LAZY_BINDINGS set, bindings on items that are not effectively visible,
+    or that are inside an item with zero opacity, only mark themselves dirty when
+    their dependencies change.  They are evaluated once the item is shown again, or
+    when the property they target is read from QML.
+
+    If \a recursive is false, the children are left for the caller to update.
+*/
+void QQuickItemPrivate::updateBindingSuspension(bool recursive)
+{
+    if (!qmlLazyBindings())
+        return;
+
+    Q_Q(QQuickItem);
+
+    const bool suspend = !effectiveVisible || opacity() == 0.
+            || (parentItem && QQuickItemPrivate::get(parentItem)->bindingsSuspended);
+    if (suspend == bindingsSuspended)
+        return;
+
+    // Create the QQmlData when suspending, as later calls return early and would never
+    // mark declarative data that is only created afterwards
+    bindingsSuspended = suspend;
+    if (QQmlData *ddata = QQmlData::get(q, suspend && !wasDeleted))
+        ddata->setBindingsSuspended(suspend);
+
+    if (!recursive)
+        return;
+    for (int ii = 0; ii < childItems.count(); ++ii)
+        QQuickItemPrivate::get(childItems.at(ii))->updateBindingSuspension();
+}
+
 bool QQuickItemPrivate::calcEffectiveEnable() const
 {
     // XXX todo - Should the effective enable of an element with no parent just be the current
@@ -422,6 +422,7 @@ public:
     bool hasCursor:1;
     // Bit 32
     bool activeFocusOnTab:1;
+    bool bindingsSuspended:1;
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
@@ -552,6 +553,7 @@ public:
 
     bool calcEffectiveVisible() const;
     bool setEffectiveVisibleRecur(bool);
+    void updateBindingSuspension(bool recursive = true);
     bool calcEffectiveEnable() const;
     void setEffectiveEnableRecur(QQuickItem *scope, bool);
 
@@ -63,11 +63,13 @@
 #include <QtGui/qstylehints.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qabstractanimation.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtQml/qqmlincubator.h>
 
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 #include <private/qqmlprofilerservice_p.h>
+#include <private/qqmldata_p.h>
 #include <private/qqmlmemoryprofiler_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -97,8 +99,10 @@ public:
     QQuickWindowIncubationController(QSGRenderLoop *loop)
         : m_renderLoop(loop), m_timer(0)
     {
-        // Allow incubation for 1/3 of a frame.
-        m_incubation_time = qMax(1, int(1000 / QGuiApplication::primaryScreen()->refreshRate()) / 3);
+        // Incubate in the time left until the next frame is due, keeping a
+        // quarter of a frame free for animations, polishing and syncing.
+        m_incubation_time = qMax(1, m_renderLoop->frameInterval() / 3);
+        m_frame_reserve = qMax(1, m_renderLoop->frameInterval() / 4);
 
         m_animation_driver = m_renderLoop->animationDriver();
         if (m_animation_driver) {
@@ -123,16 +127,34 @@ protected:
         }
     }
 
+    void incubateWithinFrame() {
+        const int remaining = m_renderLoop->remainingFrameTime();
+        const int countBefore = incubatingObjectCount();
+
+        QElapsedTimer timer;
+        timer.start();
+        incubateFor(qMax(1, remaining - m_frame_reserve));
+        const qint64 elapsed = timer.elapsed();
+
+        const int incubated = qMax(0, countBefore - incubatingObjectCount());
+        ++m_statistics.frames;
+        if (elapsed > remaining)
+            ++m_statistics.framesMissed;
+        m_statistics.objectsIncubated += incubated;
+        m_statistics.maximumObjectsPerFrame = qMax(m_statistics.maximumObjectsPerFrame, incubated);
+        m_statistics.incubationTime += elapsed;
+    }
+
+public:
+    QQuickWindowIncubationStatistics statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = QQuickWindowIncubationStatistics(); }
+
 public slots:
     void incubate() {
         if (incubatingObjectCount()) {
-            if (m_renderLoop->interleaveIncubation()) {
-                incubateFor(m_incubation_time);
-            } else {
-                incubateFor(m_incubation_time * 2);
-                if (incubatingObjectCount())
-                    incubateAgain();
-            }
+            incubateWithinFrame();
+            if (!m_renderLoop->interleaveIncubation() && incubatingObjectCount())
+                incubateAgain();
         }
     }
 
@@ -148,8 +170,10 @@ protected:
 private:
     QSGRenderLoop *m_renderLoop;
     int m_incubation_time;
+    int m_frame_reserve;
     QAnimationDriver *m_animation_driver;
     int m_timer;
+    QQuickWindowIncubationStatistics m_statistics;
 };
 
 #include "qquickwindow.moc"
@@ -247,6 +271,9 @@ void QQuickWindow::focusInEvent(QFocusEvent *ev)
 
 void QQuickWindowPrivate::polishItems()
 {
+    // Evaluate coalesced bindings first, so items polish with their final values
+    QQmlData::flushQueuedBindings();
+
     int maxPolishCycles = 100000;
 
     while (!itemsToPolish.isEmpty() && --maxPolishCycles > 0) {
@@ -2947,6 +2974,21 @@ QQmlIncubationController *QQuickWindow::incubationController() const
     return d->incubationController;
 }
 
+/*
+    Returns how much incubation the window's incubation controller has done so far,
+    or empty statistics if incubationController() was never called.
+*/
+QQuickWindowIncubationStatistics QQuickWindowPrivate::incubationStatistics() const
+{
+    return incubationController ? incubationController->statistics() : QQuickWindowIncubationStatistics();
+}
+
+void QQuickWindowPrivate::resetIncubationStatistics()
+{
+    if (incubationController)
+        incubationController->resetStatistics();
+}
+
 
 
 /*!
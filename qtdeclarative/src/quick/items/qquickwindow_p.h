@@ -126,6 +126,20 @@ private:
     Qt::KeyboardModifiers m_delayedMods;
 };
 
+struct QQuickWindowIncubationStatistics
+{
+    QQuickWindowIncubationStatistics()
+        : frames(0), framesMissed(0), objectsIncubated(0), maximumObjectsPerFrame(0), incubationTime(0) {}
+
+    int frames;                 // frames in which incubation was run
+    int framesMissed;           // frames in which incubation overran the time left until the next frame
+    int objectsIncubated;       // incubation requests completed
+    int maximumObjectsPerFrame;
+    qint64 incubationTime;      // total milliseconds spent incubating
+
+    qreal objectsPerFrame() const { return frames ? qreal(objectsIncubated) / frames : 0; }
+};
+
 class Q_QUICK_PRIVATE_EXPORT QQuickWindowPrivate : public QWindowPrivate
 {
 public:
@@ -255,6 +269,8 @@ public:
     QHash<int, QQuickItem *> itemForTouchPointId;
 
     mutable QQuickWindowIncubationController *incubationController;
+    QQuickWindowIncubationStatistics incubationStatistics() const;
+    void resetIncubationStatistics();
 
     static bool defaultAlphaBuffer;
 
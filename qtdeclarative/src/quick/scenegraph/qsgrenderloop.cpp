@@ -48,6 +48,7 @@
 #include <QtCore/private/qabstractanimation_p.h>
 
 #include <QtGui/QOpenGLContext>
+#include <QtGui/QScreen>
 #include <QtGui/private/qguiapplication_p.h>
 #include <qpa/qplatformintegration.h>
 
@@ -78,10 +79,67 @@ DEFINE_BOOL_CONFIG_OPTION(qmlForceThreadedRenderer, QML_FORCE_THREADED_RENDERER)
 
 QSGRenderLoop *QSGRenderLoop::s_instance = 0;
 
+QSGRenderLoop::QSGRenderLoop()
+    : m_lastFrameSwap(-1)
+{
+    // There may be no screen yet, and some platforms report 0 or something
+    // bogus for the refresh rate
+    QScreen *screen = QGuiApplication::primaryScreen();
+    qreal refreshRate = screen ? screen->refreshRate() : 0;
+    m_frameInterval = refreshRate < 1 ? 16 : int(1000 / refreshRate);
+    m_frameTimer.start();
+}
+
 QSGRenderLoop::~QSGRenderLoop()
 {
 }
 
+/*!
+    Records that a frame was just presented. Called by the render loop
+    implementations after swapping, possibly from the render thread.
+ */
+void QSGRenderLoop::markFrameSwapped()
+{
+    QMutexLocker locker(&m_frameMutex);
+    m_lastFrameSwap = m_frameTimer.elapsed();
+}
+
+/*!
+    Returns the expected number of milliseconds between two frames.
+ */
+int QSGRenderLoop::frameInterval() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    return m_frameInterval;
+}
+
+/*!
+    Sets the interval between frames to \a msecs, for render loops that know
+    better than the primary screen's refresh rate.
+ */
+void QSGRenderLoop::setFrameInterval(int msecs)
+{
+    QMutexLocker locker(&m_frameMutex);
+    m_frameInterval = qMax(1, msecs);
+}
+
+/*!
+    Returns the number of milliseconds left until the next frame is due,
+    assuming frames are presented once per frameInterval() starting from
+    the last swap. If no frame is being rendered, a full interval is
+    available.
+ */
+int QSGRenderLoop::remainingFrameTime() const
+{
+    QMutexLocker locker(&m_frameMutex);
+    if (m_lastFrameSwap < 0)
+        return m_frameInterval;
+    const qint64 sinceSwap = m_frameTimer.elapsed() - m_lastFrameSwap;
+    if (sinceSwap >= m_frameInterval)
+        return m_frameInterval;
+    return m_frameInterval - int(sinceSwap);
+}
+
 class QSGGuiThreadRenderLoop : public QSGRenderLoop
 {
     Q_OBJECT
@@ -298,6 +356,7 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
 
     if (alsoSwap && window->isVisible()) {
         gl->swapBuffers(window);
+        markFrameSwapped();
         cd->fireFrameSwapped();
     }
 
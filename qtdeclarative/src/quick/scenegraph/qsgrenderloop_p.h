@@ -43,6 +43,8 @@
 #define QSGRenderLoop_P_H
 
 #include <QtGui/QImage>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
 #include <private/qtquickglobal_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -56,6 +58,7 @@ class Q_QUICK_PRIVATE_EXPORT QSGRenderLoop : public QObject
     Q_OBJECT
 
 public:
+    QSGRenderLoop();
     virtual ~QSGRenderLoop();
 
     virtual void show(QQuickWindow *window) = 0;
@@ -81,11 +84,23 @@ public:
 
     virtual bool interleaveIncubation() const { return false; }
 
+    int frameInterval() const;
+    int remainingFrameTime() const;
+
 signals:
     void timeToIncubate();
 
+protected:
+    void markFrameSwapped();
+    void setFrameInterval(int msecs);
+
 private:
     static QSGRenderLoop *s_instance;
+
+    mutable QMutex m_frameMutex;
+    QElapsedTimer m_frameTimer;
+    qint64 m_lastFrameSwap;
+    int m_frameInterval;
 };
 
 QT_END_NAMESPACE
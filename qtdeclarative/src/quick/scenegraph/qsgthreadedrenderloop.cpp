@@ -579,6 +579,7 @@ void QSGRenderThread::syncAndRender()
         int waitTime = vsyncDelta - (int) waitTimer.elapsed();
         if (waitTime > 0)
             msleep(waitTime);
+        wm->markFrameSwapped();
         emit wm->timeToIncubate();
         return;
     }
@@ -606,6 +607,7 @@ void QSGRenderThread::syncAndRender()
         d->fireFrameSwapped();
     }
     RLDEBUG("    Render:  - rendering done");
+    wm->markFrameSwapped();
     emit wm->timeToIncubate();
 
 #ifndef QSG_NO_RENDER_TIMING
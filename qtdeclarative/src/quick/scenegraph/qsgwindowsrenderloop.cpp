@@ -435,6 +435,7 @@ void QSGWindowsRenderLoop::renderWindow(QQuickWindow *window)
 
     RLDEBUG(" - swapping");
     m_gl->swapBuffers(window);
+    markFrameSwapped();
     QSG_RENDER_TIMING_SAMPLE(time_swapped);
 
     RLDEBUG(" - frameDone");
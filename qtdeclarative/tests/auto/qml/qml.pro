@@ -51,6 +51,7 @@ PRIVATETESTS += \
     qqmlparser \
     qquickworkerscript \
     qqmlbundle \
+    qqmldiskcache \
     qrcqml \
     v4 \
     qqmltimer \
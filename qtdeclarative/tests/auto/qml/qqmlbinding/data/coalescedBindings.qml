@@ -0,0 +1,11 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+
+    property int source: 0
+    property int doubled: source * 2
+    property int sum: { root.evaluated(); return source + doubled }
+
+    signal evaluated
+}
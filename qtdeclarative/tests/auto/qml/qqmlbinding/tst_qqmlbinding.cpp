@@ -39,9 +39,11 @@
 **
 ****************************************************************************/
 #include <qtest.h>
+#include <QtTest/QSignalSpy>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <private/qqmlbind_p.h>
+#include <private/qqmldata_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 
@@ -58,6 +60,7 @@ private slots:
     void restoreBindingWithLoop();
     void restoreBindingWithoutCrash();
     void deletedObject();
+    void coalescedBindings();
 
 private:
     QQmlEngine engine;
@@ -232,6 +235,49 @@ void tst_qqmlbinding::deletedObject()
     delete rect;
 }
 
+// Restores the process wide coalescing setting, also if the test fails
+struct BindingCoalescingGuard
+{
+    BindingCoalescingGuard(bool enabled) : wasEnabled(QQmlData::isBindingCoalescingEnabled())
+    { QQmlData::setBindingCoalescingEnabled(enabled); }
+    ~BindingCoalescingGuard() { QQmlData::setBindingCoalescingEnabled(wasEnabled); }
+
+    bool wasEnabled;
+};
+
+void tst_qqmlbinding::coalescedBindings()
+{
+    BindingCoalescingGuard guard(true);
+    QVERIFY(QQmlData::isBindingCoalescingEnabled());
+
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("coalescedBindings.qml"));
+    QScopedPointer<QObject> root(c.create());
+    QVERIFY(!root.isNull());
+    QSignalSpy spy(root.data(), SIGNAL(evaluated()));
+
+    for (int ii = 1; ii <= 10; ++ii)
+        root->setProperty("source", ii);
+
+    // Nothing is evaluated until the queue is flushed
+    QCOMPARE(spy.count(), 0);
+    QCOMPARE(root->property("doubled").toInt(), 0);
+
+    QQmlData::flushQueuedBindings();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(root->property("doubled").toInt(), 20);
+    QCOMPARE(root->property("sum").toInt(), 30);
+
+    // The posted flush finds nothing left to do
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(spy.count(), 1);
+
+    root->setProperty("source", 11);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(root->property("sum").toInt(), 33);
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
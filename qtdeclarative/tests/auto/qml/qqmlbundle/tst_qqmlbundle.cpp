@@ -48,6 +48,7 @@
 #include <QQmlComponent>
 #include "../../shared/util.h"
 #include <private/qqmlbundle_p.h>
+#include <private/qqmldiskcache_p.h>
 
 class tst_qqmlbundle : public QQmlDataTest
 {
@@ -65,9 +66,14 @@ private slots:
 
     void import();
 
+    void index();
+    void precompiled_data();
+    void precompiled();
+
 private:
     QStringList findFiles(const QDir &d);
     bool makeBundle(const QString &path, const QString &name);
+    bool precompileBundle(const QString &bundleFile, const QString &fileName, const QByteArray &source);
 };
 
 void tst_qqmlbundle::initTestCase()
@@ -211,6 +217,128 @@ void tst_qqmlbundle::import()
     delete o;
 }
 
+// Test that lookups use the index written to the bundle
+void tst_qqmlbundle::index()
+{
+    QVERIFY(makeBundle(testFile("componentFromBundle"), "indexed.bundle"));
+    const QString bundleFile = testFile("componentFromBundle/indexed.bundle");
+
+    {
+        QQmlBundle bundle(bundleFile);
+        QVERIFY(bundle.open(QFile::ReadWrite));
+        QVERIFY(bundle.writeIndex());
+    }
+
+    {
+        QQmlBundle bundle(bundleFile);
+        QVERIFY(bundle.open(QFile::ReadOnly));
+
+        QList<const QQmlBundle::FileEntry *> files = bundle.files();
+        QVERIFY(!files.isEmpty());
+        foreach (const QQmlBundle::FileEntry *entry, files)
+            QCOMPARE(bundle.find(entry->fileName()), entry);
+        QVERIFY(bundle.find(QLatin1String("missing.qml")) == 0);
+    }
+
+    QQmlEngine engine;
+    engine.addNamedBundle("mybundle", bundleFile);
+
+    QQmlComponent component(&engine, QUrl("bundle://mybundle/test.qml"));
+    QVERIFY(component.isReady());
+
+    QObject *o = component.create();
+    QVERIFY(o != 0);
+    QCOMPARE(o->property("test1").toInt(), 11);
+    delete o;
+}
+
+void tst_qqmlbundle::precompiled_data()
+{
+    QTest::addColumn<QByteArray>("compiledSource");
+    QTest::addColumn<bool>("used");
+
+    QTest::newRow("current") << QByteArray() << true;
+    QTest::newRow("stale") << QByteArray("import QtQuick 2.0\nQtObject { property int test1: 12 }\n") << false;
+}
+
+// Test that bundle entries precompiled as by qmlcompile are restored, unless
+// they were compiled from other contents
+void tst_qqmlbundle::precompiled()
+{
+    QFETCH(QByteArray, compiledSource);
+    QFETCH(bool, used);
+
+    QVERIFY(makeBundle(testFile("componentFromBundle"), "precompiled.bundle"));
+    const QString bundleFile = testFile("componentFromBundle/precompiled.bundle");
+    QVERIFY(precompileBundle(bundleFile, QLatin1String("test.qml"), compiledSource));
+
+    QByteArray source;
+    {
+        QQmlBundle bundle(bundleFile);
+        QVERIFY(bundle.open(QFile::ReadOnly));
+        const QQmlBundle::FileEntry *file = bundle.find(QLatin1String("test.qml"));
+        QVERIFY(file);
+        source = QByteArray(file->contents(), file->fileSize());
+
+        const QQmlBundle::FileEntry *compiled = bundle.link(file, QLatin1String("qml:compiled"));
+        QVERIFY(compiled);
+        QByteArray data(compiled->contents(), compiled->fileSize());
+        QScopedPointer<QQmlDiskCache::Unit> unit(QQmlDiskCache::load(data, QQmlDiskCache::sourceHash(source.constData(), source.size())));
+        QCOMPARE(!unit.isNull(), used);
+    }
+
+    // Documents compiled from source are shared with other engines, restored
+    // ones are not, which tells whether the precompiled entry was used
+    QQmlDiskCache::setSharingEnabled(true);
+    {
+        QQmlEngine engine;
+        engine.addNamedBundle("mybundle", bundleFile);
+
+        QQmlComponent component(&engine, QUrl("bundle://mybundle/test.qml"));
+        QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+        QScopedPointer<QObject> o(component.create());
+        QVERIFY(o);
+        QCOMPARE(o->property("test1").toInt(), 11);
+        QCOMPARE(o->property("test2").toBool(), true);
+
+        QScopedPointer<QQmlDiskCache::Unit> shared(QQmlDiskCache::loadShared(QUrl("bundle://mybundle/test.qml"),
+                                                   QQmlDiskCache::sourceHash(source.constData(), source.size())));
+        QCOMPARE(shared.isNull(), used);
+    }
+    QQmlDiskCache::setSharingEnabled(false);
+}
+
+// Adds compiled data for <fileName> to <bundleFile>, as qmlcompile does.  The data
+// is compiled from <source>, or from the bundled file if <source> is empty.
+bool tst_qqmlbundle::precompileBundle(const QString &bundleFile, const QString &fileName, const QByteArray &source)
+{
+    QByteArray compiled;
+    {
+        QQmlEngine engine;
+        if (!engine.addNamedBundle("mybundle", bundleFile))
+            return false;
+
+        QQmlBundle bundle(bundleFile);
+        if (!bundle.open(QFile::ReadOnly))
+            return false;
+        const QQmlBundle::FileEntry *file = bundle.find(fileName);
+        if (!file)
+            return false;
+
+        QByteArray contents = source.isEmpty() ? QByteArray(file->contents(), file->fileSize()) : source;
+        QList<QQmlError> errors;
+        compiled = QQmlDiskCache::precompile(&engine, QUrl("bundle://mybundle/" + fileName), contents, &errors);
+        if (compiled.isEmpty())
+            return false;
+    }
+
+    QQmlBundle bundle(bundleFile);
+    return bundle.open(QFile::ReadWrite)
+        && bundle.addMetaLink(fileName, QLatin1String("qml:compiled"), compiled)
+        && bundle.writeIndex();
+}
+
 // Transform the data available under <path>/bundledata to a bundle named <path>/<name>
 bool tst_qqmlbundle::makeBundle(const QString &path, const QString &name)
 {
@@ -0,0 +1,6 @@
+import QtQuick 2.0
+
+Item {
+    property int value: 1
+    property int broken: }
+}
@@ -0,0 +1,8 @@
+import QtQuick 2.0
+
+Item {
+    property int total: a.value + b.value + b.c.value
+
+    ParallelLoadingA { id: a }
+    ParallelLoadingB { id: b }
+}
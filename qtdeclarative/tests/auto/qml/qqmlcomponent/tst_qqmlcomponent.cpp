@@ -48,6 +48,9 @@
 #include <QtQuick>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuick/private/qquickmousearea_p.h>
+#include <QtQml/private/qqmltypeloader_p.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtemporarydir.h>
 #include <qcolor.h>
 #include "../../shared/util.h"
 #include "testhttpserver.h"
@@ -96,6 +99,32 @@ public slots:
     }
 };
 
+// Loads a document with an engine of its own
+class LoaderThread : public QThread
+{
+public:
+    LoaderThread(const QUrl &url) : url(url), total(-1) {}
+
+    QUrl url;
+    QString errorString;
+    int total;
+
+protected:
+    virtual void run()
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, url);
+        if (!component.isReady()) {
+            errorString = component.errorString();
+            return;
+        }
+
+        QScopedPointer<QObject> object(component.create());
+        if (object)
+            total = object->property("total").toInt();
+    }
+};
+
 class tst_qqmlcomponent : public QQmlDataTest
 {
     Q_OBJECT
@@ -117,6 +146,9 @@ private slots:
     void onDestructionCount();
     void recursion();
     void recursionContinuation();
+    void parallelLoading();
+    void parallelLoadingThreads();
+    void parallelLoadingError();
 
 private:
     QQmlEngine engine;
@@ -442,6 +474,111 @@ void tst_qqmlcomponent::recursionContinuation()
     QVERIFY(object->property("success").toBool());
 }
 
+void tst_qqmlcomponent::parallelLoading()
+{
+    QQmlTypeLoader::setParallelLoadingEnabled(true);
+    QVERIFY(QQmlTypeLoader::isParallelLoadingEnabled());
+
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, testFileUrl("parallelLoading.qml"));
+        QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+        QObject *object = component.create();
+        QVERIFY(object != 0);
+        QCOMPARE(object->property("total").toInt(), 111);
+        delete object;
+    }
+
+    QQmlTypeLoader::setParallelLoadingEnabled(false);
+    QVERIFY(!QQmlTypeLoader::isParallelLoadingEnabled());
+}
+
+// Several engines, each parsing a tree of dependencies on its parser pool, while
+// parallel loading is toggled from another thread
+void tst_qqmlcomponent::parallelLoadingThreads()
+{
+    const int typeCount = 24;
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // Type<n> refers to Type<n + 1> and Type<n + 2>, so that the documents are
+    // parsed at several levels of the tree
+    for (int ii = 0; ii < typeCount; ++ii) {
+        QFile file(dir.path() + QString::fromLatin1("/Type%1.qml").arg(ii));
+        QVERIFY(file.open(QFile::WriteOnly));
+        QByteArray source = "import QtQml 2.0\nQtObject {\n";
+        source += "    property int value: " + QByteArray::number(ii) + "\n";
+        for (int jj = ii + 1; jj < qMin(ii + 3, typeCount); ++jj)
+            source += "    property QtObject child" + QByteArray::number(jj) + ": Type"
+                      + QByteArray::number(jj) + " {}\n";
+        source += "}\n";
+        QVERIFY(file.write(source) == source.size());
+    }
+
+    int expectedTotal = 0;
+    QFile file(dir.path() + QLatin1String("/main.qml"));
+    QVERIFY(file.open(QFile::WriteOnly));
+    QByteArray source = "import QtQml 2.0\nQtObject {\n    property int total: 0";
+    for (int ii = 0; ii < typeCount; ++ii) {
+        source += " + t" + QByteArray::number(ii) + ".value";
+        expectedTotal += ii;
+    }
+    source += "\n";
+    for (int ii = 0; ii < typeCount; ++ii)
+        source += "    property QtObject t" + QByteArray::number(ii) + ": Type"
+                  + QByteArray::number(ii) + " {}\n";
+    source += "}\n";
+    QVERIFY(file.write(source) == source.size());
+    file.close();
+
+    QQmlTypeLoader::setParallelLoadingEnabled(true);
+
+    QList<LoaderThread *> threads;
+    for (int ii = 0; ii < 4; ++ii)
+        threads << new LoaderThread(QUrl::fromLocalFile(file.fileName()));
+    foreach (LoaderThread *thread, threads)
+        thread->start();
+
+    while (!threads.first()->isFinished()) {
+        QQmlTypeLoader::setParallelLoadingEnabled(false);
+        QQmlTypeLoader::setParallelLoadingEnabled(true);
+    }
+
+    foreach (LoaderThread *thread, threads) {
+        QVERIFY(thread->wait());
+        QVERIFY2(thread->errorString.isEmpty(), qPrintable(thread->errorString));
+        QCOMPARE(thread->total, expectedTotal);
+    }
+    qDeleteAll(threads);
+
+    QQmlTypeLoader::setParallelLoadingEnabled(false);
+}
+
+// Errors found on the parser pool are reported for the file that contains them
+void tst_qqmlcomponent::parallelLoadingError()
+{
+    QQmlTypeLoader::setParallelLoadingEnabled(true);
+
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, testFileUrl("parallelLoadingError.qml"));
+        QVERIFY(component.isError());
+
+        bool found = false;
+        foreach (const QQmlError &error, component.errors()) {
+            if (error.url() == testFileUrl("ParallelLoadingError.qml")) {
+                QCOMPARE(error.line(), 5);
+                found = true;
+            }
+        }
+        QVERIFY2(found, qPrintable(component.errorString()));
+    }
+
+    QQmlTypeLoader::setParallelLoadingEnabled(false);
+}
+
 QTEST_MAIN(tst_qqmlcomponent)
 
 #include "tst_qqmlcomponent.moc"
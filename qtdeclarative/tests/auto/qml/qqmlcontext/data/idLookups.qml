@@ -0,0 +1,27 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+
+    property string childName: child.objectName
+    property Component nested: Component {
+        Item {
+            id: child
+            objectName: "nested"
+            property string found: child.objectName
+        }
+    }
+
+    function countLookups() {
+        var count = 0;
+        for (var ii = 0; ii < 100; ++ii) {
+            if (child.objectName == "child" && root.objectName == "root")
+                ++count;
+        }
+        return count;
+    }
+
+    objectName: "root"
+
+    Item { id: child; objectName: "child" }
+}
@@ -72,6 +72,7 @@ private slots:
 
     void qtbug_22535();
     void evalAfterInvalidate();
+    void idLookups();
 
 private:
     QQmlEngine engine;
@@ -659,6 +660,35 @@ void tst_qqmlcontext::evalAfterInvalidate()
     QCoreApplication::processEvents();
 }
 
+void tst_qqmlcontext::idLookups()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("idLookups.qml"));
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY2(o, qPrintable(component.errorString()));
+
+    // Repeated lookups resolve the same ids
+    QVariant count;
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "countLookups", Q_RETURN_ARG(QVariant, count)));
+    QCOMPARE(count.toInt(), 100);
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "countLookups", Q_RETURN_ARG(QVariant, count)));
+    QCOMPARE(count.toInt(), 100);
+
+    // Bindings still depend on the id's properties
+    QObject *child = o->findChild<QObject *>("child");
+    QVERIFY(child);
+    QCOMPARE(o->property("childName").toString(), QString("child"));
+    child->setObjectName("renamed");
+    QCOMPARE(o->property("childName").toString(), QString("renamed"));
+
+    // An id of the same name in another context is not confused with the cached one
+    QQmlComponent *nested = qvariant_cast<QQmlComponent *>(o->property("nested"));
+    QVERIFY(nested);
+    QScopedPointer<QObject> n(nested->create(qmlContext(o.data())));
+    QVERIFY(n);
+    QCOMPARE(n->property("found").toString(), QString("nested"));
+}
+
 QTEST_MAIN(tst_qqmlcontext)
 
 #include "tst_qqmlcontext.moc"
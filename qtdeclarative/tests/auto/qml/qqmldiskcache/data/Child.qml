@@ -0,0 +1,7 @@
+import QtQml 2.0
+
+QtObject {
+    property int input: 0
+    property string label: "child " + input
+    property var items: [input, input + 1]
+}
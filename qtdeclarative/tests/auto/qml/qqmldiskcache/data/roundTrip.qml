@@ -0,0 +1,24 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+
+    property int base: 3
+    property int doubled: base * 2
+    property string text: "literal"
+    property real ratio: 0.5
+    property url link: "Child.qml"
+    property int changes: 0
+    property Child child: Child { input: root.base + 1 }
+    property QtObject nested: QtObject {
+        property string name: root.text + "!"
+    }
+    property list<QtObject> entries: [
+        QtObject { objectName: "first" },
+        Child { objectName: "second"; input: 7 }
+    ]
+
+    function sum(a, b) { return a + b + base }
+
+    onBaseChanged: ++changes
+}
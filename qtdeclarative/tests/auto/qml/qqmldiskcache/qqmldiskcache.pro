@@ -0,0 +1,13 @@
+CONFIG += testcase
+TARGET = tst_qqmldiskcache
+macx:CONFIG -= app_bundle
+
+include (../../shared/util.pri)
+
+SOURCES += tst_qqmldiskcache.cpp
+
+TESTDATA = data/*
+
+CONFIG += parallel_test
+QT += core-private qml-private testlib
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,345 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "../../shared/util.h"
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QJSValue>
+#include <QQmlListReference>
+#include <private/qqmldiskcache_p.h>
+
+class tst_qqmldiskcache : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_qqmldiskcache() {}
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void roundTrip();
+    void changedSource();
+    void staleCacheFile_data();
+    void staleCacheFile();
+
+private:
+    QString cacheFile(const QUrl &url) const { return QQmlDiskCache::cacheFilePath(url); }
+
+    QTemporaryDir m_cacheDir;
+};
+
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+static bool writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+static QByteArray fileHash(const QString &fileName)
+{
+    QByteArray source = readFile(fileName);
+    return QQmlDiskCache::sourceHash(source.constData(), source.size());
+}
+
+static bool hasCacheFile(const QUrl &url, const QByteArray &sourceHash)
+{
+    QScopedPointer<QQmlDiskCache::Unit> unit(QQmlDiskCache::load(url, sourceHash));
+    return unit;
+}
+
+// Composite types get a class name with a process wide counter
+static QByteArray className(QObject *object)
+{
+    QByteArray name(object->metaObject()->className());
+    int index = name.indexOf("_QML");
+    return index == -1 ? name : name.left(index);
+}
+
+// Cache files are only written when a document is compiled, so a marker
+// appended to a cache file survives loading the document if, and only if,
+// the cache was used.
+static const char cacheMarker[] = "tst_qqmldiskcache marker";
+
+static bool markCacheFile(const QString &fileName)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::Append) && file.write(cacheMarker) == qint64(sizeof(cacheMarker) - 1);
+}
+
+static bool isCacheFileMarked(const QString &fileName)
+{
+    return readFile(fileName).endsWith(cacheMarker);
+}
+
+void tst_qqmldiskcache::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+    QVERIFY(m_cacheDir.isValid());
+}
+
+void tst_qqmldiskcache::init()
+{
+    QQmlDiskCache::setCacheDirectory(m_cacheDir.path());
+    QQmlDiskCache::setEnabled(true);
+}
+
+void tst_qqmldiskcache::cleanup()
+{
+    QQmlDiskCache::setEnabled(false);
+    QQmlDiskCache::setCacheDirectory(QString());
+}
+
+static void compareObjects(QObject *object, QObject *expected)
+{
+    QVERIFY(object);
+    QVERIFY(expected);
+    QCOMPARE(className(object), className(expected));
+    QCOMPARE(object->objectName(), expected->objectName());
+
+    const QMetaObject *mo = expected->metaObject();
+    QCOMPARE(object->metaObject()->propertyCount(), mo->propertyCount());
+    for (int ii = 0; ii < mo->propertyCount(); ++ii) {
+        QMetaProperty property = mo->property(ii);
+        QCOMPARE(QByteArray(object->metaObject()->property(ii).name()), QByteArray(property.name()));
+
+        QVariant value = property.read(object);
+        QVariant expectedValue = property.read(expected);
+        if (QObject *child = qvariant_cast<QObject *>(expectedValue)) {
+            compareObjects(qvariant_cast<QObject *>(value), child);
+        } else if (expectedValue.userType() == qMetaTypeId<QQmlListReference>()) {
+            continue;
+        } else if (expectedValue.userType() == qMetaTypeId<QJSValue>()) {
+            QCOMPARE(value.value<QJSValue>().toVariant(), expectedValue.value<QJSValue>().toVariant());
+        } else {
+            QCOMPARE(value, expectedValue);
+        }
+    }
+}
+
+static void compareLists(QObject *object, QObject *expected, const char *name)
+{
+    QQmlListReference list(object, name);
+    QQmlListReference expectedList(expected, name);
+    QVERIFY(list.isValid());
+    QCOMPARE(list.count(), expectedList.count());
+    for (int ii = 0; ii < expectedList.count(); ++ii)
+        compareObjects(list.at(ii), expectedList.at(ii));
+}
+
+// A document restored from the cache creates the same object tree, with the
+// same bindings, as the compiled document
+void tst_qqmldiskcache::roundTrip()
+{
+    QUrl url = testFileUrl("roundTrip.qml");
+    QUrl childUrl = testFileUrl("Child.qml");
+    QFile::remove(cacheFile(url));
+    QFile::remove(cacheFile(childUrl));
+
+    QQmlEngine compiledEngine;
+    QQmlComponent compiledComponent(&compiledEngine, url);
+    QScopedPointer<QObject> compiled(compiledComponent.create());
+    QVERIFY2(compiled, qPrintable(compiledComponent.errorString()));
+
+    QVERIFY(hasCacheFile(url, fileHash(testFile("roundTrip.qml"))));
+    QVERIFY(hasCacheFile(childUrl, fileHash(testFile("Child.qml"))));
+    QVERIFY(markCacheFile(cacheFile(url)));
+    QVERIFY(markCacheFile(cacheFile(childUrl)));
+
+    QQmlEngine cachedEngine;
+    QQmlComponent cachedComponent(&cachedEngine, url);
+    QScopedPointer<QObject> cached(cachedComponent.create());
+    QVERIFY2(cached, qPrintable(cachedComponent.errorString()));
+
+    QVERIFY(isCacheFileMarked(cacheFile(url)));
+    QVERIFY(isCacheFileMarked(cacheFile(childUrl)));
+
+    compareObjects(cached.data(), compiled.data());
+    compareLists(cached.data(), compiled.data(), "entries");
+    QCOMPARE(cached->property("doubled").toInt(), 6);
+    QCOMPARE(cached->property("link").toUrl(), childUrl);
+
+    // Bindings and signal handlers are restored as well
+    QObject *objects[] = { compiled.data(), cached.data() };
+    for (int ii = 0; ii < 2; ++ii) {
+        QObject *object = objects[ii];
+        object->setProperty("base", 10);
+        QCOMPARE(object->property("doubled").toInt(), 20);
+        QCOMPARE(object->property("changes").toInt(), 1);
+
+        QObject *child = qvariant_cast<QObject *>(object->property("child"));
+        QVERIFY(child);
+        QCOMPARE(child->property("input").toInt(), 11);
+        QCOMPARE(child->property("label").toString(), QString("child 11"));
+
+        object->setProperty("text", QString("changed"));
+        QObject *nested = qvariant_cast<QObject *>(object->property("nested"));
+        QVERIFY(nested);
+        QCOMPARE(nested->property("name").toString(), QString("changed!"));
+
+        QVariant result;
+        QVERIFY(QMetaObject::invokeMethod(object, "sum", Q_RETURN_ARG(QVariant, result),
+                                          Q_ARG(QVariant, 1), Q_ARG(QVariant, 2)));
+        QCOMPARE(result.toInt(), 13);
+    }
+    compareObjects(cached.data(), compiled.data());
+}
+
+// A cache file written for another version of the source is replaced
+void tst_qqmldiskcache::changedSource()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString fileName = dir.path() + QLatin1String("/Changed.qml");
+    QUrl url = QUrl::fromLocalFile(fileName);
+
+    QVERIFY(writeFile(fileName, "import QtQml 2.0\nQtObject { property int value: 1 }\n"));
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, url);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 1);
+    }
+    QByteArray oldHash = fileHash(fileName);
+    QVERIFY(hasCacheFile(url, oldHash));
+
+    QVERIFY(writeFile(fileName, "import QtQml 2.0\nQtObject { property int value: 2; property int other: 3 }\n"));
+    QVERIFY(!hasCacheFile(url, fileHash(fileName)));
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, url);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 2);
+        QCOMPARE(object->property("other").toInt(), 3);
+    }
+
+    // The source was compiled, and the cache file replaced
+    QVERIFY(hasCacheFile(url, fileHash(fileName)));
+    QVERIFY(!hasCacheFile(url, oldHash));
+}
+
+void tst_qqmldiskcache::staleCacheFile_data()
+{
+    QTest::addColumn<QString>("damage");
+
+    QTest::newRow("build id") << "buildId";
+    QTest::newRow("magic") << "magic";
+    QTest::newRow("truncated header") << "truncatedHeader";
+    QTest::newRow("truncated data") << "truncatedData";
+    QTest::newRow("empty") << "empty";
+}
+
+// Cache files that cannot be used fall back to compiling the source, which
+// writes a valid cache file again
+void tst_qqmldiskcache::staleCacheFile()
+{
+    QFETCH(QString, damage);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString fileName = dir.path() + QLatin1String("/Stale.qml");
+    QUrl url = QUrl::fromLocalFile(fileName);
+
+    QVERIFY(writeFile(fileName, "import QtQml 2.0\nQtObject {\n"
+                                "    property int value: 6 * 7\n"
+                                "    property QtObject child: QtObject { property string name: \"child\" }\n"
+                                "}\n"));
+    QByteArray hash = fileHash(fileName);
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, url);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+    }
+    QVERIFY(hasCacheFile(url, hash));
+
+    QByteArray data = readFile(cacheFile(url));
+    QVERIFY(!data.isEmpty());
+    if (damage == QLatin1String("buildId")) {
+        QByteArray id = QQmlDiskCache::buildId();
+        int index = data.indexOf(id);
+        QVERIFY(index > 0);
+        data[index] = data.at(index) == 'x' ? 'y' : 'x';
+    } else if (damage == QLatin1String("magic")) {
+        data[0] = ~data.at(0);
+    } else if (damage == QLatin1String("truncatedHeader")) {
+        data.truncate(12);
+    } else if (damage == QLatin1String("truncatedData")) {
+        data.chop(4);
+    } else {
+        data.clear();
+    }
+    QVERIFY(writeFile(cacheFile(url), data));
+    if (damage != QLatin1String("truncatedData"))
+        QVERIFY(!hasCacheFile(url, hash));
+
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, url);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 42);
+        QObject *child = qvariant_cast<QObject *>(object->property("child"));
+        QVERIFY(child);
+        QCOMPARE(child->property("name").toString(), QString("child"));
+    }
+
+    // The source was compiled, and a valid cache file written
+    QVERIFY(readFile(cacheFile(url)) != data);
+    QVERIFY(hasCacheFile(url, hash));
+}
+
+QTEST_MAIN(tst_qqmldiskcache)
+
+#include "tst_qqmldiskcache.moc"
@@ -0,0 +1,19 @@
+import QtQuick 2.0
+
+QtObject {
+    id: root
+
+    property QtObject first: QtObject { id: first; property int value: 2 }
+    property QtObject second: QtObject { id: second; property int value: 3 }
+    property bool useFirst: true
+
+    // Always reads first.value and second.value
+    property real staticResult: Math.pow(first.value, 2) + second.value
+    // Reads one or the other
+    property real dynamicResult: Math.pow(useFirst ? first.value : second.value, 2)
+
+    function setValues(a, b) {
+        first.value = a;
+        second.value = b;
+    }
+}
@@ -51,6 +51,9 @@
 #include <private/qqmlengine_p.h>
 #include <private/qqmlvmemetaobject_p.h>
 #include <private/qv4compiler_p.h>
+#include <private/qqmlcomponent_p.h>
+#include <private/qqmlcompiler_p.h>
+#include <private/qqmlrewrite_p.h>
 #include "testtypes.h"
 #include "testhttpserver.h"
 #include "../../shared/util.h"
@@ -291,6 +294,9 @@ private slots:
     void jsOwnedObjectsDeletedOnEngineDestroy();
     void numberParsing();
     void stringParsing();
+    void staticDependencies();
+    void staticDependencyTester_data();
+    void staticDependencyTester();
 
 private:
     static void propertyVarWeakRefCallback(v8::Persistent<v8::Value> object, void* parameter);
@@ -7424,6 +7430,84 @@ void tst_qqmlecmascript::stringParsing()
     }
 }
 
+void tst_qqmlecmascript::staticDependencies()
+{
+    QQmlComponent component(&engine, testFileUrl("staticDependencies.qml"));
+    QObject *object = component.create();
+    QVERIFY(object != 0);
+
+    // Only the binding that always reads the same properties is marked static
+    QHash<QString, bool> isStatic;
+    QQmlCompiledData *cc = QQmlComponentPrivate::get(&component)->cc;
+    QVERIFY(cc);
+    const char *instructionStream = cc->bytecode.constData();
+    const char *endInstructionStream = instructionStream + cc->bytecode.size();
+    while (instructionStream < endInstructionStream) {
+        QQmlInstruction *instr = (QQmlInstruction *)instructionStream;
+        QQmlInstruction::Type type = cc->instructionType(instr);
+        if (type == QQmlInstruction::StoreV8Binding) {
+            QString name = QString::fromUtf8(object->metaObject()->property(instr->assignBinding.property.coreIndex).name());
+            isStatic.insert(name, instr->assignBinding.isStatic);
+        }
+        instructionStream += QQmlInstruction::size(type);
+    }
+    QVERIFY(isStatic.contains(QLatin1String("staticResult")));
+    QVERIFY(isStatic.value(QLatin1String("staticResult")));
+    QVERIFY(isStatic.contains(QLatin1String("dynamicResult")));
+    QVERIFY(!isStatic.value(QLatin1String("dynamicResult")));
+
+    QCOMPARE(object->property("staticResult").toReal(), qreal(7));
+    QCOMPARE(object->property("dynamicResult").toReal(), qreal(4));
+
+    // The guards captured by the first evaluation keep working
+    QMetaObject::invokeMethod(object, "setValues", Q_ARG(QVariant, 3), Q_ARG(QVariant, 4));
+    QCOMPARE(object->property("staticResult").toReal(), qreal(13));
+    QMetaObject::invokeMethod(object, "setValues", Q_ARG(QVariant, 3), Q_ARG(QVariant, 5));
+    QCOMPARE(object->property("staticResult").toReal(), qreal(14));
+
+    object->setProperty("useFirst", false);
+    QCOMPARE(object->property("dynamicResult").toReal(), qreal(25));
+    QMetaObject::invokeMethod(object, "setValues", Q_ARG(QVariant, 1), Q_ARG(QVariant, 6));
+    QCOMPARE(object->property("dynamicResult").toReal(), qreal(36));
+
+    delete object;
+}
+
+void tst_qqmlecmascript::staticDependencyTester_data()
+{
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<bool>("isStatic");
+
+    QTest::newRow("names") << "a + b * 2" << true;
+    QTest::newRow("id properties") << "first.value - second.value" << true;
+    QTest::newRow("Math call") << "Math.max(first.value, -a)" << true;
+    QTest::newRow("unary") << "!a + typeof b" << true;
+    QTest::newRow("conditional") << "a ? b : c" << false;
+    QTest::newRow("and") << "a && b" << false;
+    QTest::newRow("or") << "a || first.value" << false;
+    QTest::newRow("assignment") << "a = b" << false;
+    QTest::newRow("function call") << "f(a)" << false;
+    QTest::newRow("method call") << "first.toString()" << false;
+    QTest::newRow("call in Math call") << "Math.abs(f(a))" << false;
+    QTest::newRow("eval") << "eval(\"a\")" << false;
+    QTest::newRow("non-id object") << "parent.x" << false;
+    QTest::newRow("chain through id") << "first.child.value" << false;
+    QTest::newRow("subscript") << "first[a]" << false;
+}
+
+void tst_qqmlecmascript::staticDependencyTester()
+{
+    QFETCH(QString, expression);
+    QFETCH(bool, isStatic);
+
+    QSet<QString> ids;
+    ids << QLatin1String("first") << QLatin1String("second");
+
+    QQmlRewrite::StaticDependencyTester tester(ids);
+    tester.parse(expression);
+    QCOMPARE(tester.isStatic(), isStatic);
+}
+
 QTEST_MAIN(tst_qqmlecmascript)
 
 #include "tst_qqmlecmascript.moc"
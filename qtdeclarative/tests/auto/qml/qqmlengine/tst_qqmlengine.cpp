@@ -46,6 +46,7 @@
 #include <QPointer>
 #include <QDir>
 #include <QStandardPaths>
+#include <QTemporaryDir>
 #include <QSignalSpy>
 #include <QDebug>
 #include <QBuffer>
@@ -55,6 +56,8 @@
 #include <QQmlIncubationController>
 #include <private/qqmlengine_p.h>
 #include <private/qqmlabstracturlinterceptor_p.h>
+#include <private/qqmldiskcache_p.h>
+#include <private/qqmlimportindex_p.h>
 
 class tst_qqmlengine : public QQmlDataTest
 {
@@ -82,6 +85,10 @@ private slots:
     void qtqmlModule();
     void urlInterceptor_data();
     void urlInterceptor();
+    void importIndex();
+    void internedStrings();
+    void importIndexPrecedence();
+    void sharedCompiledData();
 
 public slots:
     QObject *createAQObjectForOwnershipTest ()
@@ -770,6 +777,285 @@ void tst_qqmlengine::urlInterceptor()
     QCOMPARE(o->property("absoluteUrl").toString(), expectedAbsoluteUrl);
 }
 
+static void writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(data), qint64(data.size()));
+}
+
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+// The encoding QDataStream uses for QString
+static QByteArray utf16BigEndian(const QString &string)
+{
+    QByteArray rv;
+    for (int ii = 0; ii < string.length(); ++ii)
+        rv.append(char(string.at(ii).row())).append(char(string.at(ii).cell()));
+    return rv;
+}
+
+void tst_qqmlengine::importIndex()
+{
+    QTemporaryDir importDir;
+    QTemporaryDir cacheDir;
+    QVERIFY(importDir.isValid());
+    QVERIFY(cacheDir.isValid());
+
+    QVERIFY(QDir(importDir.path()).mkdir("IndexedModule"));
+    const QString modulePath = importDir.path() + QLatin1String("/IndexedModule/");
+    writeFile(modulePath + "qmldir", "module IndexedModule\nFoo 1.0 Foo.qml\n");
+    writeFile(modulePath + "Foo.qml", "import QtQml 2.0\nQtObject { property int value: 1 }\n");
+    writeFile(modulePath + "Bar.qml", "import QtQml 2.0\nQtObject { property int value: 2 }\n");
+
+    QQmlDiskCache::setCacheDirectory(cacheDir.path());
+    QQmlImportIndex::setEnabled(true);
+
+    // The first engine searches the import paths and writes the index
+    {
+        QQmlEngine engine;
+        engine.addImportPath(importDir.path());
+        QQmlComponent component(&engine);
+        component.setData("import IndexedModule 1.0\nFoo {}", QUrl());
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 1);
+    }
+
+    QStringList indexFiles = QDir(cacheDir.path()).entryList(QStringList() << "imports-*.qmli");
+    QCOMPARE(indexFiles.count(), 1);
+
+    // The second engine resolves the module from the index.  The qmldir content
+    // held by the index is changed to map Foo to Bar.qml, which shows that the
+    // engine did not read the qmldir file.
+    const QString indexFile = cacheDir.path() + QLatin1Char('/') + indexFiles.first();
+    QByteArray index = readFile(indexFile);
+    QByteArray indexedEntry = utf16BigEndian(QLatin1String("Foo 1.0 Foo.qml"));
+    QVERIFY(index.contains(indexedEntry));
+    index.replace(indexedEntry, utf16BigEndian(QLatin1String("Foo 1.0 Bar.qml")));
+    writeFile(indexFile, index);
+    {
+        QQmlEngine engine;
+        engine.addImportPath(importDir.path());
+        QQmlComponent component(&engine);
+        component.setData("import IndexedModule 1.0\nFoo {}", QUrl());
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 2);
+    }
+
+    // A modified qmldir must not be served from the index
+    writeFile(modulePath + "qmldir", "module IndexedModule\nFoo 1.0 Foo.qml\nBar 1.0 Bar.qml\n");
+    {
+        QQmlEngine engine;
+        engine.addImportPath(importDir.path());
+        QQmlComponent component(&engine);
+        component.setData("import IndexedModule 1.0\nBar {}", QUrl());
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 2);
+    }
+
+    QQmlImportIndex::setEnabled(false);
+    QQmlDiskCache::setCacheDirectory(QString());
+}
+
+void tst_qqmlengine::internedStrings()
+{
+    QQmlEngine engine;
+    QQmlStringTable &table = QQmlEnginePrivate::get(&engine)->stringTable;
+
+    QString first = table.intern(QString(QLatin1String("width")));
+    QString second = table.intern(QString(QLatin1String("width")));
+    QCOMPARE(first, QString(QLatin1String("width")));
+    QCOMPARE(second.constData(), first.constData());
+
+    QString fromRef = table.intern(QHashedStringRef(QString(QLatin1String("width"))));
+    QCOMPARE(fromRef.constData(), first.constData());
+
+    QString other = table.intern(QString(QLatin1String("height")));
+    QVERIFY(other.constData() != first.constData());
+
+    // Long strings such as binding scripts are not retained
+    int count = table.count();
+    QString script(QQmlStringTable::MaximumLength + 1, QLatin1Char('x'));
+    QString internedScript = table.intern(script);
+    QCOMPARE(internedScript.constData(), script.constData());
+    QCOMPARE(table.count(), count);
+
+    // Neither are strings that are not identifiers
+    QString literal(QLatin1String("a short literal"));
+    QCOMPARE(table.intern(literal).constData(), literal.constData());
+    QCOMPARE(table.count(), count);
+
+    QList<QString> strings;
+    strings << QString(QLatin1String("width")) << literal << QString(QLatin1String("depth"));
+    table.intern(&strings);
+    QCOMPARE(strings.at(0).constData(), first.constData());
+    QCOMPARE(strings.at(1).constData(), literal.constData());
+    QCOMPARE(table.count(), count + 1);
+
+    // Property names declared by separate components share their data
+    QQmlComponent c1(&engine);
+    c1.setData("import QtQuick 2.0\nItem { property int internedName: 1 }", QUrl());
+    QScopedPointer<QObject> o1(c1.create());
+    QVERIFY2(o1, qPrintable(c1.errorString()));
+
+    QQmlComponent c2(&engine);
+    c2.setData("import QtQuick 2.0\nItem { property int internedName: 2 }", QUrl());
+    QScopedPointer<QObject> o2(c2.create());
+    QVERIFY2(o2, qPrintable(c2.errorString()));
+
+    QCOMPARE(o1->property("internedName").toInt(), 1);
+    QCOMPARE(o2->property("internedName").toInt(), 2);
+
+    // The compiler already interned the name
+    count = table.count();
+    table.intern(QString(QLatin1String("internedName")));
+    QCOMPARE(table.count(), count);
+}
+
+// A module installed in a location that takes precedence over the indexed one
+// must be found, even if the import path directory itself did not change
+void tst_qqmlengine::importIndexPrecedence()
+{
+    QTemporaryDir lowDir;
+    QTemporaryDir highDir;
+    QTemporaryDir cacheDir;
+    QVERIFY(lowDir.isValid());
+    QVERIFY(highDir.isValid());
+    QVERIFY(cacheDir.isValid());
+
+    QVERIFY(QDir(lowDir.path()).mkpath("Indexed/Module"));
+    const QString lowPath = lowDir.path() + QLatin1String("/Indexed/Module/");
+    writeFile(lowPath + "qmldir", "module Indexed.Module\nFoo 1.0 Foo.qml\n");
+    writeFile(lowPath + "Foo.qml", "import QtQml 2.0\nQtObject { property int value: 1 }\n");
+    QVERIFY(QDir(highDir.path()).mkdir("Indexed"));
+
+    QQmlDiskCache::setCacheDirectory(cacheDir.path());
+    QQmlImportIndex::setEnabled(true);
+
+    // Import paths added last take precedence
+    for (int ii = 0; ii < 2; ++ii) {
+        QQmlEngine engine;
+        engine.addImportPath(lowDir.path());
+        engine.addImportPath(highDir.path());
+        QQmlComponent component(&engine);
+        component.setData("import Indexed.Module 1.0\nFoo {}", QUrl());
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 1);
+    }
+    QCOMPARE(QDir(cacheDir.path()).entryList(QStringList() << "imports-*.qmli").count(), 1);
+
+    // Directory modification times may only have a resolution of one second
+    QTest::qSleep(1100);
+
+    const qint64 highModified = QFileInfo(highDir.path()).lastModified().toMSecsSinceEpoch();
+    QVERIFY(QDir(highDir.path()).mkpath("Indexed/Module"));
+    const QString highPath = highDir.path() + QLatin1String("/Indexed/Module/");
+    writeFile(highPath + "qmldir", "module Indexed.Module\nFoo 1.0 Foo.qml\n");
+    writeFile(highPath + "Foo.qml", "import QtQml 2.0\nQtObject { property int value: 2 }\n");
+    QCOMPARE(QFileInfo(highDir.path()).lastModified().toMSecsSinceEpoch(), highModified);
+
+    {
+        QQmlEngine engine;
+        engine.addImportPath(lowDir.path());
+        engine.addImportPath(highDir.path());
+        QQmlComponent component(&engine);
+        component.setData("import Indexed.Module 1.0\nFoo {}", QUrl());
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 2);
+    }
+
+    // A more specific version next to the indexed module takes precedence too
+    QTest::qSleep(1100);
+    QVERIFY(QDir(highDir.path()).mkpath("Indexed/Module.1"));
+    const QString versionedPath = highDir.path() + QLatin1String("/Indexed/Module.1/");
+    writeFile(versionedPath + "qmldir", "module Indexed.Module\nFoo 1.0 Foo.qml\n");
+    writeFile(versionedPath + "Foo.qml", "import QtQml 2.0\nQtObject { property int value: 3 }\n");
+
+    {
+        QQmlEngine engine;
+        engine.addImportPath(lowDir.path());
+        engine.addImportPath(highDir.path());
+        QQmlComponent component(&engine);
+        component.setData("import Indexed.Module 1.0\nFoo {}", QUrl());
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 3);
+    }
+
+    QQmlImportIndex::setEnabled(false);
+    QQmlDiskCache::setCacheDirectory(QString());
+}
+
+void tst_qqmlengine::sharedCompiledData()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray source("import QtQml 2.0\nQtObject { property int value: 6 * 7 }\n");
+    writeFile(dir.path() + QLatin1String("/Shared.qml"), source);
+    QUrl url = QUrl::fromLocalFile(dir.path() + QLatin1String("/Shared.qml"));
+    QByteArray sourceHash = QQmlDiskCache::sourceHash(source.constData(), source.size());
+
+    QQmlDiskCache::setSharingEnabled(true);
+    QVERIFY(!QQmlDiskCache::loadShared(url, sourceHash));
+
+    QScopedPointer<QQmlEngine> first(new QQmlEngine);
+    {
+        QQmlComponent component(first.data(), url);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 42);
+    }
+
+    QScopedPointer<QQmlDiskCache::Unit> unit(QQmlDiskCache::loadShared(url, sourceHash));
+    QVERIFY(unit);
+    QVERIFY(!QQmlDiskCache::loadShared(url, QQmlDiskCache::sourceHash("x", 1)));
+
+    // A second engine restores the unit compiled by the first
+    QScopedPointer<QQmlEngine> second(new QQmlEngine);
+    {
+        QQmlComponent component(second.data(), url);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("value").toInt(), 42);
+    }
+
+    // The unit is kept while any engine still uses it, and released with the
+    // last one
+    first.reset();
+    unit.reset(QQmlDiskCache::loadShared(url, sourceHash));
+    QVERIFY(unit);
+
+    second.reset();
+    unit.reset(QQmlDiskCache::loadShared(url, sourceHash));
+    QVERIFY(!unit);
+
+    // Disabling sharing drops units still in use
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, url);
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        unit.reset(QQmlDiskCache::loadShared(url, sourceHash));
+        QVERIFY(unit);
+
+        QQmlDiskCache::setSharingEnabled(false);
+        unit.reset(QQmlDiskCache::loadShared(url, sourceHash));
+        QVERIFY(!unit);
+    }
+}
+
 QTEST_MAIN(tst_qqmlengine)
 
 #include "tst_qqmlengine.moc"
@@ -495,6 +495,23 @@ void tst_qqmlinstruction::dump()
         data->addInstruction(i);
     }
 
+    {
+        QQmlCompiledData::Instruction::CreateSimpleObjectAndBegin i;
+        i.create = 0;
+        i.typeSize = 24;
+        i.type = 0;
+        i.id = 2;
+        i.castValue = 8;
+        data->addInstruction(i);
+    }
+
+    {
+        QQmlCompiledData::Instruction::StoreLiteralBlock i;
+        i.data = 4;
+        i.count = 12;
+        data->addInstruction(i);
+    }
+
     QStringList expect;
     expect 
         << "Index\tOperation\t\tData1\tData2\tData3\tComments"
@@ -557,6 +574,8 @@ void tst_qqmlinstruction::dump()
         << "55\t\tSTORE_VAR_INTEGER\t81\t23"
         << "56\t\tSTORE_VAR_DOUBLE\t82\t66.3"
         << "57\t\tSTORE_VAR_BOOL\t\t83\ttrue"
+        << "58\t\tCREATE_SIMPLE_BEGIN\t24\t2\t8"
+        << "59\t\tSTORE_LITERAL_BLOCK\t4\t12"
         << "-------------------------------------------------------------------------------";
 
     QQmlTestMessageHandler messageHandler;
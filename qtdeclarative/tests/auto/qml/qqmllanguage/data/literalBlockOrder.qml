@@ -0,0 +1,25 @@
+import Test 1.0
+
+MyLiteralOrderObject {
+    id: root
+
+    property int source: 5
+
+    intA: 10
+    stringB: "hello"
+    boundC: source * 2
+    urlD: "literal.qml"
+    realE: 1.5
+    boolF: true
+    enumG: MyLiteralOrderObject.Third
+    boundH: stringB + "!"
+
+    onIntAChanged: root.handled("intA")
+    onStringBChanged: root.handled("stringB")
+    onBoundCChanged: root.handled("boundC")
+    onUrlDChanged: root.handled("urlD")
+    onRealEChanged: root.handled("realE")
+    onBoolFChanged: root.handled("boolF")
+    onEnumGChanged: root.handled("enumG")
+    onBoundHChanged: root.handled("boundH")
+}
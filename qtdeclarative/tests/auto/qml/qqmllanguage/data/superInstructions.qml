@@ -0,0 +1,19 @@
+import Test 1.0
+import QtQuick 2.0
+
+MyContainer {
+    property QtObject first: a
+    property QtObject second: b
+    property QtObject third: c
+
+    MyParserStatus { id: a }
+    MyParserStatus { id: b; objectName: "b" }
+    QtObject { id: c; objectName: "c" }
+    MyParserStatus {}
+    Component {
+        MyContainer {
+            property QtObject first: d
+            MyParserStatus { id: d }
+        }
+    }
+}
@@ -0,0 +1,23 @@
+import QtQuick 2.0
+
+QtObject {
+    property bool boolProperty
+    property int intProperty: 3
+    property date dateProperty: "1945-09-02"
+    property string stringProperty: "Hello"
+    property real realProperty: 1.5
+    property variant variantProperty: 11
+    property url urlProperty: "main.qml"
+
+    property int defaultInt
+    property string defaultString
+    property url defaultUrl
+
+    property int intBinding: intProperty * 2
+    property real realBinding: realProperty + intProperty
+    property bool boolBinding: !boolProperty
+    property string stringBinding: stringProperty + " World"
+
+    property int intChanges: 0
+    onIntPropertyChanged: intChanges++
+}
@@ -84,6 +84,8 @@ void registerTypes()
 
     qmlRegisterType<MyReceiversTestObject>("Test",1,0,"MyReceiversTestObject");
 
+    qmlRegisterType<MyLiteralOrderObject>("Test",1,0,"MyLiteralOrderObject");
+
     qmlRegisterUncreatableType<MyUncreateableBaseClass>("Test", 1, 0, "MyUncreateableBaseClass", "Cannot create MyUncreateableBaseClass");
     qmlRegisterType<MyCreateableDerivedClass>("Test", 1, 0, "MyCreateableDerivedClass");
 
@@ -1059,6 +1059,69 @@ class MyEnumDerivedClass : public MyEnum2Class
     Q_OBJECT
 };
 
+// Records the order in which properties are written, and signal handlers run
+class MyLiteralOrderObject : public QObject
+{
+    Q_OBJECT
+    Q_ENUMS(Choice)
+    Q_PROPERTY(int intA READ intA WRITE setIntA NOTIFY intAChanged)
+    Q_PROPERTY(QString stringB READ stringB WRITE setStringB NOTIFY stringBChanged)
+    Q_PROPERTY(int boundC READ boundC WRITE setBoundC NOTIFY boundCChanged)
+    Q_PROPERTY(QUrl urlD READ urlD WRITE setUrlD NOTIFY urlDChanged)
+    Q_PROPERTY(double realE READ realE WRITE setRealE NOTIFY realEChanged)
+    Q_PROPERTY(bool boolF READ boolF WRITE setBoolF NOTIFY boolFChanged)
+    Q_PROPERTY(Choice enumG READ enumG WRITE setEnumG NOTIFY enumGChanged)
+    Q_PROPERTY(QString boundH READ boundH WRITE setBoundH NOTIFY boundHChanged)
+
+public:
+    MyLiteralOrderObject() : m_intA(0), m_boundC(0), m_realE(0), m_boolF(false), m_enumG(First) {}
+
+    enum Choice { First, Second, Third };
+
+    int intA() const { return m_intA; }
+    void setIntA(int v) { m_writes << QLatin1String("intA"); m_intA = v; emit intAChanged(); }
+    QString stringB() const { return m_stringB; }
+    void setStringB(const QString &v) { m_writes << QLatin1String("stringB"); m_stringB = v; emit stringBChanged(); }
+    int boundC() const { return m_boundC; }
+    void setBoundC(int v) { m_writes << QLatin1String("boundC"); m_boundC = v; emit boundCChanged(); }
+    QUrl urlD() const { return m_urlD; }
+    void setUrlD(const QUrl &v) { m_writes << QLatin1String("urlD"); m_urlD = v; emit urlDChanged(); }
+    double realE() const { return m_realE; }
+    void setRealE(double v) { m_writes << QLatin1String("realE"); m_realE = v; emit realEChanged(); }
+    bool boolF() const { return m_boolF; }
+    void setBoolF(bool v) { m_writes << QLatin1String("boolF"); m_boolF = v; emit boolFChanged(); }
+    Choice enumG() const { return m_enumG; }
+    void setEnumG(Choice v) { m_writes << QLatin1String("enumG"); m_enumG = v; emit enumGChanged(); }
+    QString boundH() const { return m_boundH; }
+    void setBoundH(const QString &v) { m_writes << QLatin1String("boundH"); m_boundH = v; emit boundHChanged(); }
+
+    QStringList writes() const { return m_writes; }
+    QStringList handlers() const { return m_handlers; }
+    Q_INVOKABLE void handled(const QString &name) { m_handlers << name; }
+
+signals:
+    void intAChanged();
+    void stringBChanged();
+    void boundCChanged();
+    void urlDChanged();
+    void realEChanged();
+    void boolFChanged();
+    void enumGChanged();
+    void boundHChanged();
+
+private:
+    int m_intA;
+    QString m_stringB;
+    int m_boundC;
+    QUrl m_urlD;
+    double m_realE;
+    bool m_boolF;
+    Choice m_enumG;
+    QString m_boundH;
+    QStringList m_writes;
+    QStringList m_handlers;
+};
+
 Q_DECLARE_METATYPE(MyEnum2Class::EnumB)
 Q_DECLARE_METATYPE(MyEnum1Class::EnumA)
 Q_DECLARE_METATYPE(Qt::TextFormat)
@@ -1069,6 +1132,7 @@ QML_DECLARE_TYPE(MyRevisionedClass)
 QML_DECLARE_TYPE(MyRevisionedSubclass)
 QML_DECLARE_TYPE(MySubclass)
 QML_DECLARE_TYPE(MyReceiversTestObject)
+QML_DECLARE_TYPE(MyLiteralOrderObject)
 
 void registerTypes();
 
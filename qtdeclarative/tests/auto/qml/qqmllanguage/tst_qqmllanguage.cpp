@@ -109,6 +109,7 @@ private slots:
     void overrideSignal();
     void dynamicProperties();
     void dynamicPropertiesNested();
+    void typedPropertyStorage();
     void listProperties();
     void dynamicObjectProperties();
     void dynamicSignalsAndSlots();
@@ -132,6 +133,7 @@ private slots:
     void defaultPropertyListOrder();
     void declaredPropertyValues();
     void dontDoubleCallClassBegin();
+    void superInstructions();
     void reservedWords_data();
     void reservedWords();
     void inlineAssignmentsOverrideBindings();
@@ -184,6 +186,7 @@ private slots:
     void globalEnums();
     void literals_data();
     void literals();
+    void literalBlockOrder();
 
     void objectDeletionNotify_data();
     void objectDeletionNotify();
@@ -1216,6 +1219,50 @@ void tst_qqmllanguage::dynamicProperties()
     QCOMPARE(object->property("varProperty"), QVariant("Hello World!"));
 }
 
+// Declared int, bool, real, string and url properties are kept in typed storage
+void tst_qqmllanguage::typedPropertyStorage()
+{
+    QQmlComponent component(&engine, testFileUrl("typedPropertyStorage.qml"));
+    VERIFY_ERRORS(0);
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(object != 0);
+
+    QCOMPARE(object->property("boolProperty"), QVariant(false));
+    QCOMPARE(object->property("intProperty"), QVariant(3));
+    QCOMPARE(object->property("dateProperty"), QVariant(QDate(1945, 9, 2)));
+    QCOMPARE(object->property("stringProperty"), QVariant("Hello"));
+    QCOMPARE(object->property("realProperty"), QVariant(qreal(1.5)));
+    QCOMPARE(object->property("variantProperty"), QVariant(11));
+    QCOMPARE(object->property("urlProperty"), QVariant(testFileUrl("main.qml")));
+
+    QCOMPARE(object->property("defaultInt"), QVariant(0));
+    QCOMPARE(object->property("defaultString"), QVariant(QString()));
+    QCOMPARE(object->property("defaultUrl"), QVariant(QUrl()));
+
+    QCOMPARE(object->property("intBinding"), QVariant(6));
+    QCOMPARE(object->property("realBinding"), QVariant(qreal(4.5)));
+    QCOMPARE(object->property("boolBinding"), QVariant(true));
+    QCOMPARE(object->property("stringBinding"), QVariant("Hello World"));
+
+    QCOMPARE(object->property("intChanges"), QVariant(0));
+    object->setProperty("intProperty", 5);
+    QCOMPARE(object->property("intChanges"), QVariant(1));
+    QCOMPARE(object->property("intBinding"), QVariant(10));
+    QCOMPARE(object->property("realBinding"), QVariant(qreal(6.5)));
+
+    // Writing the current value must not emit a change
+    object->setProperty("intProperty", 5);
+    QCOMPARE(object->property("intChanges"), QVariant(1));
+
+    object->setProperty("boolProperty", true);
+    QCOMPARE(object->property("boolBinding"), QVariant(false));
+    object->setProperty("stringProperty", QString("Goodbye"));
+    QCOMPARE(object->property("stringBinding"), QVariant("Goodbye World"));
+
+    QCOMPARE(object->property("dateProperty"), QVariant(QDate(1945, 9, 2)));
+    QCOMPARE(object->property("variantProperty"), QVariant(11));
+}
+
 // Test that nested types can use dynamic properties
 void tst_qqmllanguage::dynamicPropertiesNested()
 {
@@ -1846,6 +1893,46 @@ void tst_qqmllanguage::dontDoubleCallClassBegin()
     delete o;
 }
 
+// Objects created through the fused CreateSimpleObjectAndBegin
+// instruction must get their id and parser status exactly as before
+void tst_qqmllanguage::superInstructions()
+{
+    QQmlComponent component(&engine, testFileUrl("superInstructions.qml"));
+    VERIFY_ERRORS(0);
+    MyContainer *o = qobject_cast<MyContainer *>(component.create());
+    QVERIFY(o);
+    QCOMPARE(o->getChildren()->count(), 5);
+
+    for (int ii = 0; ii < 4; ++ii) {
+        if (ii == 2)
+            continue;
+        MyParserStatus *status = qobject_cast<MyParserStatus *>(o->getChildren()->at(ii));
+        QVERIFY(status);
+        QCOMPARE(status->classBeginCount(), 1);
+        QCOMPARE(status->componentCompleteCount(), 1);
+    }
+
+    QCOMPARE(qvariant_cast<QObject *>(o->property("first")), o->getChildren()->at(0));
+    QCOMPARE(qvariant_cast<QObject *>(o->property("second")), o->getChildren()->at(1));
+    QCOMPARE(qvariant_cast<QObject *>(o->property("third")), o->getChildren()->at(2));
+    QCOMPARE(o->getChildren()->at(1)->objectName(), QString("b"));
+    QCOMPARE(o->getChildren()->at(2)->objectName(), QString("c"));
+
+    QQmlComponent *nested = qobject_cast<QQmlComponent *>(o->getChildren()->at(4));
+    QVERIFY(nested);
+    MyContainer *n = qobject_cast<MyContainer *>(nested->create());
+    QVERIFY(n);
+    QCOMPARE(n->getChildren()->count(), 1);
+    MyParserStatus *d = qobject_cast<MyParserStatus *>(n->getChildren()->at(0));
+    QVERIFY(d);
+    QCOMPARE(d->classBeginCount(), 1);
+    QCOMPARE(d->componentCompleteCount(), 1);
+    QCOMPARE(qvariant_cast<QObject *>(n->property("first")), static_cast<QObject *>(d));
+
+    delete n;
+    delete o;
+}
+
 void tst_qqmllanguage::reservedWords_data()
 {
     QTest::addColumn<QByteArray>("word");
@@ -3110,6 +3197,54 @@ void tst_qqmllanguage::literals()
     delete object;
 }
 
+// Literal assignments are written together, before any binding is evaluated and
+// without running the object's own change handlers, as when each was written
+// with its own instruction
+void tst_qqmllanguage::literalBlockOrder()
+{
+    QQmlComponent component(&engine, testFileUrl("literalBlockOrder.qml"));
+    VERIFY_ERRORS(0);
+
+    QScopedPointer<QObject> root(component.create());
+    MyLiteralOrderObject *object = qobject_cast<MyLiteralOrderObject *>(root.data());
+    QVERIFY(object);
+
+    QCOMPARE(object->intA(), 10);
+    QCOMPARE(object->stringB(), QString("hello"));
+    QCOMPARE(object->boundC(), 10);
+    QCOMPARE(object->urlD(), testFileUrl("literal.qml"));
+    QCOMPARE(object->realE(), 1.5);
+    QCOMPARE(object->boolF(), true);
+    QCOMPARE(object->enumG(), MyLiteralOrderObject::Third);
+    QCOMPARE(object->boundH(), QString("hello!"));
+
+    // Each literal is written once, and all of them before the bindings
+    QStringList writes = object->writes();
+    QCOMPARE(writes.count(), 8);
+    QStringList literals = writes.mid(0, 6);
+    literals.sort();
+    QCOMPARE(literals, QStringList() << "boolF" << "enumG" << "intA" << "realE" << "stringB" << "urlD");
+    QStringList bindings = writes.mid(6);
+    bindings.sort();
+    QCOMPARE(bindings, QStringList() << "boundC" << "boundH");
+
+    // Handlers are connected after the literals are written, but before the
+    // bindings are evaluated
+    QStringList handlers = object->handlers();
+    handlers.sort();
+    QCOMPARE(handlers, bindings);
+
+    object->setProperty("source", 7);
+    QCOMPARE(object->boundC(), 14);
+    object->setIntA(11);
+    object->setStringB(QLatin1String("world"));
+    QCOMPARE(object->boundH(), QString("world!"));
+    QCOMPARE(object->handlers().mid(2, 2), QStringList() << "boundC" << "intA");
+    QStringList changed = object->handlers().mid(4);
+    changed.sort();
+    QCOMPARE(changed, QStringList() << "boundH" << "stringB");
+}
+
 void tst_qqmllanguage::objectDeletionNotify_data()
 {
     QTest::addColumn<QString>("file");
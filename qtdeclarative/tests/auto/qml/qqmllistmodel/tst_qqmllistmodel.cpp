@@ -50,6 +50,7 @@
 #include <QtCore/qtimer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qtranslator.h>
+#include <QtCore/qjsondocument.h>
 #include <QSignalSpy>
 
 #include "../../shared/util.h"
@@ -130,6 +131,11 @@ private slots:
     void empty_element_warning_data();
     void datetime();
     void datetime_data();
+    void appendRows();
+    void appendRows_data();
+    void appendRows_cpp();
+    void appendJson();
+    void appendJson_data();
 };
 
 bool tst_qqmllistmodel::compareVariantList(const QVariantList &testList, QVariant object)
@@ -1253,6 +1259,135 @@ void tst_qqmllistmodel::datetime()
     QVERIFY(expected == dtResult);
 }
 
+void tst_qqmllistmodel::appendRows_data()
+{
+    QTest::addColumn<QString>("script");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<QString>("result");
+    QTest::addColumn<bool>("dynamicRoles");
+
+    for (int i = 0 ; i < 2 ; ++i) {
+        bool dr = (i != 0);
+
+        QTest::newRow("rows") << "appendRows([{'a':1, 'b':'x'}, {'a':2, 'b':'y'}, {'a':3, 'b':'z'}])" << 3 << "get(1).a + get(2).b" << "2z" << dr;
+        QTest::newRow("columns") << "appendRows({'a':[1, 2, 3], 'b':['x', 'y', 'z']})" << 3 << "get(1).a + get(2).b" << "2z" << dr;
+        QTest::newRow("columns-uneven") << "appendRows({'a':[1, 2], 'b':['x', 'y', 'z']})" << 3 << "get(2).b + count" << "z3" << dr;
+        QTest::newRow("columns-nested") << "appendRows({'a':[[{'c':5}], [{'c':6}]]})" << 2 << "get(1).a.get(0).c" << "6" << dr;
+        QTest::newRow("empty") << "appendRows([])" << 0 << "count" << "0" << dr;
+    }
+}
+
+void tst_qqmllistmodel::appendRows()
+{
+    QFETCH(QString, script);
+    QFETCH(int, count);
+    QFETCH(QString, expression);
+    QFETCH(QString, result);
+    QFETCH(bool, dynamicRoles);
+
+    QQmlEngine engine;
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine::setContextForObject(&model,engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    QQmlExpression e(engine.rootContext(), &model, script);
+    e.evaluate();
+    QVERIFY(!e.hasError());
+    QCOMPARE(model.count(), count);
+
+    // All rows added by one appendRows() call arrive in a single notification
+    QCOMPARE(spyInserted.count(), count > 0 ? 1 : 0);
+
+    QQmlExpression r(engine.rootContext(), &model, expression);
+    QCOMPARE(r.evaluate().toString(), result);
+    QVERIFY(!r.hasError());
+}
+
+void tst_qqmllistmodel::appendRows_cpp()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model,engine.rootContext());
+
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    QVariantList rows;
+    for (int i = 0 ; i < 1000 ; ++i) {
+        QVariantMap row;
+        row.insert("index", i);
+        row.insert("name", QString::number(i));
+        rows.append(row);
+    }
+    model.appendRows(rows);
+
+    QCOMPARE(model.count(), 1000);
+    QCOMPARE(spyInserted.count(), 1);
+    QCOMPARE(spyInserted.at(0).at(1).toInt(), 0);
+    QCOMPARE(spyInserted.at(0).at(2).toInt(), 999);
+    QCOMPARE(model.data(500, roleFromName(&model, "index")).toInt(), 500);
+    QCOMPARE(model.data(999, roleFromName(&model, "name")).toString(), QString("999"));
+}
+
+void tst_qqmllistmodel::appendJson_data()
+{
+    QTest::addColumn<QString>("json");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<QString>("result");
+    QTest::addColumn<bool>("dynamicRoles");
+
+    for (int i = 0 ; i < 2 ; ++i) {
+        bool dr = (i != 0);
+
+        QTest::newRow("array") << "[{\"a\": 1, \"b\": \"x\"}, {\"a\": 2, \"b\": \"y\"}]" << 2 << "get(1).a + get(0).b" << "2x" << dr;
+        QTest::newRow("object") << "{\"a\": 3}" << 1 << "get(0).a" << "3" << dr;
+        QTest::newRow("bool") << "[{\"a\": true}]" << 1 << "get(0).a === true" << "true" << dr;
+        QTest::newRow("nested") << "[{\"a\": [{\"c\": 5}, {\"c\": 6}]}]" << 1 << "get(0).a.count + get(0).a.get(1).c" << "8" << dr;
+        QTest::newRow("nested-scalars") << "[{\"a\": [1, {\"c\": 2}, \"x\"]}]" << 1 << "get(0).a.count + get(0).a.get(1).c" << "5" << dr;
+        QTest::newRow("map") << "[{\"a\": {\"c\": 7}}]" << 1 << "get(0).a.c" << "7" << dr;
+        QTest::newRow("skip-non-objects") << "[{\"a\": 1}, 2, \"x\", {\"a\": 4}]" << 2 << "get(1).a" << "4" << dr;
+        QTest::newRow("empty") << "[]" << 0 << "count" << "0" << dr;
+        QTest::newRow("invalid") << "[{\"a\": 1" << 0 << "count" << "0" << dr;
+    }
+}
+
+void tst_qqmllistmodel::appendJson()
+{
+    QFETCH(QString, json);
+    QFETCH(int, count);
+    QFETCH(QString, expression);
+    QFETCH(QString, result);
+    QFETCH(bool, dynamicRoles);
+
+    QQmlEngine engine;
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine::setContextForObject(&model,engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    QJsonParseError error;
+    QJsonDocument::fromJson(json.toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        QString warning = QString("<Unknown File>: QML ListModel: appendJson: %1 at offset %2")
+                .arg(error.errorString()).arg(error.offset);
+        QTest::ignoreMessage(QtWarningMsg, warning.toLatin1());
+    }
+
+    QCOMPARE(model.appendJson(json), count);
+    QCOMPARE(model.count(), count);
+    QCOMPARE(spyInserted.count(), count > 0 ? 1 : 0);
+
+    QQmlExpression e(engine.rootContext(), &model, expression);
+    QCOMPARE(e.evaluate().toString(), result);
+    QVERIFY(!e.hasError());
+}
+
 QTEST_MAIN(tst_qqmllistmodel)
 
 #include "tst_qqmllistmodel.moc"
@@ -111,6 +111,8 @@ private slots:
     void property_changes_worker_data();
     void worker_sync_data();
     void worker_sync();
+    void worker_sync_changes_data();
+    void worker_sync_changes();
     void worker_remove_element_data();
     void worker_remove_element();
     void worker_remove_list_data();
@@ -704,6 +706,80 @@ void tst_qqmllistmodelworkerscript::worker_sync()
     qApp->processEvents();
 }
 
+void tst_qqmllistmodelworkerscript::worker_sync_changes_data()
+{
+    worker_sync_data();
+}
+
+void tst_qqmllistmodelworkerscript::worker_sync_changes()
+{
+    QFETCH(bool, dynamicRoles);
+
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("model.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    for (int i = 0; i < 5; ++i)
+        RUNEVAL(item, QString("model.append({'value': %1})").arg(i));
+    QCOMPARE(model.count(), 5);
+
+    // Hand the model to the worker, so that it has a copy of its own
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, QVariantList())));
+    waitForWorker(item);
+
+    // Row 3 is not touched by the worker.  A value set on this thread after the
+    // worker made its copy is only kept if the row is not copied back.
+    RUNEVAL(item, "model.setProperty(3, 'value', 42)");
+    QQmlExpression getExpr(eng.rootContext(), &model, "get(3)");
+    QObject *unchangedRow = getExpr.evaluate().value<QObject *>();
+    QVERIFY(unchangedRow != 0);
+
+    QSignalSpy spyChanged(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy spyRemoved(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy spyMoved(&model, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)));
+
+    // Only the changed rows are copied back; the others must be left intact
+    QVariantList operations;
+    operations << "setProperty(1, 'value', 10)"
+               << "insert(0, {'value': -1})"
+               << "move(0, 5, 1)"
+               << "remove(2, 1)";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, operations)));
+    waitForWorker(item);
+
+    QCOMPARE(model.count(), 5);
+    int role = roleFromName(&model, "value");
+    // Dynamic role models are always synced in full
+    const int unchangedValue = dynamicRoles ? 3 : 42;
+    QList<int> expected;
+    expected << 0 << 10 << unchangedValue << 4 << -1;
+    for (int i = 0; i < expected.count(); ++i)
+        QCOMPARE(model.data(model.index(i, 0, QModelIndex()), role).toInt(), expected.at(i));
+
+    if (!dynamicRoles) {
+        QQmlExpression getMovedExpr(eng.rootContext(), &model, "get(2)");
+        QCOMPARE(getMovedExpr.evaluate().value<QObject *>(), unchangedRow);
+        QCOMPARE(unchangedRow->property("value").toInt(), 42);
+    }
+
+    QCOMPARE(spyChanged.count(), 1);
+    QCOMPARE(spyChanged.at(0).at(0).value<QModelIndex>().row(), 1);
+    QCOMPARE(spyInserted.count(), 1);
+    QCOMPARE(spyInserted.at(0).at(1).toInt(), 0);
+    QCOMPARE(spyMoved.count(), 1);
+    QCOMPARE(spyRemoved.count(), 1);
+    QCOMPARE(spyRemoved.at(0).at(1).toInt(), 2);
+
+    delete item;
+    qApp->processEvents();
+}
+
 void tst_qqmllistmodelworkerscript::worker_remove_element_data()
 {
     worker_sync_data();
@@ -41,7 +41,11 @@
 
 #include <qtest.h>
 #include <private/qqmlpropertycache_p.h>
+#include <private/qqmlengine_p.h>
+#include <private/qv8engine_p.h>
+#include <private/qqmldata_p.h>
 #include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
 #include "../../shared/util.h"
 
 class tst_qqmlpropertycache : public QObject
@@ -57,6 +61,10 @@ private slots:
     void methodsDerived();
     void signalHandlers();
     void signalHandlersDerived();
+    void lookupTable();
+    void lookupTableParentChanged();
+    void qobjectLookupCache();
+    void qobjectLookupCacheParentChanged();
 
 private:
     QQmlEngine engine;
@@ -102,6 +110,14 @@ Q_SIGNALS:
     void signalB();
 };
 
+class VariantObject : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QVariant value READ value CONSTANT)
+public:
+    QVariant value() const { return QVariant(2); }
+};
+
 QQmlPropertyData *cacheProperty(QQmlPropertyCache *cache, const char *name)
 {
     return cache->property(QLatin1String(name), 0, 0);
@@ -278,6 +294,162 @@ void tst_qqmlpropertycache::signalHandlersDerived()
     QCOMPARE(data->coreIndex, metaObject->indexOfMethod("propertyDChanged()"));
 }
 
+void tst_qqmlpropertycache::lookupTable()
+{
+    QQmlEngine engine;
+    DerivedObject object;
+    const QMetaObject *metaObject = object.metaObject();
+
+    QQmlRefPointer<QQmlPropertyCache> parentCache(new QQmlPropertyCache(&engine, &BaseObject::staticMetaObject));
+    QQmlRefPointer<QQmlPropertyCache> cache(parentCache->copyAndAppend(&engine, object.metaObject()));
+
+    // Repeated lookups make the cache switch to its perfect hash lookup table,
+    // which must resolve names exactly like the string cache does.
+    const char *properties[] = { "objectName", "propertyA", "propertyB", "propertyC", "propertyD" };
+    for (int round = 0; round < 4; ++round) {
+        for (uint ii = 0; ii < sizeof(properties) / sizeof(properties[0]); ++ii) {
+            QQmlPropertyData *data = cacheProperty(cache, properties[ii]);
+            QVERIFY(data);
+            QCOMPARE(data->coreIndex, metaObject->indexOfProperty(properties[ii]));
+        }
+
+        QQmlPropertyData *data = cache->property(QString(QLatin1String("propertyC")), 0, 0);
+        QVERIFY(data);
+        QCOMPARE(data->coreIndex, metaObject->indexOfProperty("propertyC"));
+
+        QVERIFY(data = cacheProperty(cache, "slotB"));
+        QCOMPARE(data->coreIndex, metaObject->indexOfMethod("slotB()"));
+        QVERIFY(data = cacheProperty(cache, "onSignalA"));
+        QCOMPARE(data->coreIndex, metaObject->indexOfMethod("signalA()"));
+
+        QVERIFY(!cacheProperty(cache, "propertyE"));
+        QVERIFY(!cacheProperty(cache, "slotC"));
+        QVERIFY(!cacheProperty(cache, ""));
+    }
+}
+
+void tst_qqmlpropertycache::qobjectLookupCache()
+{
+    QQmlEngine engine;
+
+    // Adding a name changes the cache's lookup id
+    QQmlRefPointer<QQmlPropertyCache> cache(new QQmlPropertyCache(&engine, &BaseObject::staticMetaObject));
+    quint32 lookupId = cache->lookupId();
+    cache->appendProperty(QString(QLatin1String("propertyE")), QQmlPropertyData::IsWritable,
+                          cache->propertyCount(), QMetaType::Int, -1);
+    QVERIFY(cache->lookupId() != lookupId);
+
+    // Property reads that are not handled by fast accessors hit the wrapper's lookup cache
+    QQmlComponent component(&engine);
+    component.setData("import QtQml 2.0\n"
+                      "QtObject { function sum(o) { var s = 0; for (var i = 0; i < 100; ++i) s += o.value; return s } }",
+                      QUrl());
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY2(o, qPrintable(component.errorString()));
+
+    VariantObject object;
+    QV8QObjectWrapper *wrapper = QQmlEnginePrivate::get(&engine)->v8engine()->qobjectWrapper();
+    wrapper->resetLookupStatistics();
+
+    QVariant sum;
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "sum", Q_RETURN_ARG(QVariant, sum),
+                                      Q_ARG(QVariant, QVariant::fromValue<QObject *>(&object))));
+    QCOMPARE(sum.toInt(), 200);
+
+    QV8QObjectWrapper::LookupStatistics stats = wrapper->lookupStatistics();
+    QVERIFY(stats.hits >= 99);
+    QVERIFY(stats.misses <= 1);
+}
+
+// Entries must not be reused once a parent of the cache they were made for changes
+void tst_qqmlpropertycache::qobjectLookupCacheParentChanged()
+{
+    QQmlEngine engine;
+    DerivedObject object;
+
+    QQmlRefPointer<QQmlPropertyCache> parentCache(new QQmlPropertyCache(&engine, &BaseObject::staticMetaObject));
+    QQmlPropertyCache *cache = parentCache->copyAndAppend(&engine, object.metaObject());
+    QQmlData::get(&object, true)->propertyCache = cache; // Released by QQmlData
+
+    // Methods are not handled by fast accessors
+    QQmlComponent component(&engine);
+    component.setData("import QtQml 2.0\n"
+                      "QtObject { function slotType(o) { return typeof o.slotA } }",
+                      QUrl());
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY2(o, qPrintable(component.errorString()));
+
+    QV8QObjectWrapper *wrapper = QQmlEnginePrivate::get(&engine)->v8engine()->qobjectWrapper();
+    QVariant objectArg = QVariant::fromValue<QObject *>(&object);
+    QVariant type;
+
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "slotType", Q_RETURN_ARG(QVariant, type), Q_ARG(QVariant, objectArg)));
+    QCOMPARE(type.toString(), QString(QLatin1String("function")));
+
+    wrapper->resetLookupStatistics();
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "slotType", Q_RETURN_ARG(QVariant, type), Q_ARG(QVariant, objectArg)));
+    QCOMPARE(type.toString(), QString(QLatin1String("function")));
+    QV8QObjectWrapper::LookupStatistics stats = wrapper->lookupStatistics();
+    QCOMPARE(stats.hits, quint32(1));
+    QCOMPARE(stats.misses, quint32(0));
+
+    // The parent's lookup id changes, the derived cache's does not
+    const quint32 lookupId = cache->lookupId();
+    const quint32 chainId = cache->lookupChainId();
+    parentCache->appendProperty(QString(QLatin1String("propertyLater")), QQmlPropertyData::IsWritable,
+                                parentCache->propertyCount(), QMetaType::Int, -1);
+    QCOMPARE(cache->lookupId(), lookupId);
+    QVERIFY(cache->lookupChainId() != chainId);
+
+    wrapper->resetLookupStatistics();
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "slotType", Q_RETURN_ARG(QVariant, type), Q_ARG(QVariant, objectArg)));
+    QCOMPARE(type.toString(), QString(QLatin1String("function")));
+    stats = wrapper->lookupStatistics();
+    QCOMPARE(stats.hits, quint32(0));
+    QCOMPARE(stats.misses, quint32(1));
+}
+
+void tst_qqmlpropertycache::lookupTableParentChanged()
+{
+    QQmlEngine engine;
+    DerivedObject object;
+    const QMetaObject *metaObject = object.metaObject();
+
+    QQmlRefPointer<QQmlPropertyCache> parentCache(new QQmlPropertyCache(&engine, &BaseObject::staticMetaObject));
+    QQmlRefPointer<QQmlPropertyCache> cache(parentCache->copyAndAppend(&engine, object.metaObject()));
+    QQmlRefPointer<QQmlPropertyCache> reference(parentCache->copyAndAppend(&engine, object.metaObject()));
+
+    // Make the parent and the derived cache build their lookup tables
+    for (int ii = 0; ii < 16; ++ii) {
+        QVERIFY(cacheProperty(parentCache, "propertyA"));
+        QVERIFY(cacheProperty(cache, "propertyC"));
+    }
+    QVERIFY(!cacheProperty(parentCache, "propertyLater"));
+
+    int coreIndex = metaObject->indexOfProperty("propertyA");
+    parentCache->appendProperty(QString(QLatin1String("propertyLater")), QQmlPropertyData::IsWritable,
+                                coreIndex, QMetaType::Int, -1);
+
+    // The parent's own table must include the new name
+    QQmlPropertyData *data = cacheProperty(parentCache, "propertyLater");
+    QVERIFY(data);
+    QCOMPARE(data->coreIndex, coreIndex);
+
+    // The derived cache must answer exactly like a derived cache that has not
+    // built a table yet and still uses its string cache
+    const char *names[] = { "propertyA", "propertyB", "propertyC", "propertyD", "propertyLater",
+                            "signalA", "signalB", "slotB", "missing" };
+    for (uint ii = 0; ii < sizeof(names) / sizeof(names[0]); ++ii) {
+        QQmlPropertyData *expected = cacheProperty(reference, names[ii]);
+        for (int jj = 0; jj < 16; ++jj) {
+            QQmlPropertyData *found = cacheProperty(cache, names[ii]);
+            QCOMPARE(!found, !expected);
+            if (found)
+                QCOMPARE(found->coreIndex, expected->coreIndex);
+        }
+    }
+}
+
 QTEST_MAIN(tst_qqmlpropertycache)
 
 #include "tst_qqmlpropertycache.moc"
@@ -0,0 +1,25 @@
+import QtQuick 2.0
+
+WorkerScript {
+    id: worker
+    source: "script.js"
+    stateless: true
+
+    property int expected: 0
+    property int responses: 0
+    property int total: 0
+
+    signal done()
+
+    function testSend(count) {
+        worker.expected = count
+        for (var i = 0; i < count; ++i)
+            worker.sendMessage(i)
+    }
+
+    onMessage: {
+        worker.total += messageObject
+        if (++worker.responses == worker.expected)
+            worker.done()
+    }
+}
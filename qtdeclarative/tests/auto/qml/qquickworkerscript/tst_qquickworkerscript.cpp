@@ -43,6 +43,7 @@
 #include <QtCore/qtimer.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qsemaphore.h>
 #include <QtQml/qjsengine.h>
 
 #include <QtQml/qqmlcomponent.h>
@@ -52,11 +53,49 @@
 #include <private/qqmlengine_p.h>
 #include "../../shared/util.h"
 
+// Blocks the event loop of the thread it lives in until it goes out of scope
+class ThreadBlocker : public QObject
+{
+public:
+    ThreadBlocker(QThread *thread)
+    {
+        moveToThread(thread);
+        QCoreApplication::postEvent(this, new QEvent(QEvent::User));
+        m_blocked.acquire();
+    }
+
+    ~ThreadBlocker()
+    {
+        m_release.release();
+        m_finished.acquire();
+    }
+
+protected:
+    virtual bool event(QEvent *e)
+    {
+        if (e->type() != QEvent::User)
+            return QObject::event(e);
+        m_blocked.release();
+        m_release.acquire();
+        m_finished.release();
+        return true;
+    }
+
+private:
+    QSemaphore m_blocked;
+    QSemaphore m_release;
+    QSemaphore m_finished;
+};
+
 class tst_QQuickWorkerScript : public QQmlDataTest
 {
     Q_OBJECT
 public:
-    tst_QQuickWorkerScript() {}
+    tst_QQuickWorkerScript()
+    {
+        // Stealing messages needs more than one thread, whatever the number of cores
+        qputenv("QML_WORKER_SCRIPT_THREADS", "4");
+    }
 private slots:
     void source();
     void messaging();
@@ -69,6 +108,8 @@ private slots:
     void scriptError_onLoad();
     void scriptError_onCall();
     void stressDispose();
+    void stateless();
+    void threadPool();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -141,6 +182,17 @@ void tst_QQuickWorkerScript::messaging_data()
     // Qt Script's QScriptValue -> QRegExp uses RegExp2 pattern syntax
     QTest::newRow("regexp") << qVariantFromValue(QRegExp("^\\d\\d?$", Qt::CaseInsensitive, QRegExp::RegExp2));
 #endif
+
+    // Arrays of numbers are sent as packed doubles
+    QVariantList numbers;
+    for (int ii = 0; ii < 1000; ++ii)
+        numbers << qVariantFromValue(ii * 0.5 - 100.25);
+    QTest::newRow("number list") << qVariantFromValue(numbers);
+
+    // ... unless an element turns out not to be a number
+    QVariantList mixed = numbers;
+    mixed << qVariantFromValue(QString("not a number"));
+    QTest::newRow("mixed list") << qVariantFromValue(mixed);
 }
 
 void tst_QQuickWorkerScript::messaging_sendQObjectList()
@@ -295,6 +347,80 @@ void tst_QQuickWorkerScript::stressDispose()
     }
 }
 
+void tst_QQuickWorkerScript::stateless()
+{
+    QQmlEngine engine;
+
+    // An idle worker takes the pool's first thread, so the stateless worker
+    // gets the second one
+    QQmlComponent idleComponent(&engine, testFileUrl("worker.qml"));
+    QObject *idle = idleComponent.create();
+    QVERIFY(idle);
+
+    QQmlComponent component(&engine, testFileUrl("statelessWorker.qml"));
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+    QVERIFY(worker->stateless());
+
+    QQuickWorkerScriptEngine *pool = QQmlEnginePrivate::get(&engine)->getWorkerScriptEngine();
+    QCOMPARE(pool->threadCount(), 2);
+
+    {
+        // While the worker's own thread is blocked, the idle thread takes every
+        // message but the last, which is left for the owner
+        ThreadBlocker blocker(pool->threadAt(1));
+        QVERIFY(QMetaObject::invokeMethod(worker, "testSend", Q_ARG(QVariant, 20)));
+        QTRY_COMPARE(worker->property("responses").toInt(), 19);
+        QCOMPARE(worker->statistics().stolen, 19);
+        QCOMPARE(worker->statistics().queueDepth, 1);
+    }
+    waitForEchoMessage(worker);
+
+    QCOMPARE(worker->property("responses").toInt(), 20);
+    QCOMPARE(worker->property("total").toInt(), 190);
+
+    QQuickWorkerScriptEngine::Statistics stats = worker->statistics();
+    QCOMPARE(stats.processed, 20);
+    QCOMPARE(stats.stolen, 19);
+    QCOMPARE(stats.queueDepth, 0);
+    QVERIFY(stats.maximumQueueDepth > 1);
+    QVERIFY(stats.maximumLatency >= 0);
+
+    qApp->processEvents();
+    delete worker;
+    delete idle;
+}
+
+void tst_QQuickWorkerScript::threadPool()
+{
+    QQmlEngine engine;
+    QList<QObject *> workers;
+    for (int ii = 0; ii < 8; ++ii) {
+        QQmlComponent component(&engine, testFileUrl("worker.qml"));
+        QObject *o = component.create();
+        QVERIFY(o);
+        workers.append(o);
+    }
+
+    QQuickWorkerScriptEngine *pool = QQmlEnginePrivate::get(&engine)->getWorkerScriptEngine();
+    QCOMPARE(QQuickWorkerScriptEngine::maximumThreadCount(), 4);
+    QCOMPARE(pool->threadCount(), 4);
+
+    // Every worker still gets its own answers, whichever thread it runs on
+    for (int ii = 0; ii < workers.count(); ++ii) {
+        QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(workers.at(ii));
+        QVERIFY(worker);
+        QVERIFY(QMetaObject::invokeMethod(worker, "testSend", Q_ARG(QVariant, ii)));
+        waitForEchoMessage(worker);
+        QCOMPARE(worker->property("response").value<QVariant>(), QVariant(ii));
+        QCOMPARE(worker->statistics().processed, 1);
+        QCOMPARE(worker->statistics().stolen, 0);
+    }
+
+    qApp->processEvents();
+    qDeleteAll(workers);
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
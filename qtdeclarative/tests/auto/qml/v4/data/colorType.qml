@@ -14,5 +14,9 @@ QtObject {
     property bool test5: myColor != "red"
     property bool test6: myColor == "#ff0000"
     property bool test7: myColor != "#00ff00"
+
+    property int level: 2
+    property color test8: level == 1 ? "red" : (level == 2 ? "#0000ff" : "green")
+    property color test9: useMyColor ? "#80ff0000" : myOtherColor
 }
 
@@ -0,0 +1,14 @@
+import QtQuick 2.0
+
+QtObject {
+    property url base: "http://example.org/images/"
+    property url other: "http://example.org/images/"
+    property string name: "icon.png"
+
+    property string test1: base + name
+    property url test2: base + name
+    property string test3: "prefix:" + base
+
+    property bool test4: base == other
+    property bool test5: base != "http://example.org/"
+}
@@ -78,6 +78,7 @@ private slots:
     void unaryMinus();
     void unaryPlus();
     void colorType();
+    void urlType();
     void mathAbs();
     void mathCeil();
     void mathFloor();
@@ -149,6 +150,8 @@ void tst_v4::qtscript_data()
     QTest::newRow("varHandling") << "varHandling.qml";
     QTest::newRow("jsvalueHandling") << "jsvalueHandling.qml";
     QTest::newRow("integerOperations") << "integerOperations.qml";
+    QTest::newRow("colorType") << "colorType.qml";
+    QTest::newRow("urlType") << "urlType.qml";
 }
 
 void tst_v4::unnecessaryReeval()
@@ -512,6 +515,22 @@ void tst_v4::colorType()
     QCOMPARE(o->property("test5").toBool(), true);
     QCOMPARE(o->property("test6").toBool(), true);
     QCOMPARE(o->property("test7").toBool(), true);
+    QCOMPARE(o->property("test8").value<QColor>(), QColor("#0000ff"));
+    QCOMPARE(o->property("test9").value<QColor>(), QColor("#80ff0000"));
+    delete o;
+}
+
+void tst_v4::urlType()
+{
+    QQmlComponent component(&engine, testFileUrl("urlType.qml"));
+
+    QObject *o = component.create();
+    QVERIFY(o != 0);
+    QCOMPARE(o->property("test1").toString(), QString("http://example.org/images/icon.png"));
+    QCOMPARE(o->property("test2").toUrl(), QUrl("http://example.org/images/icon.png"));
+    QCOMPARE(o->property("test3").toString(), QString("prefix:http://example.org/images/"));
+    QCOMPARE(o->property("test4").toBool(), true);
+    QCOMPARE(o->property("test5").toBool(), true);
     delete o;
 }
 
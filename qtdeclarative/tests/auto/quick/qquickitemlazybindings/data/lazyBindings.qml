@@ -0,0 +1,29 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+
+    property int source: 0
+
+    signal evaluated
+
+    function track(value) {
+        evaluated();
+        return value;
+    }
+
+    Item {
+        id: page
+        objectName: "page"
+
+        Item {
+            id: content
+            objectName: "content"
+            property int mirror: root.track(root.source)
+        }
+    }
+
+    function readMirror() {
+        return content.mirror;
+    }
+}
@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtTest/QSignalSpy>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtQuick/qquickitem.h>
+#include <private/qqmldata_p.h>
+#include "../../shared/util.h"
+
+class tst_qquickitemlazybindings : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_qquickitemlazybindings() {}
+
+private slots:
+    void initTestCase();
+
+    void invisible();
+    void zeroOpacity();
+    void flushOnRead();
+    void declarativeDataCreatedLater();
+};
+
+void tst_qquickitemlazybindings::initTestCase()
+{
+    // Read once, on first use
+    qputenv("QML_LAZY_BINDINGS", "1");
+    QQmlDataTest::initTestCase();
+}
+
+void tst_qquickitemlazybindings::invisible()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("lazyBindings.qml"));
+    QObject *root = component.create();
+    QVERIFY(root != 0);
+    QSignalSpy spy(root, SIGNAL(evaluated()));
+
+    QQuickItem *page = root->findChild<QQuickItem *>("page");
+    QObject *content = root->findChild<QObject *>("content");
+    QVERIFY(page && content);
+
+    root->setProperty("source", 1);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(content->property("mirror").toInt(), 1);
+
+    page->setVisible(false);
+    root->setProperty("source", 2);
+    root->setProperty("source", 3);
+    root->setProperty("source", 4);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(content->property("mirror").toInt(), 1);
+
+    // The dirty binding is evaluated once on show
+    page->setVisible(true);
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(content->property("mirror").toInt(), 4);
+
+    root->setProperty("source", 5);
+    QCOMPARE(spy.count(), 3);
+
+    delete root;
+}
+
+void tst_qquickitemlazybindings::zeroOpacity()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("lazyBindings.qml"));
+    QObject *root = component.create();
+    QVERIFY(root != 0);
+    QSignalSpy spy(root, SIGNAL(evaluated()));
+
+    QQuickItem *page = root->findChild<QQuickItem *>("page");
+    QObject *content = root->findChild<QObject *>("content");
+    QVERIFY(page && content);
+
+    page->setOpacity(0);
+    root->setProperty("source", 7);
+    QCOMPARE(spy.count(), 0);
+
+    page->setOpacity(0.5);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(content->property("mirror").toInt(), 7);
+
+    delete root;
+}
+
+void tst_qquickitemlazybindings::flushOnRead()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("lazyBindings.qml"));
+    QObject *root = component.create();
+    QVERIFY(root != 0);
+    QSignalSpy spy(root, SIGNAL(evaluated()));
+
+    QQuickItem *page = root->findChild<QQuickItem *>("page");
+    QVERIFY(page != 0);
+
+    page->setVisible(false);
+    root->setProperty("source", 9);
+    QCOMPARE(spy.count(), 0);
+
+    // Reading the property from QML evaluates the binding
+    QVariant mirror;
+    QMetaObject::invokeMethod(root, "readMirror", Q_RETURN_ARG(QVariant, mirror));
+    QCOMPARE(mirror.toInt(), 9);
+    QCOMPARE(spy.count(), 1);
+
+    // Nothing left to do on show
+    page->setVisible(true);
+    QCOMPARE(spy.count(), 1);
+
+    delete root;
+}
+
+void tst_qquickitemlazybindings::declarativeDataCreatedLater()
+{
+    QQuickItem parent;
+    QQuickItem item(&parent);
+    QVERIFY(!QQmlData::get(&item));
+
+    // Hiding an item that has no declarative data yet must still suspend it
+    parent.setVisible(false);
+    QQmlData *ddata = QQmlData::get(&item);
+    QVERIFY(ddata != 0);
+    QVERIFY(ddata->bindingsSuspended);
+
+    parent.setVisible(true);
+    QVERIFY(!ddata->bindingsSuspended);
+}
+
+QTEST_MAIN(tst_qquickitemlazybindings)
+
+#include "tst_qquickitemlazybindings.moc"
@@ -0,0 +1,16 @@
+import QtQuick 2.0
+
+VisualDataModel {
+    reuseItems: true
+    model: myModel
+    delegate: Item {
+        property string name: model.name
+        property int modelIndex: index
+        property int itemsIndex: VisualDataModel.itemsIndex
+        property int pooledCount: 0
+        property int reusedCount: 0
+
+        VisualDataModel.onPooled: ++pooledCount
+        VisualDataModel.onReused: ++reusedCount
+    }
+}
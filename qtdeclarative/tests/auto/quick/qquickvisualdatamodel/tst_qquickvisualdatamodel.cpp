@@ -438,6 +438,7 @@ private slots:
     void asynchronousMove_data();
     void asynchronousCancel();
     void invalidContext();
+    void reuseItems();
 
 private:
     template <int N> void groups_verify(
@@ -4243,6 +4244,59 @@ void tst_qquickvisualdatamodel::invalidContext()
     QVERIFY(!item);
 }
 
+void tst_qquickvisualdatamodel::reuseItems()
+{
+    QQmlEngine engine;
+    QaimModel model;
+    for (int i = 0; i < 8; i++)
+        model.addItem("Item" + QString::number(i), QString::number(i));
+
+    engine.rootContext()->setContextProperty("myModel", &model);
+
+    QQmlComponent c(&engine, testFileUrl("reuseItems.qml"));
+
+    QScopedPointer<QQmlDelegateModel> visualModel(qobject_cast<QQmlDelegateModel *>(c.create()));
+    QVERIFY(visualModel);
+    QCOMPARE(visualModel->reuseItems(), true);
+
+    QQmlGuard<QQuickItem> item = qobject_cast<QQuickItem *>(visualModel->object(2, false));
+    QVERIFY(item);
+    QCOMPARE(item->property("name").toString(), QString("Item2"));
+    QCOMPARE(item->property("modelIndex").toInt(), 2);
+    QCOMPARE(item->property("itemsIndex").toInt(), 2);
+
+    QVERIFY(visualModel->release(item) & QQmlInstanceModel::Destroyed);
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+    QVERIFY(item);
+    QCOMPARE(item->property("pooledCount").toInt(), 1);
+    QCOMPARE(item->property("reusedCount").toInt(), 0);
+
+    QQuickItem *reused = qobject_cast<QQuickItem *>(visualModel->object(5, false));
+    QCOMPARE(reused, item.data());
+    QCOMPARE(item->property("name").toString(), QString("Item5"));
+    QCOMPARE(item->property("modelIndex").toInt(), 5);
+    QCOMPARE(item->property("itemsIndex").toInt(), 5);
+    QCOMPARE(item->property("reusedCount").toInt(), 1);
+
+    // A reused delegate keeps tracking changes to its new model index.
+    model.modifyItem(5, "Modified", "5");
+    QCOMPARE(item->property("name").toString(), QString("Modified"));
+
+    // Other indexes get a new delegate while the pool is empty.
+    QQuickItem *other = qobject_cast<QQuickItem *>(visualModel->object(3, false));
+    QVERIFY(other);
+    QVERIFY(other != item.data());
+    QCOMPARE(other->property("name").toString(), QString("Item3"));
+    visualModel->release(other);
+
+    // Disabling reuse destroys the pooled delegates.
+    visualModel->release(item);
+    QCOMPARE(item->property("pooledCount").toInt(), 2);
+    visualModel->setReuseItems(false);
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+    QVERIFY(!item);
+}
+
 QTEST_MAIN(tst_qquickvisualdatamodel)
 
 #include "tst_qquickvisualdatamodel.moc"
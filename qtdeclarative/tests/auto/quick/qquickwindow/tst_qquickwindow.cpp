@@ -46,14 +46,35 @@
 #include <QtQuick/QQuickWindow>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlComponent>
+#include <QtQml/QQmlIncubator>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 #include "../shared/visualtestutil.h"
 #include <QSignalSpy>
 #include <qpa/qwindowsysteminterface.h>
 #include <private/qquickwindow_p.h>
+#include <private/qsgrenderloop_p.h>
 #include <private/qguiapplication_p.h>
 
+// A render loop that renders nothing, with a frame interval set by the test
+class FrameBudgetRenderLoop : public QSGRenderLoop
+{
+public:
+    void show(QQuickWindow *) {}
+    void hide(QQuickWindow *) {}
+    void windowDestroyed(QQuickWindow *) {}
+    void exposureChanged(QQuickWindow *) {}
+    QImage grab(QQuickWindow *) { return QImage(); }
+    void update(QQuickWindow *) {}
+    void maybeUpdate(QQuickWindow *) {}
+    QAnimationDriver *animationDriver() const { return 0; }
+    QSGContext *sceneGraphContext() const { return 0; }
+    void releaseResources(QQuickWindow *) {}
+
+    using QSGRenderLoop::markFrameSwapped;
+    using QSGRenderLoop::setFrameInterval;
+};
+
 struct TouchEventData {
     QEvent::Type type;
     QWidget *widget;
@@ -328,6 +349,9 @@ private slots:
 
     void blockClosing();
 
+    void incubationStatistics();
+    void incubationFrameBudget();
+
 #ifndef QT_NO_CURSOR
     void cursor();
 #endif
@@ -1487,6 +1511,90 @@ void tst_qquickwindow::blockClosing()
     QTRY_VERIFY(!window->isVisible());
 }
 
+void tst_qquickwindow::incubationStatistics()
+{
+    QQuickWindow window;
+    window.resize(100, 100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQmlEngine engine;
+    engine.setIncubationController(window.incubationController());
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\nItem { Repeater { model: 20; Rectangle {} } }", QUrl());
+    QVERIFY(component.isReady());
+
+    QQmlIncubator incubator(QQmlIncubator::Asynchronous);
+    component.create(incubator);
+    QTRY_VERIFY(incubator.isReady());
+    QScopedPointer<QObject> object(incubator.object());
+
+    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(&window);
+    QQuickWindowIncubationStatistics statistics = wd->incubationStatistics();
+    QVERIFY(statistics.frames > 0);
+    QVERIFY(statistics.objectsIncubated >= 1);
+    QVERIFY(statistics.maximumObjectsPerFrame >= 1);
+    QVERIFY(statistics.framesMissed <= statistics.frames);
+    QVERIFY(statistics.objectsPerFrame() > 0);
+
+    wd->resetIncubationStatistics();
+    QCOMPARE(wd->incubationStatistics().frames, 0);
+    QCOMPARE(wd->incubationStatistics().objectsIncubated, 0);
+}
+
+void tst_qquickwindow::incubationFrameBudget()
+{
+    FrameBudgetRenderLoop loop;
+
+    // Without a frame being rendered, a full interval is available
+    QVERIFY(loop.frameInterval() > 0);
+    QCOMPARE(loop.remainingFrameTime(), loop.frameInterval());
+
+    // The time left shrinks as the next frame approaches
+    loop.setFrameInterval(1000);
+    loop.markFrameSwapped();
+    QTest::qSleep(50);
+    const int remaining = loop.remainingFrameTime();
+    QVERIFY(remaining > 0);
+    QVERIFY(remaining <= 1000 - 50);
+
+    // ...and is capped by the frame interval once the frame is due
+    loop.setFrameInterval(20);
+    loop.markFrameSwapped();
+    QTest::qSleep(30);
+    QCOMPARE(loop.remainingFrameTime(), 20);
+
+    // A slice that cannot be interrupted before the next frame is due is counted as missed
+    loop.setFrameInterval(8);
+    QQuickWindow window;
+    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(&window);
+    QSGRenderLoop *windowManager = wd->windowManager;
+    wd->windowManager = &loop;
+    QQmlIncubationController *controller = window.incubationController();
+    wd->windowManager = windowManager;
+
+    QQmlEngine engine;
+    engine.setIncubationController(controller);
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Item { property int slow: { var t = new Date().getTime(); while (new Date().getTime() - t < 50) {} return 1 } }",
+                      QUrl());
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+    QQmlIncubator incubator(QQmlIncubator::Asynchronous);
+    component.create(incubator);
+    QTRY_VERIFY(incubator.isReady());
+    QScopedPointer<QObject> object(incubator.object());
+    QCOMPARE(object->property("slow").toInt(), 1);
+
+    QQuickWindowIncubationStatistics statistics = wd->incubationStatistics();
+    QVERIFY(statistics.frames >= 1);
+    QVERIFY(statistics.framesMissed >= 1);
+    QVERIFY(statistics.incubationTime >= 50);
+}
+
 QTEST_MAIN(tst_qquickwindow)
 
 #include "tst_qquickwindow.moc"
@@ -47,6 +47,7 @@ QUICKTESTS =  \
     qquickimage \
     qquickitem \
     qquickitem2 \
+    qquickitemlazybindings \
     qquickitemlayer \
     qquicklistview \
     qquickloader \
@@ -142,6 +142,11 @@ void tst_binding::basicproperty_data()
     QTest::newRow("myObject.value") << SRCDIR "/data/idproperty.txt" << "myObject.value";
     QTest::newRow("myObject.value + 10") << SRCDIR "/data/idproperty.txt" << "myObject.value + 10";
     QTest::newRow("myObject.value + myObject.value + 10") << SRCDIR "/data/idproperty.txt" << "myObject.value + myObject.value + 10";
+
+    // Not optimized by v4, so these run as V8 bindings with static dependencies
+    QTest::newRow("Math.pow(value, 2)") << SRCDIR "/data/localproperty.txt" << "Math.pow(value, 2)";
+    QTest::newRow("Math.pow(myObject.value, 2)") << SRCDIR "/data/idproperty.txt" << "Math.pow(myObject.value, 2)";
+    QTest::newRow("Math.pow(myObject.value, 2) + value") << SRCDIR "/data/idproperty.txt" << "Math.pow(myObject.value, 2) + value";
 }
 
 void tst_binding::basicproperty()
@@ -48,8 +48,11 @@
 #include <QtQml/private/qqmljsparser_p.h>
 #include <QtQml/private/qqmljslexer_p.h>
 #include <QtQml/private/qqmlscript_p.h>
+#include <QtQml/private/qqmldiskcache_p.h>
+#include <QtQml/private/qqmlpool_p.h>
 
 #include <QFile>
+#include <QTemporaryDir>
 #include <QDebug>
 #include <QTextStream>
 
@@ -62,6 +65,12 @@ public:
 private slots:
     void boomblock();
 
+    void allocations_data();
+    void allocations();
+
+    void diskcache_data();
+    void diskcache();
+
     void jsparser_data();
     void jsparser();
 
@@ -100,6 +109,78 @@ void tst_compilation::boomblock()
     }
 }
 
+void tst_compilation::allocations_data()
+{
+    QTest::addColumn<bool>("warm");
+
+    QTest::newRow("cold") << false;
+    QTest::newRow("warm") << true;
+}
+
+// Reports the number of pool pages obtained from the system allocator while
+// parsing and compiling one file.  Once a file has been compiled, the pages
+// released by its pools are recycled and subsequent compiles should not
+// need to allocate any.
+void tst_compilation::allocations()
+{
+    QFETCH(bool, warm);
+
+    QFile f(SRCDIR + QLatin1String("/data/BoomBlock.qml"));
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QByteArray data = f.readAll();
+
+    QQmlEngine engine;
+    if (warm) {
+        QQmlComponent c(&engine);
+        c.setData(data, QUrl());
+    }
+
+    QQmlPool::resetStatistics();
+    {
+        QQmlComponent c(&engine);
+        c.setData(data, QUrl());
+    }
+    QQmlPool::Statistics stats = QQmlPool::statistics();
+
+    QTest::setBenchmarkResult(stats.pageAllocations, QTest::Events);
+}
+
+void tst_compilation::diskcache_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("compiled") << false;
+    QTest::newRow("cached") << true;
+}
+
+void tst_compilation::diskcache()
+{
+    QFETCH(bool, cached);
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    QQmlDiskCache::setCacheDirectory(cacheDir.path());
+    QQmlDiskCache::setEnabled(cached);
+
+    QUrl url = TEST_FILE("BoomBlock.qml");
+
+    //populate the cache
+    {
+        QQmlEngine engine;
+        QQmlComponent c(&engine, url);
+        QVERIFY(c.isReady());
+    }
+
+    QBENCHMARK {
+        QQmlEngine engine;
+        QQmlComponent c(&engine, url);
+//        QVERIFY(c.isReady());
+    }
+
+    QQmlDiskCache::setEnabled(false);
+    QQmlDiskCache::setCacheDirectory(QString());
+}
+
 void tst_compilation::jsparser_data()
 {
     QTest::addColumn<QString>("file");
@@ -78,7 +78,7 @@ static void showHelp()
               << "  update     Add files to the bundle or update them if they are already added" << std::endl
               << "  ls         List the files in the bundle" << std::endl
               << "  cat        Concatenates files and print on the standard output" << std::endl
-              << "  optimize   Insert optimization data for all recognised content" << std::endl
+              << "  optimize   Insert optimization data for all recognised content, and an index" << std::endl
               << std::endl
               << "See 'qmlbundle help <command>' for more information on a specific command." << std::endl;
 }
@@ -211,6 +211,8 @@ int main(int argc, char *argv[])
                 if (!preparse.isEmpty())
                     bundle.addMetaLink(file->fileName(), QLatin1String("qml:preparse"), preparse);
             }
+
+            bundle.writeIndex();
         }
     } else {
         showHelp();
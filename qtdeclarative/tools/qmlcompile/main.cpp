@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qqmlbundle_p.h>
+#include <private/qqmldiskcache_p.h>
+#include <QtQml/qqmlengine.h>
+#include <QtCore/QtCore>
+#include <iostream>
+
+static void showHelp()
+{
+    std::cerr << "Usage: qmlcompile [options] <bundle>" << std::endl
+              << std::endl
+              << "Compiles the QML documents in <bundle> and adds the compiled data to it, so" << std::endl
+              << "that they can be loaded without parsing or compiling them at runtime." << std::endl
+              << std::endl
+              << "The compiled data is only used if the bundle is loaded with the same name" << std::endl
+              << "and the same imports, and by a QtQml library with the same configuration." << std::endl
+              << std::endl
+              << "Options:" << std::endl
+              << "  -name <name>      Name the bundle is added with by QQmlEngine::addNamedBundle()." << std::endl
+              << "                    Defaults to the base name of the bundle file." << std::endl
+              << "  -import <path>    Add <path> to the import paths." << std::endl
+              << "  -plugin <path>    Add <path> to the plugin paths." << std::endl
+              << "  -verbose          Print the documents that are compiled." << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    /*const QString exeName =*/ args.takeFirst();
+
+    QString bundleName;
+    QStringList importPaths;
+    QStringList pluginPaths;
+    bool verbose = false;
+
+    while (!args.isEmpty() && args.first().startsWith(QLatin1Char('-'))) {
+        const QString option = args.takeFirst();
+        if (option == QLatin1String("-verbose")) {
+            verbose = true;
+        } else if (args.isEmpty()) {
+            showHelp();
+            return EXIT_FAILURE;
+        } else if (option == QLatin1String("-name")) {
+            bundleName = args.takeFirst();
+        } else if (option == QLatin1String("-import")) {
+            importPaths.append(args.takeFirst());
+        } else if (option == QLatin1String("-plugin")) {
+            pluginPaths.append(args.takeFirst());
+        } else {
+            showHelp();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (args.count() != 1) {
+        showHelp();
+        return EXIT_FAILURE;
+    }
+
+    const QString bundleFileName = args.takeFirst();
+    if (bundleName.isEmpty())
+        bundleName = QFileInfo(bundleFileName).baseName();
+
+    // Compile all documents before the bundle is modified, as the engine maps it
+    QList<QPair<QString, QByteArray> > compiledFiles;
+    int errors = 0;
+
+    {
+        QQmlEngine engine;
+        foreach (const QString &path, importPaths)
+            engine.addImportPath(path);
+        foreach (const QString &path, pluginPaths)
+            engine.addPluginPath(path);
+
+        if (!engine.addNamedBundle(bundleName, bundleFileName)) {
+            std::cerr << "invalid bundle name " << qPrintable(bundleName) << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        QQmlBundle bundle(bundleFileName);
+        if (!bundle.open(QFile::ReadOnly)) {
+            std::cerr << "cannot open " << qPrintable(bundleFileName) << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        foreach (const QQmlBundle::FileEntry *file, bundle.files()) {
+            if (!file->fileName().endsWith(QLatin1String(".qml")))
+                continue;
+
+            QUrl url;
+            url.setScheme(QLatin1String("bundle"));
+            url.setHost(bundleName);
+            url.setPath(QLatin1Char('/') + file->fileName());
+
+            QList<QQmlError> compileErrors;
+            QByteArray contents(file->contents(), file->fileSize());
+            QByteArray compiled = QQmlDiskCache::precompile(&engine, url, contents, &compileErrors);
+            foreach (const QQmlError &error, compileErrors)
+                std::cerr << qPrintable(error.toString()) << std::endl;
+
+            if (compiled.isEmpty()) {
+                std::cerr << "cannot compile " << qPrintable(file->fileName()) << std::endl;
+                ++errors;
+                continue;
+            }
+
+            if (verbose)
+                std::cout << qPrintable(file->fileName()) << std::endl;
+
+            compiledFiles.append(qMakePair(file->fileName(), compiled));
+        }
+    }
+
+    QQmlBundle bundle(bundleFileName);
+    if (!bundle.open(QFile::ReadWrite)) {
+        std::cerr << "cannot open " << qPrintable(bundleFileName) << " for writing" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    for (int ii = 0; ii < compiledFiles.count(); ++ii) {
+        const QPair<QString, QByteArray> &compiled = compiledFiles.at(ii);
+        if (!bundle.addMetaLink(compiled.first, QLatin1String("qml:compiled"), compiled.second)) {
+            std::cerr << "cannot add compiled data for " << qPrintable(compiled.first) << std::endl;
+            ++errors;
+        }
+    }
+
+    // The meta links are appended after any existing index
+    bundle.writeIndex();
+
+    return errors ? EXIT_FAILURE : 0;
+}
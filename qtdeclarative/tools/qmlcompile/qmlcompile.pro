@@ -0,0 +1,5 @@
+QT       = core qml-private v8-private core-private
+
+SOURCES += main.cpp
+
+load(qt_tool)
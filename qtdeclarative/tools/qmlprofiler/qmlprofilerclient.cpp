@@ -177,6 +177,16 @@ void QmlProfilerClient::messageReceived(const QByteArray &data)
             stream >> frameRate >> animationCount;
             emit this->frame(time, frameRate, animationCount);
             d->maximumTime = qMax(time, d->maximumTime);
+        } else if (event == QQmlProfilerService::BindingsCoalesced) {
+            int evaluated, saved;
+            stream >> evaluated >> saved;
+            emit this->bindingsCoalesced(time, evaluated, saved);
+            d->maximumTime = qMax(time, d->maximumTime);
+        } else if (event == QQmlProfilerService::PropertyLookups) {
+            int hits, misses;
+            stream >> hits >> misses;
+            emit this->propertyLookups(time, hits, misses);
+            d->maximumTime = qMax(time, d->maximumTime);
         } else if (event == QQmlProfilerService::StartTrace) {
             emit this->traceStarted(time);
             d->maximumTime = time;
@@ -103,6 +103,8 @@ signals:
                const QStringList &data,
                const QmlEventLocation &location);
     void frame(qint64 time, int frameRate, int animationCount);
+    void bindingsCoalesced(qint64 time, int evaluated, int saved);
+    void propertyLookups(qint64 time, int hits, int misses);
 
 protected:
     virtual void messageReceived(const QByteArray &);
@@ -88,9 +88,31 @@ struct QmlRangeEventStartInstance {
     QmlRangeEventData *data;
 };
 
+// A flush of the bindings queued while QML_COALESCE_BINDINGS is set
+struct QmlBindingsCoalescedEvent {
+    QmlBindingsCoalescedEvent() {} // never called
+    QmlBindingsCoalescedEvent(qint64 _time, int _evaluated, int _saved)
+        : time(_time), evaluated(_evaluated), saved(_saved) {}
+    qint64 time;
+    int evaluated;
+    int saved;
+};
+
+// QObject property lookup cache statistics
+struct QmlPropertyLookupsEvent {
+    QmlPropertyLookupsEvent() {} // never called
+    QmlPropertyLookupsEvent(qint64 _time, int _hits, int _misses)
+        : time(_time), hits(_hits), misses(_misses) {}
+    qint64 time;
+    int hits;
+    int misses;
+};
+
 QT_BEGIN_NAMESPACE
 Q_DECLARE_TYPEINFO(QmlRangeEventData, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QmlRangeEventStartInstance, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(QmlBindingsCoalescedEvent, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(QmlPropertyLookupsEvent, Q_PRIMITIVE_TYPE);
 QT_END_NAMESPACE
 
 struct QV8EventInfo {
@@ -115,6 +137,8 @@ public:
     QHash<QString, QmlRangeEventData *> eventDescriptions;
     QVector<QmlRangeEventStartInstance> startInstanceList;
     QHash<QString, QV8EventInfo *> v8EventHash;
+    QVector<QmlBindingsCoalescedEvent> bindingsCoalescedList;
+    QVector<QmlPropertyLookupsEvent> propertyLookupsList;
 
     qint64 traceStartTime;
     qint64 traceEndTime;
@@ -149,6 +173,8 @@ void QmlProfilerData::clear()
     qDeleteAll(d->eventDescriptions.values());
     d->eventDescriptions.clear();
     d->startInstanceList.clear();
+    d->bindingsCoalescedList.clear();
+    d->propertyLookupsList.clear();
 
     qDeleteAll(d->v8EventHash.values());
     d->v8EventHash.clear();
@@ -304,6 +330,20 @@ void QmlProfilerData::addFrameEvent(qint64 time, int framerate, int animationcou
     d->lastFrameEvent = &d->startInstanceList.last();
 }
 
+void QmlProfilerData::addBindingsCoalescedEvent(qint64 time, int evaluated, int saved)
+{
+    setState(AcquiringData);
+
+    d->bindingsCoalescedList.append(QmlBindingsCoalescedEvent(time, evaluated, saved));
+}
+
+void QmlProfilerData::addPropertyLookupsEvent(qint64 time, int hits, int misses)
+{
+    setState(AcquiringData);
+
+    d->propertyLookupsList.append(QmlPropertyLookupsEvent(time, hits, misses));
+}
+
 QString QmlProfilerData::rootEventName()
 {
     return tr("<program>");
@@ -458,7 +498,8 @@ void QmlProfilerData::complete()
 
 bool QmlProfilerData::isEmpty() const
 {
-    return d->startInstanceList.isEmpty() && d->v8EventHash.isEmpty();
+    return d->startInstanceList.isEmpty() && d->v8EventHash.isEmpty()
+            && d->bindingsCoalescedList.isEmpty() && d->propertyLookupsList.isEmpty();
 }
 
 bool QmlProfilerData::save(const QString &filename)
@@ -519,6 +560,30 @@ bool QmlProfilerData::save(const QString &filename)
     }
     stream.writeEndElement(); // profilerDataModel
 
+    if (!d->bindingsCoalescedList.isEmpty()) {
+        stream.writeStartElement(QStringLiteral("bindingsCoalesced"));
+        foreach (const QmlBindingsCoalescedEvent &event, d->bindingsCoalescedList) {
+            stream.writeStartElement(QStringLiteral("flush"));
+            stream.writeAttribute(QStringLiteral("time"), QString::number(event.time));
+            stream.writeAttribute(QStringLiteral("evaluated"), QString::number(event.evaluated));
+            stream.writeAttribute(QStringLiteral("saved"), QString::number(event.saved));
+            stream.writeEndElement();
+        }
+        stream.writeEndElement(); // bindingsCoalesced
+    }
+
+    if (!d->propertyLookupsList.isEmpty()) {
+        stream.writeStartElement(QStringLiteral("propertyLookups"));
+        foreach (const QmlPropertyLookupsEvent &event, d->propertyLookupsList) {
+            stream.writeStartElement(QStringLiteral("lookups"));
+            stream.writeAttribute(QStringLiteral("time"), QString::number(event.time));
+            stream.writeAttribute(QStringLiteral("hits"), QString::number(event.hits));
+            stream.writeAttribute(QStringLiteral("misses"), QString::number(event.misses));
+            stream.writeEndElement();
+        }
+        stream.writeEndElement(); // propertyLookups
+    }
+
     stream.writeStartElement(QStringLiteral("v8profile")); // v8 profiler output
     stream.writeAttribute(QStringLiteral("totalTime"), QString::number(d->v8MeasuredTime));
     foreach (QV8EventInfo *v8event, d->v8EventHash.values()) {
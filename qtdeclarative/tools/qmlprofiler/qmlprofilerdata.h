@@ -89,6 +89,8 @@ public slots:
     void addV8Event(int depth, const QString &function, const QString &filename,
                     int lineNumber, double totalTime, double selfTime);
     void addFrameEvent(qint64 time, int framerate, int animationcount);
+    void addBindingsCoalescedEvent(qint64 time, int evaluated, int saved);
+    void addPropertyLookupsEvent(qint64 time, int hits, int misses);
 
     void complete();
     bool save(const QString &filename);
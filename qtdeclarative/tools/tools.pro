@@ -4,10 +4,11 @@ qtHaveModule(qmltest): SUBDIRS += qmltestrunner
 SUBDIRS += \
     qmlmin \
     qmlprofiler \
-    qmlbundle
+    qmlbundle \
+    qmlcompile
 qtHaveModule(quick):qtHaveModule(widgets): SUBDIRS += qmleasing
 
-# qmlmin & qmlbundle are build tools.
+# qmlmin, qmlbundle & qmlcompile are build tools.
 # qmlscene is needed by the autotests.
 # qmltestrunner may be useful for manual testing.
 # qmlplugindump cannot be a build tool, because it loads target plugins.